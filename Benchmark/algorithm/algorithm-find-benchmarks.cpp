@@ -0,0 +1,546 @@
+/********************************************************************
+* Find algorithm benchmarks: FindBrute vs std::find, FindLowerBound strategies, galloping, FindLowerBoundBatch, StaticBTree,
+* interpolation, LearnedIndex and FindLowerBoundRandom, FlatKeyOrderMap against FlatKeyOrderMapSoA lookups,
+* FlatKeyOrderMap against FrozenHashMap lookups and FrozenHashMap's build, 64 entry config tables built at startup
+* against ConstexprKeyOrderMap
+********************************************************************/
+
+
+#include "pch.h"
+
+#include "aol/algorithms.h"
+#include "aol/array.h"
+#include "aol/hash_map.h"
+#include "aol/key_ordered_map.h"
+#include "aol/randoms.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+
+#include <algorithm>
+#include <random>
+
+
+namespace
+{
+
+constexpr AoL::SizeT QueryCount = 4096;
+
+struct SortedData
+{
+    AoL::Vector<AoL::U32> values;
+    AoL::Vector<AoL::U32> queries;
+
+    explicit SortedData(AoL::SizeT size)
+    {
+        std::mt19937_64 rng{ 42 };
+
+        values.resize(size);
+        for (AoL::SizeT i = 0; i < size; ++i)
+        {
+            values[i] = static_cast<AoL::U32>(i * 3);
+        }
+
+        std::uniform_int_distribution<AoL::U32> dist{ 0, static_cast<AoL::U32>(size * 3) };
+        queries.resize(QueryCount);
+        for (auto& query : queries)
+        {
+            query = dist(rng);
+        }
+    }
+};
+
+// Dense 64-bit ids with random gaps, the case interpolation and learned indexes target
+struct SortedIds
+{
+    AoL::Vector<AoL::U64> values;
+    AoL::Vector<AoL::U64> queries;
+
+    explicit SortedIds(AoL::SizeT size)
+    {
+        std::mt19937_64 rng{ 42 };
+        std::uniform_int_distribution<AoL::U64> gap{ 1, 16 };
+
+        values.resize(size);
+        AoL::U64 id = 1ull << 40;
+        for (auto& value : values)
+        {
+            id += gap(rng);
+            value = id;
+        }
+
+        std::uniform_int_distribution<AoL::U64> dist{ values.front(), values.back() };
+        queries.resize(QueryCount);
+        for (auto& query : queries)
+        {
+            query = dist(rng);
+        }
+    }
+};
+
+}
+
+static void BM_FindLowerBoundBranchlessLoop(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBoundBranchless(p_begin, p_end, query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundBranchlessLoop)->RangeMultiplier(2)->Range(4, 256);
+BENCHMARK(BM_FindLowerBoundBranchlessLoop)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundDefaultLoop(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBound(p_begin, p_end, query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundDefaultLoop)->RangeMultiplier(2)->Range(4, 256);
+BENCHMARK(BM_FindLowerBoundDefaultLoop)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundSortedProbes(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    std::sort(data.queries.begin(), data.queries.end());
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBound(p_begin, p_end, query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundSortedProbes)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundGallopingSortedProbes(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    std::sort(data.queries.begin(), data.queries.end());
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+
+    for (auto _ : state)
+    {
+        const AoL::U32* p_hint = p_begin;
+        for (AoL::U32 query : data.queries)
+        {
+            p_hint = AoL::FindLowerBoundGalloping(p_hint, p_end, query);
+            benchmark::DoNotOptimize(p_hint);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundGallopingSortedProbes)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundBatch(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+    AoL::Vector<const AoL::U32*> results(QueryCount);
+
+    for (auto _ : state)
+    {
+        AoL::FindLowerBoundBatch(p_begin, p_end, data.queries.begin(), data.queries.end(), results.begin());
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundBatch)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundStaticBTree(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::StaticBTree<AoL::U32> tree(data.values.begin(), data.values.end());
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : data.queries)
+        {
+            benchmark::DoNotOptimize(tree.lower_bound(query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundStaticBTree)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+template<typename T>
+static void BM_FindBruteSmallSet(benchmark::State& state)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    AoL::Vector<T> values(size);
+    for (AoL::SizeT i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<T>(i * 3);
+    }
+
+    // Every other query misses, so hits land on average halfway through
+    std::mt19937_64 rng{ 42 };
+    std::uniform_int_distribution<AoL::SizeT> dist{ 0, size * 3 };
+    AoL::Vector<T> queries(QueryCount);
+    for (auto& query : queries)
+    {
+        query = static_cast<T>(dist(rng) & ~AoL::SizeT{ 1 });
+    }
+
+    for (auto _ : state)
+    {
+        for (T query : queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindBrute(values.begin(), values.end(), query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindBruteSmallSet<AoL::U32>)->RangeMultiplier(2)->Range(8, 256);
+BENCHMARK(BM_FindBruteSmallSet<AoL::U64>)->RangeMultiplier(2)->Range(8, 256);
+
+static void BM_StdFindSmallSet(benchmark::State& state)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    AoL::Vector<AoL::U32> values(size);
+    for (AoL::SizeT i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<AoL::U32>(i * 3);
+    }
+
+    std::mt19937_64 rng{ 42 };
+    std::uniform_int_distribution<AoL::SizeT> dist{ 0, size * 3 };
+    AoL::Vector<AoL::U32> queries(QueryCount);
+    for (auto& query : queries)
+    {
+        query = static_cast<AoL::U32>(dist(rng) & ~AoL::SizeT{ 1 });
+    }
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : queries)
+        {
+            benchmark::DoNotOptimize(std::find(values.begin(), values.end(), query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_StdFindSmallSet)->RangeMultiplier(2)->Range(8, 256);
+
+static void BM_FindLowerBoundIdsBranchless(benchmark::State& state)
+{
+    SortedIds data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U64* p_begin = data.values.data();
+    const AoL::U64* p_end = p_begin + data.values.size();
+
+    for (auto _ : state)
+    {
+        for (AoL::U64 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBoundBranchless(p_begin, p_end, query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundIdsBranchless)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundIdsInterpolation(benchmark::State& state)
+{
+    SortedIds data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U64* p_begin = data.values.data();
+    const AoL::U64* p_end = p_begin + data.values.size();
+
+    for (auto _ : state)
+    {
+        for (AoL::U64 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBoundInterpolation(p_begin, p_end, query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundIdsInterpolation)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundIdsLearnedIndex(benchmark::State& state)
+{
+    SortedIds data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::LearnedIndex<AoL::U64> index(data.values);
+    const AoL::U64* p_begin = data.values.data();
+
+    for (auto _ : state)
+    {
+        for (AoL::U64 query : data.queries)
+        {
+            benchmark::DoNotOptimize(index.lower_bound(p_begin, query));
+        }
+    }
+
+    state.counters["segments"] = static_cast<double>(index.segment_count());
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundIdsLearnedIndex)->RangeMultiplier(8)->Range(1 << 10, 1 << 24);
+
+static void BM_FindLowerBoundRandomStdRand(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBoundRandom(p_begin, p_end, query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundRandomStdRand)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_FindLowerBoundRandomRng(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+    AoL::Rand::DefaultGen rng(42);
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBoundRandom(p_begin, p_end, query, rng));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundRandomRng)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_FindLowerBoundRandomRngPool(benchmark::State& state)
+{
+    SortedData data{ static_cast<AoL::SizeT>(state.range(0)) };
+    const AoL::U32* p_begin = data.values.data();
+    const AoL::U32* p_end = p_begin + data.values.size();
+    AoL::Rand::DefaultGen rng(42);
+    AoL::Rand::PoolBit64_32 pool;
+
+    for (auto _ : state)
+    {
+        for (AoL::U32 query : data.queries)
+        {
+            benchmark::DoNotOptimize(AoL::FindLowerBoundRandom(p_begin, p_end, query, rng, pool));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindLowerBoundRandomRngPool)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+// 8 byte keys with 200 byte values: FlatKeyOrderMap's searches read whole pairs, FlatKeyOrderMapSoA's only the key array
+struct LargeValue
+{
+    AoL::U8 bytes[200];
+};
+
+template<typename Map>
+static void RunLargeValueMapFind(benchmark::State& state)
+{
+    const SortedIds ids{ static_cast<AoL::SizeT>(state.range(0)) };
+    Map map;
+    map.build_start();
+    for (AoL::U64 id : ids.values)
+    {
+        map.build_add(id, LargeValue{ });
+    }
+    map.build_end();
+
+    for (auto _ : state)
+    {
+        for (AoL::U64 query : ids.queries)
+        {
+            benchmark::DoNotOptimize(map.find(query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+
+static void BM_FlatKeyOrderMapFindLargeValue(benchmark::State& state)
+{
+    RunLargeValueMapFind<AoL::FlatKeyOrderMap<AoL::U64, LargeValue>>(state);
+}
+BENCHMARK(BM_FlatKeyOrderMapFindLargeValue)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+static void BM_FlatKeyOrderMapSoAFindLargeValue(benchmark::State& state)
+{
+    RunLargeValueMapFind<AoL::FlatKeyOrderMapSoA<AoL::U64, LargeValue>>(state);
+}
+BENCHMARK(BM_FlatKeyOrderMapSoAFindLargeValue)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// Read only maps of ids, about one query in nine hits: binary search against one hash and one probe
+static AoL::FlatKeyOrderMap<AoL::U64, AoL::U64> MakeIdMap(const SortedIds& ids)
+{
+    AoL::FlatKeyOrderMap<AoL::U64, AoL::U64> map;
+    map.build_start();
+    for (AoL::U64 id : ids.values)
+    {
+        map.build_add(id, id);
+    }
+    map.build_end();
+    return map;
+}
+
+template<typename Map>
+static void RunIdMapFind(benchmark::State& state)
+{
+    const SortedIds ids{ static_cast<AoL::SizeT>(state.range(0)) };
+    const Map map{ MakeIdMap(ids) };
+
+    for (auto _ : state)
+    {
+        for (AoL::U64 query : ids.queries)
+        {
+            benchmark::DoNotOptimize(map.find(query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+
+static void BM_FlatKeyOrderMapFindIds(benchmark::State& state)
+{
+    RunIdMapFind<AoL::FlatKeyOrderMap<AoL::U64, AoL::U64>>(state);
+}
+BENCHMARK(BM_FlatKeyOrderMapFindIds)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+
+static void BM_FrozenHashMapFindIds(benchmark::State& state)
+{
+    RunIdMapFind<AoL::FrozenHashMap<AoL::U64, AoL::U64>>(state);
+}
+BENCHMARK(BM_FrozenHashMapFindIds)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+
+static void BM_FrozenHashMapBuild(benchmark::State& state)
+{
+    const AoL::FlatKeyOrderMap<AoL::U64, AoL::U64> source = MakeIdMap(SortedIds{ static_cast<AoL::SizeT>(state.range(0)) });
+
+    for (auto _ : state)
+    {
+        AoL::FrozenHashMap<AoL::U64, AoL::U64> map{ source };
+        benchmark::DoNotOptimize(map.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FrozenHashMapBuild)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMillisecond);
+
+// 64 entry enum -> config table, the shape of the static tables rebuilt at every startup
+enum class TableKey : AoL::U32
+{
+};
+
+struct TableConfig
+{
+    AoL::U32 id;
+    AoL::U32 flags;
+    double scale;
+};
+
+constexpr AoL::SizeT TableSize = 64;
+
+constexpr AoL::Array<AoL::FlatKeyOrderMapPair<TableKey, TableConfig>, TableSize> TableItems = []
+{
+    AoL::Array<AoL::FlatKeyOrderMapPair<TableKey, TableConfig>, TableSize> items{ };
+    for (AoL::U32 i = 0; i < TableSize; ++i)
+    {
+        const AoL::U32 key = (i * 37) % TableSize;
+        items[i] = { static_cast<TableKey>(key * 3), TableConfig{ key, i, key * 0.5 } };
+    }
+    return items;
+}();
+
+constexpr AoL::ConstexprKeyOrderMap<TableKey, TableConfig, TableSize> ConstexprTable{ TableItems };
+
+static AoL::FlatKeyOrderMap<TableKey, TableConfig> MakeStartupTable()
+{
+    AoL::FlatKeyOrderMap<TableKey, TableConfig> map;
+    map.build_start();
+    for (const auto& item : TableItems)
+    {
+        map.build_add(item.first, item.second);
+    }
+    map.build_end();
+    return map;
+}
+
+template<typename Map>
+static void RunTableFind(benchmark::State& state, const Map& map)
+{
+    std::mt19937_64 rng{ 42 };
+    std::uniform_int_distribution<AoL::U32> dist{ 0, TableSize * 3 };
+    AoL::Vector<TableKey> queries(QueryCount);
+    for (auto& query : queries)
+    {
+        query = static_cast<TableKey>(dist(rng));
+    }
+
+    for (auto _ : state)
+    {
+        for (TableKey query : queries)
+        {
+            benchmark::DoNotOptimize(map.find(query));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+
+static void BM_FlatKeyOrderMapTableBuild(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        AoL::FlatKeyOrderMap<TableKey, TableConfig> map = MakeStartupTable();
+        benchmark::DoNotOptimize(map.data());
+    }
+}
+BENCHMARK(BM_FlatKeyOrderMapTableBuild);
+
+static void BM_FlatKeyOrderMapTableFind(benchmark::State& state)
+{
+    RunTableFind(state, MakeStartupTable());
+}
+BENCHMARK(BM_FlatKeyOrderMapTableFind);
+
+static void BM_ConstexprKeyOrderMapTableFind(benchmark::State& state)
+{
+    RunTableFind(state, ConstexprTable);
+}
+BENCHMARK(BM_ConstexprKeyOrderMapTableFind);
@@ -0,0 +1,141 @@
+/********************************************************************
+* Find algorithm suite: FindLowerBoundGeneral, FindLowerBoundBranchless, FindLowerBoundRandom,
+* EytzingerIndex and FindBrute over 16 to 16M elements, hot and cold caches and several key types
+*
+* - Names read BM_Suite<Search>/<key type>/<cache>/<size>
+*
+* - Hot runs repeat QueryCount queries back to back, cold runs evict the caches before every
+*   ColdQueryCount queries
+*
+* - FindBrute is linear, so it stops at 64K elements
+********************************************************************/
+
+
+#include "pch.h"
+#include "benchmark-helpers.h"
+
+#include "aol/algorithms.h"
+#include "aol/randoms.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+
+
+namespace
+{
+
+using BenchmarkHelpers::Cache;
+
+constexpr AoL::SizeT QueryCount = 4096;
+constexpr AoL::SizeT ColdQueryCount = 64;
+constexpr AoL::I64 ColdIterations = 64;
+constexpr AoL::I64 FindBruteMaxSize = AoL::I64{ 64 } << 10;
+
+template<typename T, Cache CacheMode, typename Search>
+void RunSearches(benchmark::State& state, const AoL::Vector<T>& queries, Search search)
+{
+    if constexpr (CacheMode == Cache::Hot)
+    {
+        for (auto _ : state)
+        {
+            for (const T& query : queries)
+            {
+                benchmark::DoNotOptimize(search(query));
+            }
+        }
+        BenchmarkHelpers::ReportPerOp(state, queries.size(), queries.size());
+    }
+    else
+    {
+        AoL::SizeT offset = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            BenchmarkHelpers::FlushCache();
+            state.ResumeTiming();
+
+            for (AoL::SizeT i = 0; i < ColdQueryCount; ++i)
+            {
+                benchmark::DoNotOptimize(search(queries[(offset + i) % queries.size()]));
+            }
+            offset += ColdQueryCount;
+        }
+        BenchmarkHelpers::ReportPerOp(state, ColdQueryCount, ColdQueryCount);
+    }
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteFindLowerBoundGeneral(benchmark::State& state)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    const AoL::Vector<T> keys = BenchmarkHelpers::MakeSortedKeys<T>(size);
+    const AoL::Vector<T> queries = BenchmarkHelpers::MakeQueries<T>(size, QueryCount);
+    const T* p_begin = keys.data();
+    const T* p_end = p_begin + keys.size();
+
+    RunSearches<T, CacheMode>(state, queries, [&](const T& query) { return AoL::FindLowerBoundGeneral(p_begin, p_end, query); });
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteFindLowerBoundBranchless(benchmark::State& state)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    const AoL::Vector<T> keys = BenchmarkHelpers::MakeSortedKeys<T>(size);
+    const AoL::Vector<T> queries = BenchmarkHelpers::MakeQueries<T>(size, QueryCount);
+    const T* p_begin = keys.data();
+    const T* p_end = p_begin + keys.size();
+
+    RunSearches<T, CacheMode>(state, queries, [&](const T& query) { return AoL::FindLowerBoundBranchless(p_begin, p_end, query); });
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteFindLowerBoundRandom(benchmark::State& state)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    const AoL::Vector<T> keys = BenchmarkHelpers::MakeSortedKeys<T>(size);
+    const AoL::Vector<T> queries = BenchmarkHelpers::MakeQueries<T>(size, QueryCount);
+    const T* p_begin = keys.data();
+    const T* p_end = p_begin + keys.size();
+    AoL::Rand::DefaultGen rng(42);
+
+    RunSearches<T, CacheMode>(state, queries, [&](const T& query) { return AoL::FindLowerBoundRandom(p_begin, p_end, query, rng); });
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteEytzingerIndex(benchmark::State& state)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    const AoL::Vector<T> keys = BenchmarkHelpers::MakeSortedKeys<T>(size);
+    const AoL::Vector<T> queries = BenchmarkHelpers::MakeQueries<T>(size, QueryCount);
+    const AoL::EytzingerIndex<T> index(keys.begin(), keys.end());
+
+    RunSearches<T, CacheMode>(state, queries, [&](const T& query) { return index.lower_bound(query); });
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteFindBrute(benchmark::State& state)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    const AoL::Vector<T> keys = BenchmarkHelpers::MakeSortedKeys<T>(size);
+    const AoL::Vector<T> queries = BenchmarkHelpers::MakeQueries<T>(size, QueryCount);
+
+    RunSearches<T, CacheMode>(state, queries, [&](const T& query) { return AoL::FindBrute(keys.begin(), keys.end(), query); });
+}
+
+}
+
+#define AOL_BENCHMARK_FIND_SUITE(Search, Type, MaxSize)                                                           \
+    BENCHMARK(Search<Type, Cache::Hot>)->Name(#Search "/" #Type "/hot")->RangeMultiplier(8)                      \
+        ->Range(BenchmarkHelpers::MinSize, MaxSize);                                                             \
+    BENCHMARK(Search<Type, Cache::Cold>)->Name(#Search "/" #Type "/cold")->RangeMultiplier(8)                    \
+        ->Range(BenchmarkHelpers::MinSize, MaxSize)->Iterations(ColdIterations)
+
+#define AOL_BENCHMARK_FIND_SUITE_TYPES(Search, MaxSize)    \
+    AOL_BENCHMARK_FIND_SUITE(Search, AoL::U32, MaxSize);   \
+    AOL_BENCHMARK_FIND_SUITE(Search, AoL::U64, MaxSize);   \
+    AOL_BENCHMARK_FIND_SUITE(Search, double, MaxSize)
+
+AOL_BENCHMARK_FIND_SUITE_TYPES(BM_SuiteFindLowerBoundGeneral, BenchmarkHelpers::MaxSize);
+AOL_BENCHMARK_FIND_SUITE_TYPES(BM_SuiteFindLowerBoundBranchless, BenchmarkHelpers::MaxSize);
+AOL_BENCHMARK_FIND_SUITE_TYPES(BM_SuiteFindLowerBoundRandom, BenchmarkHelpers::MaxSize);
+AOL_BENCHMARK_FIND_SUITE_TYPES(BM_SuiteEytzingerIndex, BenchmarkHelpers::MaxSize);
+AOL_BENCHMARK_FIND_SUITE_TYPES(BM_SuiteFindBrute, FindBruteMaxSize);
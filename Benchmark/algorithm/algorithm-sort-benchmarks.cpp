@@ -0,0 +1,691 @@
+/********************************************************************
+* Sort algorithm suite: Sort, SortReverse, std::sort and RadixSort over 16 to 16M elements, hot and cold caches and several key types
+*
+* - Names read BM_Suite<Sort>/<key type>/<cache>/<size>
+*
+* - Every iteration sorts SortBatchElements / size fresh copies of the same random input (at least one),
+*   so small sizes are not dominated by the refill. Hot runs sort the copies right after refilling them,
+*   cold runs evict the caches in between
+*
+* - time/op is per sort call, items_per_second counts elements
+*
+* - U32 and double ranges go through SortVectorized in Sort and SortReverse, BM_SuiteStdSort is the baseline
+*
+* - BM_<Sort>Presorted/<size>/<shape> sorts map pairs, 0: sorted with 1% appended, 1: 16 sorted runs, 2: random,
+*   SortAdaptive and build_end() against Sort and RadixSortByKey
+*
+* - BM_KeyOrderMap<Insert|LogInsert><Loop|Bulk>/<batch> inserts a batch into a 1M pair map, insert() per element against insert_bulk()
+*   and FlatKeyOrderMapLog's insert(), BM_KeyOrderMapLogFind/<tail> looks keys up with an empty and a half full tail
+*
+* - BM_KeyOrderMapErase<Loop|If|Rebuild>/<batch> erases a batch of keys from a 1M pair map, erase() per key, erase_if()
+*   and a rebuild of the map without them
+*
+* - BM_SortBy<Key>/<size> sorts 64 byte records by a member, SortBy against std::sort with a member comparator
+*   (BM_SortByStdSort<U64>Comparator)
+*
+* - BM_SortParallel/<size>/<threads> reports speedup, Sort's time on the same input over SortParallel's
+*
+* - BM_KWayMerge<Variant>/<shards> merges sorted shards of 4M keys, KWayMerge, KWayMergeParallel and concatenation + Sort
+*
+* - BM_TopK<Variant>/<k> selects the top k of 5M scores, TopK, TopKParallel and SortReverse of the whole range
+*
+* - BM_ExternalSortFile/<memory MB> sorts a 512 MB file, 64 MB spills 8 runs, 1024 MB sorts it in memory
+*
+* - BM_SortFixed<Sort>/<key type>/<N> sorts a batch of small arrays, SortFixed's network against std::sort
+********************************************************************/
+
+
+#include "pch.h"
+#include "benchmark-helpers.h"
+
+#include "aol/algorithms.h"
+#include "aol/array.h"
+#include "aol/key_ordered_map.h"
+#include "aol/threads.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+
+
+namespace
+{
+
+using BenchmarkHelpers::Cache;
+
+constexpr AoL::SizeT SortBatchElements = AoL::SizeT{ 1 } << 16;
+
+template<typename T, Cache CacheMode, typename SortFunction>
+void RunSorts(benchmark::State& state, SortFunction sort_function)
+{
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    const AoL::SizeT copies = std::max<AoL::SizeT>(1, SortBatchElements / size);
+    const AoL::Vector<T> source = BenchmarkHelpers::MakeRandomKeys<T>(size);
+    AoL::Vector<T> work(size * copies);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (AoL::SizeT copy = 0; copy < copies; ++copy)
+        {
+            std::copy(source.begin(), source.end(), work.begin() + copy * size);
+        }
+        if constexpr (CacheMode == Cache::Cold)
+        {
+            BenchmarkHelpers::FlushCache();
+        }
+        state.ResumeTiming();
+
+        for (AoL::SizeT copy = 0; copy < copies; ++copy)
+        {
+            sort_function(work.begin() + copy * size, work.begin() + (copy + 1) * size);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    BenchmarkHelpers::ReportPerOp(state, copies, copies * size);
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteSort(benchmark::State& state)
+{
+    RunSorts<T, CacheMode>(state, [](auto it_begin, auto it_end) { AoL::Sort(it_begin, it_end); });
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteStdSort(benchmark::State& state)
+{
+    RunSorts<T, CacheMode>(state, [](auto it_begin, auto it_end) { std::sort(it_begin, it_end); });
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteRadixSort(benchmark::State& state)
+{
+    AoL::Vector<T> scratch;
+    RunSorts<T, CacheMode>(state, [&scratch](auto it_begin, auto it_end) { AoL::RadixSort(it_begin, it_end, scratch); });
+}
+
+template<typename T, Cache CacheMode>
+void BM_SuiteSortReverse(benchmark::State& state)
+{
+    RunSorts<T, CacheMode>(state, [](auto it_begin, auto it_end) { AoL::SortReverse(it_begin, it_end); });
+}
+
+}
+
+#define AOL_BENCHMARK_SORT_SUITE(Sort, Type)                                                                     \
+    BENCHMARK(Sort<Type, Cache::Hot>)->Name(#Sort "/" #Type "/hot")->RangeMultiplier(8)                         \
+        ->Range(BenchmarkHelpers::MinSize, BenchmarkHelpers::MaxSize)->Unit(benchmark::kMicrosecond);            \
+    BENCHMARK(Sort<Type, Cache::Cold>)->Name(#Sort "/" #Type "/cold")->RangeMultiplier(8)                       \
+        ->Range(BenchmarkHelpers::MinSize, BenchmarkHelpers::MaxSize)->Unit(benchmark::kMicrosecond)
+
+#define AOL_BENCHMARK_SORT_SUITE_TYPES(Sort)       \
+    AOL_BENCHMARK_SORT_SUITE(Sort, AoL::U32);      \
+    AOL_BENCHMARK_SORT_SUITE(Sort, AoL::U64);      \
+    AOL_BENCHMARK_SORT_SUITE(Sort, double)
+
+AOL_BENCHMARK_SORT_SUITE_TYPES(BM_SuiteSort);
+AOL_BENCHMARK_SORT_SUITE_TYPES(BM_SuiteSortReverse);
+AOL_BENCHMARK_SORT_SUITE_TYPES(BM_SuiteStdSort);
+AOL_BENCHMARK_SORT_SUITE_TYPES(BM_SuiteRadixSort);
+
+// Map loads: integer keyed pairs sorted by key, as FlatKeyOrderMap::build_end() does
+using MapPair = AoL::Internal::KeyValuePairEx<AoL::U64, AoL::U64>;
+
+static AoL::Vector<MapPair> MakeMapPairs(AoL::SizeT size)
+{
+    const AoL::Vector<AoL::U64> keys = BenchmarkHelpers::MakeRandomKeys<AoL::U64>(size);
+    AoL::Vector<MapPair> pairs(size);
+
+    // Ids rarely use the full 64 bits, keep about 40 of them
+    for (AoL::SizeT i = 0; i < size; ++i)
+    {
+        pairs[i] = MapPair{ keys[i] >> 24, i };
+    }
+    return pairs;
+}
+
+static void BM_SortMapPairs(benchmark::State& state)
+{
+    const AoL::Vector<MapPair> source = MakeMapPairs(static_cast<AoL::SizeT>(state.range(0)));
+    AoL::Vector<MapPair> work;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        work = source;
+        state.ResumeTiming();
+
+        AoL::Sort(work.begin(), work.end());
+        benchmark::ClobberMemory();
+    }
+
+    BenchmarkHelpers::ReportPerOp(state, 1, source.size());
+}
+BENCHMARK(BM_SortMapPairs)->RangeMultiplier(8)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMillisecond);
+
+static void BM_RadixSortByKeyMapPairs(benchmark::State& state)
+{
+    const AoL::Vector<MapPair> source = MakeMapPairs(static_cast<AoL::SizeT>(state.range(0)));
+    AoL::Vector<MapPair> work;
+    AoL::Vector<MapPair> scratch;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        work = source;
+        state.ResumeTiming();
+
+        AoL::RadixSortByKey(work.begin(), work.end(), scratch);
+        benchmark::ClobberMemory();
+    }
+
+    BenchmarkHelpers::ReportPerOp(state, 1, source.size());
+}
+BENCHMARK(BM_RadixSortByKeyMapPairs)->RangeMultiplier(8)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMillisecond);
+
+// Presorted map loads: 0 is a sorted load with 1% random pairs appended, 1 is 16 sorted loads concatenated, 2 is random
+static AoL::Vector<MapPair> MakePresortedMapPairs(AoL::SizeT size, AoL::I64 shape)
+{
+    AoL::Vector<MapPair> pairs = MakeMapPairs(size);
+    if (shape == 0)
+    {
+        std::sort(pairs.begin(), pairs.end() - static_cast<AoL::PtrDiff>(size / 100));
+    }
+    else if (shape == 1)
+    {
+        for (AoL::SizeT run = 0; run < 16; ++run)
+        {
+            std::sort(pairs.begin() + static_cast<AoL::PtrDiff>(size * run / 16), pairs.begin() + static_cast<AoL::PtrDiff>(size * (run + 1) / 16));
+        }
+    }
+    return pairs;
+}
+
+template<typename SortFunction>
+static void RunPresortedMapPairs(benchmark::State& state, SortFunction sort_function)
+{
+    const AoL::Vector<MapPair> source = MakePresortedMapPairs(static_cast<AoL::SizeT>(state.range(0)), state.range(1));
+    AoL::Vector<MapPair> work;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        work = source;
+        state.ResumeTiming();
+
+        sort_function(work);
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, source.size());
+}
+
+static void BM_SortAdaptivePresorted(benchmark::State& state)
+{
+    RunPresortedMapPairs(state, [](auto& work) { AoL::SortAdaptive(work.begin(), work.end()); });
+}
+BENCHMARK(BM_SortAdaptivePresorted)->ArgsProduct({ { 1 << 16, 1 << 20, 1 << 23 }, { 0, 1, 2 } })->Unit(benchmark::kMillisecond);
+
+static void BM_SortPresorted(benchmark::State& state)
+{
+    RunPresortedMapPairs(state, [](auto& work) { AoL::Sort(work.begin(), work.end()); });
+}
+BENCHMARK(BM_SortPresorted)->ArgsProduct({ { 1 << 16, 1 << 20, 1 << 23 }, { 0, 1, 2 } })->Unit(benchmark::kMillisecond);
+
+// build_end() before SortAdaptive: the whole load radix sorted
+static void BM_RadixSortByKeyPresorted(benchmark::State& state)
+{
+    RunPresortedMapPairs(state, [](auto& work) { AoL::RadixSortByKey(work.begin(), work.end()); });
+}
+BENCHMARK(BM_RadixSortByKeyPresorted)->ArgsProduct({ { 1 << 16, 1 << 20, 1 << 23 }, { 0, 1, 2 } })->Unit(benchmark::kMillisecond);
+
+static void BM_KeyOrderMapBuildEndPresorted(benchmark::State& state)
+{
+    const AoL::Vector<MapPair> source = MakePresortedMapPairs(static_cast<AoL::SizeT>(state.range(0)), state.range(1));
+    AoL::FlatKeyOrderMap<AoL::U64, AoL::U64> map;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        map.container_obj = source;
+        map.build_start();
+        state.ResumeTiming();
+
+        map.build_end();
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, source.size());
+}
+BENCHMARK(BM_KeyOrderMapBuildEndPresorted)->ArgsProduct({ { 1 << 16, 1 << 20, 1 << 23 }, { 0, 1, 2 } })->Unit(benchmark::kMillisecond);
+
+// Batches inserted into a live map of 1M pairs (even keys), the batch holds distinct odd keys in random order
+template<typename Map>
+static Map MakeLiveMap()
+{
+    Map map;
+    map.build_start();
+    for (AoL::U64 i = 0; i < (AoL::U64{ 1 } << 20); ++i)
+    {
+        map.build_add(i * 2, i);
+    }
+    map.build_end();
+    return map;
+}
+
+static AoL::Vector<MapPair> MakeInsertBatch(AoL::SizeT size)
+{
+    AoL::Vector<MapPair> batch(size);
+    const AoL::U64 stride = (AoL::U64{ 1 } << 20) / size;
+    for (AoL::SizeT i = 0; i < size; ++i)
+    {
+        batch[i] = MapPair{ (i * stride) * 2 + 1, i };
+    }
+    std::shuffle(batch.begin(), batch.end(), std::mt19937_64{ 42 });
+    return batch;
+}
+
+template<typename Map, typename InsertFunction>
+static void RunInsertBatch(benchmark::State& state, InsertFunction insert_function)
+{
+    const Map source = MakeLiveMap<Map>();
+    const AoL::Vector<MapPair> batch = MakeInsertBatch(static_cast<AoL::SizeT>(state.range(0)));
+    Map map;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        map = source;
+        state.ResumeTiming();
+
+        insert_function(map, batch);
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, batch.size());
+}
+
+static void BM_KeyOrderMapInsertLoop(benchmark::State& state)
+{
+    RunInsertBatch<AoL::FlatKeyOrderMap<AoL::U64, AoL::U64>>(state, [](auto& map, const auto& batch)
+    {
+        for (const MapPair& pair : batch)
+        {
+            map.insert(pair.first, pair.second);
+        }
+    });
+}
+BENCHMARK(BM_KeyOrderMapInsertLoop)->RangeMultiplier(8)->Range(1 << 8, 1 << 14)->Unit(benchmark::kMillisecond);
+
+static void BM_KeyOrderMapInsertBulk(benchmark::State& state)
+{
+    RunInsertBatch<AoL::FlatKeyOrderMap<AoL::U64, AoL::U64>>(state, [](auto& map, const auto& batch) { map.insert_bulk(batch.begin(), batch.end()); });
+}
+BENCHMARK(BM_KeyOrderMapInsertBulk)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Unit(benchmark::kMillisecond);
+
+// One insert() at a time into FlatKeyOrderMapLog, the tail merges included
+static void BM_KeyOrderMapLogInsertLoop(benchmark::State& state)
+{
+    RunInsertBatch<AoL::FlatKeyOrderMapLog<AoL::U64, AoL::U64>>(state, [](auto& map, const auto& batch)
+    {
+        for (const MapPair& pair : batch)
+        {
+            map.insert(pair.first, pair.second);
+        }
+    });
+}
+BENCHMARK(BM_KeyOrderMapLogInsertLoop)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Unit(benchmark::kMillisecond);
+
+// Lookups of keys of the main array and of the tail, FlatKeyOrderMapLog's tail filled to half its limit
+static void BM_KeyOrderMapLogFind(benchmark::State& state)
+{
+    AoL::FlatKeyOrderMapLog<AoL::U64, AoL::U64> map = MakeLiveMap<AoL::FlatKeyOrderMapLog<AoL::U64, AoL::U64>>();
+    const AoL::Vector<MapPair> batch = MakeInsertBatch(512);
+    for (AoL::SizeT i = 0; i < static_cast<AoL::SizeT>(state.range(0)); ++i)
+    {
+        map.insert(batch[i].first, batch[i].second);
+    }
+
+    const AoL::Vector<AoL::U64> queries = BenchmarkHelpers::MakeRandomKeys<AoL::U64>(4096);
+    for (auto _ : state)
+    {
+        for (AoL::U64 query : queries)
+        {
+            benchmark::DoNotOptimize(map.find(query % (AoL::U64{ 1 } << 21)));
+        }
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, queries.size());
+}
+BENCHMARK(BM_KeyOrderMapLogFind)->Arg(0)->Arg(256);
+
+// Erases a batch of the live map's keys: erase() per key, compacted once at the end, against erase_if() with a sorted
+// key lookup and against the rebuild without erase, both of those sort the batch first
+static void BM_KeyOrderMapEraseLoop(benchmark::State& state)
+{
+    RunInsertBatch<AoL::FlatKeyOrderMap<AoL::U64, AoL::U64>>(state, [](auto& map, const auto& batch)
+    {
+        for (const MapPair& pair : batch)
+        {
+            map.erase(pair.first - 1);
+        }
+        map.compact();
+    });
+}
+BENCHMARK(BM_KeyOrderMapEraseLoop)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Unit(benchmark::kMillisecond);
+
+static AoL::Vector<AoL::U64> MakeSortedEraseKeys(const AoL::Vector<MapPair>& batch)
+{
+    AoL::Vector<AoL::U64> keys(batch.size());
+    std::transform(batch.begin(), batch.end(), keys.begin(), [](const MapPair& pair) { return pair.first - 1; });
+    AoL::Sort(keys.begin(), keys.end());
+    return keys;
+}
+
+static void BM_KeyOrderMapEraseIf(benchmark::State& state)
+{
+    RunInsertBatch<AoL::FlatKeyOrderMap<AoL::U64, AoL::U64>>(state, [](auto& map, const auto& batch)
+    {
+        const AoL::Vector<AoL::U64> keys = MakeSortedEraseKeys(batch);
+        map.erase_if([&keys](const auto& item) { return std::binary_search(keys.begin(), keys.end(), item.first); });
+    });
+}
+BENCHMARK(BM_KeyOrderMapEraseIf)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Unit(benchmark::kMillisecond);
+
+static void BM_KeyOrderMapEraseRebuild(benchmark::State& state)
+{
+    RunInsertBatch<AoL::FlatKeyOrderMap<AoL::U64, AoL::U64>>(state, [](auto& map, const auto& batch)
+    {
+        const AoL::Vector<AoL::U64> keys = MakeSortedEraseKeys(batch);
+        AoL::FlatKeyOrderMap<AoL::U64, AoL::U64> rebuilt;
+        rebuilt.build_start();
+        for (const auto& item : map)
+        {
+            if (!std::binary_search(keys.begin(), keys.end(), item.first))
+            {
+                rebuilt.build_add(item.first, item.second);
+            }
+        }
+        rebuilt.build_end();
+        map = std::move(rebuilt);
+    });
+}
+BENCHMARK(BM_KeyOrderMapEraseRebuild)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Unit(benchmark::kMillisecond);
+
+// Structs sorted by a member: SortBy's cached keys against std::sort with a comparator loading the member of both sides
+struct SortByRecord
+{
+    AoL::U32 priority;
+    AoL::U64 timestamp;
+    AoL::U64 payload[6];
+};
+
+static AoL::Vector<SortByRecord> MakeSortByRecords(AoL::SizeT size)
+{
+    const AoL::Vector<AoL::U64> keys = BenchmarkHelpers::MakeRandomKeys<AoL::U64>(size);
+    AoL::Vector<SortByRecord> records(size);
+    for (AoL::SizeT i = 0; i < size; ++i)
+    {
+        records[i].priority = static_cast<AoL::U32>(keys[i]);
+        records[i].timestamp = keys[i];
+        records[i].payload[0] = i;
+    }
+    return records;
+}
+
+template<typename SortFunction>
+static void RunSortBy(benchmark::State& state, SortFunction sort_function)
+{
+    const AoL::Vector<SortByRecord> source = MakeSortByRecords(static_cast<AoL::SizeT>(state.range(0)));
+    AoL::Vector<SortByRecord> work;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        work = source;
+        state.ResumeTiming();
+
+        sort_function(work);
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, source.size());
+}
+
+static void BM_SortByU32Member(benchmark::State& state)
+{
+    RunSortBy(state, [](auto& work) { AoL::SortBy(work.begin(), work.end(), &SortByRecord::priority); });
+}
+BENCHMARK(BM_SortByU32Member)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Unit(benchmark::kMillisecond);
+
+static void BM_SortByU64Member(benchmark::State& state)
+{
+    RunSortBy(state, [](auto& work) { AoL::SortBy(work.begin(), work.end(), &SortByRecord::timestamp); });
+}
+BENCHMARK(BM_SortByU64Member)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Unit(benchmark::kMillisecond);
+
+static void BM_SortByStdSortComparator(benchmark::State& state)
+{
+    RunSortBy(state, [](auto& work) { std::sort(work.begin(), work.end(), [](const SortByRecord& a, const SortByRecord& b) { return a.priority < b.priority; }); });
+}
+BENCHMARK(BM_SortByStdSortComparator)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Unit(benchmark::kMillisecond);
+
+static void BM_SortByStdSortU64Comparator(benchmark::State& state)
+{
+    RunSortBy(state, [](auto& work) { std::sort(work.begin(), work.end(), [](const SortByRecord& a, const SortByRecord& b) { return a.timestamp < b.timestamp; }); });
+}
+BENCHMARK(BM_SortByStdSortU64Comparator)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Unit(benchmark::kMillisecond);
+
+// Parallel sort speedup: the same random input sorted by Sort once, then by SortParallel on a pool of the given thread count
+static void BM_SortParallel(benchmark::State& state)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const AoL::SizeT size = static_cast<AoL::SizeT>(state.range(0));
+    const AoL::SizeT thread_count = static_cast<AoL::SizeT>(state.range(1));
+    const AoL::Vector<AoL::U64> source = BenchmarkHelpers::MakeRandomKeys<AoL::U64>(size);
+    AoL::Vector<AoL::U64> work = source;
+
+    const Clock::time_point sort_start = Clock::now();
+    AoL::Sort(work.begin(), work.end());
+    const double sort_seconds = std::chrono::duration<double>(Clock::now() - sort_start).count();
+
+    // The waiting thread is one of the threads
+    AoL::ThreadPool pool(thread_count - 1);
+    double parallel_seconds = 0.0;
+    for (auto _ : state)
+    {
+        work = source;
+
+        const Clock::time_point start = Clock::now();
+        AoL::SortParallel(pool, work.begin(), work.end());
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        state.SetIterationTime(seconds);
+        parallel_seconds += seconds;
+    }
+
+    state.counters["speedup"] = sort_seconds * static_cast<double>(state.iterations()) / parallel_seconds;
+    BenchmarkHelpers::ReportPerOp(state, 1, size);
+}
+BENCHMARK(BM_SortParallel)->ArgsProduct({ { 1 << 20, 1 << 24 }, benchmark::CreateRange(1, std::max(1u, std::thread::hardware_concurrency()), 2) })
+    ->ArgNames({ "size", "threads" })->UseManualTime()->Unit(benchmark::kMillisecond);
+
+// Sorted shards of 4M U64 keys in total, merged into one vector against concatenating and sorting them again
+static AoL::Vector<AoL::Vector<AoL::U64>> MakeSortedShards(AoL::SizeT shard_count)
+{
+    constexpr AoL::SizeT total = AoL::SizeT{ 1 } << 22;
+    const AoL::Vector<AoL::U64> keys = BenchmarkHelpers::MakeRandomKeys<AoL::U64>(total);
+    AoL::Vector<AoL::Vector<AoL::U64>> shards(shard_count);
+    for (AoL::SizeT shard = 0; shard < shard_count; ++shard)
+    {
+        shards[shard].assign(keys.begin() + static_cast<AoL::PtrDiff>(shard * total / shard_count), keys.begin() + static_cast<AoL::PtrDiff>((shard + 1) * total / shard_count));
+        AoL::Sort(shards[shard].begin(), shards[shard].end());
+    }
+    return shards;
+}
+
+static void BM_KWayMerge(benchmark::State& state)
+{
+    const auto shards = MakeSortedShards(static_cast<AoL::SizeT>(state.range(0)));
+    AoL::Vector<AoL::U64> merged(AoL::SizeT{ 1 } << 22);
+    for (auto _ : state)
+    {
+        AoL::KWayMerge(shards, merged.begin());
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, merged.size());
+}
+BENCHMARK(BM_KWayMerge)->RangeMultiplier(4)->Range(2, 128)->Unit(benchmark::kMillisecond);
+
+static void BM_KWayMergeParallel(benchmark::State& state)
+{
+    const auto shards = MakeSortedShards(static_cast<AoL::SizeT>(state.range(0)));
+    AoL::Vector<AoL::U64> merged(AoL::SizeT{ 1 } << 22);
+    for (auto _ : state)
+    {
+        AoL::KWayMergeParallel(shards, merged.begin());
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, merged.size());
+}
+BENCHMARK(BM_KWayMergeParallel)->RangeMultiplier(4)->Range(2, 128)->Unit(benchmark::kMillisecond);
+
+static void BM_KWayMergeConcatSort(benchmark::State& state)
+{
+    const auto shards = MakeSortedShards(static_cast<AoL::SizeT>(state.range(0)));
+    AoL::Vector<AoL::U64> merged(AoL::SizeT{ 1 } << 22);
+    for (auto _ : state)
+    {
+        auto it_out = merged.begin();
+        for (const auto& shard : shards)
+        {
+            it_out = std::copy(shard.begin(), shard.end(), it_out);
+        }
+        AoL::Sort(merged.begin(), merged.end());
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, merged.size());
+}
+BENCHMARK(BM_KWayMergeConcatSort)->RangeMultiplier(4)->Range(2, 128)->Unit(benchmark::kMillisecond);
+
+// Top k of 5M random U32 scores: TopK, TopKParallel and SortReverse of a copy of the whole range
+static constexpr AoL::SizeT TopKScoreCount = 5000000;
+
+static void BM_TopK(benchmark::State& state)
+{
+    const AoL::Vector<AoL::U32> scores = BenchmarkHelpers::MakeRandomKeys<AoL::U32>(TopKScoreCount);
+    AoL::Vector<AoL::U32> top(static_cast<AoL::SizeT>(state.range(0)));
+    for (auto _ : state)
+    {
+        AoL::TopK(scores.begin(), scores.end(), top.size(), top.begin());
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, scores.size());
+}
+BENCHMARK(BM_TopK)->Arg(100)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_TopKParallel(benchmark::State& state)
+{
+    const AoL::Vector<AoL::U32> scores = BenchmarkHelpers::MakeRandomKeys<AoL::U32>(TopKScoreCount);
+    AoL::Vector<AoL::U32> top(static_cast<AoL::SizeT>(state.range(0)));
+    for (auto _ : state)
+    {
+        AoL::TopKParallel(scores.begin(), scores.end(), top.size(), top.begin());
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, scores.size());
+}
+BENCHMARK(BM_TopKParallel)->Arg(100)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_TopKSortReverse(benchmark::State& state)
+{
+    const AoL::Vector<AoL::U32> scores = BenchmarkHelpers::MakeRandomKeys<AoL::U32>(TopKScoreCount);
+    AoL::Vector<AoL::U32> work;
+    AoL::Vector<AoL::U32> top(static_cast<AoL::SizeT>(state.range(0)));
+    for (auto _ : state)
+    {
+        work = scores;
+        AoL::SortReverse(work.begin(), work.end());
+        std::copy_n(work.begin(), top.size(), top.begin());
+        benchmark::ClobberMemory();
+    }
+    BenchmarkHelpers::ReportPerOp(state, 1, scores.size());
+}
+BENCHMARK(BM_TopKSortReverse)->Arg(100)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// External sort of a file of 64M U64 keys (512 MB) with a 64 MB budget, against reading it and sorting it in memory
+static void BM_ExternalSortFile(benchmark::State& state)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path input = directory / "aol-benchmark-external-sort-input.bin";
+    const std::filesystem::path output = directory / "aol-benchmark-external-sort-output.bin";
+    {
+        const AoL::Vector<AoL::U64> keys = BenchmarkHelpers::MakeRandomKeys<AoL::U64>(AoL::SizeT{ 1 } << 26);
+        std::ofstream file(input, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(AoL::U64)));
+    }
+
+    for (auto _ : state)
+    {
+        AoL::ExternalSortFile<AoL::U64>(input, output, static_cast<AoL::SizeT>(state.range(0)) << 20);
+    }
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+    BenchmarkHelpers::ReportPerOp(state, 1, AoL::SizeT{ 1 } << 26);
+}
+BENCHMARK(BM_ExternalSortFile)->Arg(64)->Arg(1024)->ArgName("memory_mb")->Unit(benchmark::kMillisecond)->Iterations(1);
+
+// Small fixed size arrays: a batch of AoL::Array<T, N> with random contents sorted one by one
+template<typename T, AoL::SizeT N, typename SortFunction>
+static void RunFixedSorts(benchmark::State& state, SortFunction sort_function)
+{
+    constexpr AoL::SizeT batch = 4096;
+    const AoL::Vector<T> keys = BenchmarkHelpers::MakeRandomKeys<T>(batch * N);
+    AoL::Vector<AoL::Array<T, N>> source(batch);
+    for (AoL::SizeT i = 0; i < batch * N; ++i)
+    {
+        source[i / N][i % N] = keys[i];
+    }
+    AoL::Vector<AoL::Array<T, N>> work;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        work = source;
+        state.ResumeTiming();
+
+        for (auto& arr : work)
+        {
+            sort_function(arr);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    BenchmarkHelpers::ReportPerOp(state, batch, batch * N);
+}
+
+template<typename T, AoL::SizeT N>
+static void BM_SortFixedNetwork(benchmark::State& state)
+{
+    RunFixedSorts<T, N>(state, [](auto& arr) { AoL::SortFixed(arr); });
+}
+
+template<typename T, AoL::SizeT N>
+static void BM_SortFixedStdSort(benchmark::State& state)
+{
+    RunFixedSorts<T, N>(state, [](auto& arr) { std::sort(arr.begin(), arr.end()); });
+}
+
+#define AOL_BENCHMARK_SORT_FIXED(Type, N)                                                       \
+    BENCHMARK(BM_SortFixedNetwork<Type, N>)->Name("BM_SortFixedNetwork/" #Type "/" #N);         \
+    BENCHMARK(BM_SortFixedStdSort<Type, N>)->Name("BM_SortFixedStdSort/" #Type "/" #N)
+
+#define AOL_BENCHMARK_SORT_FIXED_SIZES(Type)   \
+    AOL_BENCHMARK_SORT_FIXED(Type, 4);         \
+    AOL_BENCHMARK_SORT_FIXED(Type, 8);         \
+    AOL_BENCHMARK_SORT_FIXED(Type, 16);        \
+    AOL_BENCHMARK_SORT_FIXED(Type, 32)
+
+AOL_BENCHMARK_SORT_FIXED_SIZES(float);
+AOL_BENCHMARK_SORT_FIXED_SIZES(AoL::I32);
+AOL_BENCHMARK_SORT_FIXED_SIZES(AoL::U64);
+
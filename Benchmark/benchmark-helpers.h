@@ -0,0 +1,130 @@
+/********************************************************************
+* Shared benchmark helpers: key generation, cache modes and per operation counters
+********************************************************************/
+#pragma once
+
+#include "pch.h"
+
+#include "aol/types.h"
+#include "aol/vector.h"
+
+#include <algorithm>
+#include <random>
+#include <type_traits>
+
+
+namespace BenchmarkHelpers
+{
+
+/**
+* @details Cache state of the data when the timed region starts
+*
+* - Hot: the data was just touched, so it sits in whatever cache level it fits in
+*
+* - Cold: the caches were evicted right before, so every access starts from memory
+*/
+enum class Cache
+{
+    Hot,
+    Cold
+};
+
+// Larger than the last level cache of the machines we benchmark on
+constexpr AoL::SizeT CacheFlushBytes = AoL::SizeT{ 64 } << 20;
+
+// Sizes covered by the suites, 16 to 16M elements
+constexpr AoL::I64 MinSize = 16;
+constexpr AoL::I64 MaxSize = AoL::I64{ 16 } << 20;
+
+// Evicts the data caches by streaming through a buffer larger than the last level cache
+inline void FlushCache()
+{
+    static AoL::Vector<AoL::U64> buffer(CacheFlushBytes / sizeof(AoL::U64), 1);
+
+    AoL::U64 sum = 0;
+    for (AoL::SizeT i = 0; i < buffer.size(); i += 64 / sizeof(AoL::U64))
+    {
+        sum += buffer[i];
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+}
+
+// Key i of a sorted key set, spaced by 3 so that a third of uniform queries hit
+template<typename T>
+T MakeKey(AoL::U64 i) noexcept
+{
+    return static_cast<T>(i * 3);
+}
+
+template<typename T>
+AoL::Vector<T> MakeSortedKeys(AoL::SizeT size)
+{
+    AoL::Vector<T> keys(size);
+    for (AoL::SizeT i = 0; i < size; ++i)
+    {
+        keys[i] = MakeKey<T>(i);
+    }
+    return keys;
+}
+
+// Uniform queries over the key set span, including some past both ends
+template<typename T>
+AoL::Vector<T> MakeQueries(AoL::SizeT key_count, AoL::SizeT query_count, AoL::U64 seed = 42)
+{
+    std::mt19937_64 rng{ seed };
+    std::uniform_int_distribution<AoL::U64> dist{ 0, key_count * 3 + 2 };
+
+    AoL::Vector<T> queries(query_count);
+    for (auto& query : queries)
+    {
+        query = static_cast<T>(dist(rng));
+    }
+    return queries;
+}
+
+// Uniformly distributed unsorted keys
+template<typename T>
+AoL::Vector<T> MakeRandomKeys(AoL::SizeT size, AoL::U64 seed = 42)
+{
+    std::mt19937_64 rng{ seed };
+
+    AoL::Vector<T> keys(size);
+    for (auto& key : keys)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            key = std::uniform_real_distribution<T>{ static_cast<T>(-1e9), static_cast<T>(1e9) }(rng);
+        }
+        else
+        {
+            key = static_cast<T>(rng());
+        }
+    }
+    return keys;
+}
+
+/**
+* @details Reports the per operation counters shared by the suites
+*
+* - time/op: time per operation, shown with SI prefixes (i.e. 12.3n is 12.3 ns)
+*
+* - items_per_second: items (elements or queries) handled per second
+*
+* - ops: operations per iteration, to turn per iteration perf counters into per operation ones
+*
+* - Cache misses come from the library's perf counters, run with --benchmark_perf_counters=CACHE-MISSES
+*   on a build with libpfm (see BUILDING.md), they are reported per iteration
+*
+* @param state benchmark state
+* @param ops operations (searches, sorts) per iteration
+* @param items items per iteration
+*/
+inline void ReportPerOp(benchmark::State& state, AoL::SizeT ops, AoL::SizeT items)
+{
+    state.counters["ops"] = static_cast<double>(ops);
+    state.counters["time/op"] = benchmark::Counter(static_cast<double>(ops), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.SetItemsProcessed(state.iterations() * static_cast<AoL::I64>(items));
+}
+
+}
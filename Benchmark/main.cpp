@@ -0,0 +1,9 @@
+/********************************************************************
+* Benchmark entry point
+********************************************************************/
+
+
+#include "pch.h"
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "google_benchmark/benchmark.h"
\ No newline at end of file
@@ -1,11 +1,17 @@
 /********************************************************************
-* Find algorithm tests: FindBrute, FindLowerBound (general, branchless, default)
+* Find algorithm tests: FindBrute, FindLowerBound (general, branchless, linear, batch, galloping, interpolation, random, default), EytzingerIndex, StaticBTree,
+* LearnedIndex
 ********************************************************************/
 
 
 #include "pch.h"
 
 #include "aol/algorithms.h"
+#include "aol/randoms.h"
+
+#include <array>
+#include <limits>
+#include <list>
 
 
 namespace
@@ -157,6 +163,99 @@ TEST_F(FindBruteTest, FindWithArrayPointers)
     EXPECT_EQ(*it, 3);
 }
 
+TEST_F(FindBruteTest, FindMatchesStdFindForAllPositions)
+{
+    for (int size = 0; size <= 300; ++size)
+    {
+        IntVector vec(size);
+        for (int i = 0; i < size; ++i)
+        {
+            vec[i] = i * 7 - 100;
+        }
+
+        for (int i = -1; i <= size; ++i)
+        {
+            const int value = i * 7 - 100;
+            EXPECT_EQ(AoL::FindBrute(vec.begin(), vec.end(), value), std::find(vec.begin(), vec.end(), value)) << "size " << size << " value " << value;
+        }
+    }
+}
+
+TEST_F(FindBruteTest, FindArithmeticElementTypes)
+{
+    std::vector<unsigned char> byte_vec(100);
+    std::vector<short> short_vec(100);
+    std::vector<std::uint32_t> unsigned_vec(100);
+    std::vector<std::int64_t> int64_vec(100);
+    std::vector<std::uint64_t> uint64_vec(100);
+    std::vector<float> float_vec(100);
+    std::vector<double> double_vec(100);
+    for (int i = 0; i < 100; ++i)
+    {
+        byte_vec[i] = static_cast<unsigned char>(i * 2 + 50);
+        short_vec[i] = static_cast<short>(i * 300 - 15000);
+        unsigned_vec[i] = static_cast<std::uint32_t>(i) * 40000000u;
+        int64_vec[i] = static_cast<std::int64_t>(i) * 10000000000ll - 500000000000ll;
+        uint64_vec[i] = static_cast<std::uint64_t>(i) * 180000000000000000ull;
+        float_vec[i] = static_cast<float>(i) * 0.5f - 10.0f;
+        double_vec[i] = static_cast<double>(i) * 0.25 - 10.0;
+    }
+
+    for (int i = 0; i < 100; i += 9)
+    {
+        EXPECT_EQ(AoL::FindBrute(byte_vec.begin(), byte_vec.end(), byte_vec[i]) - byte_vec.begin(), i);
+        EXPECT_EQ(AoL::FindBrute(short_vec.begin(), short_vec.end(), short_vec[i]) - short_vec.begin(), i);
+        EXPECT_EQ(AoL::FindBrute(unsigned_vec.begin(), unsigned_vec.end(), unsigned_vec[i]) - unsigned_vec.begin(), i);
+        EXPECT_EQ(AoL::FindBrute(int64_vec.begin(), int64_vec.end(), int64_vec[i]) - int64_vec.begin(), i);
+        EXPECT_EQ(AoL::FindBrute(uint64_vec.begin(), uint64_vec.end(), uint64_vec[i]) - uint64_vec.begin(), i);
+        EXPECT_EQ(AoL::FindBrute(float_vec.begin(), float_vec.end(), float_vec[i]) - float_vec.begin(), i);
+        EXPECT_EQ(AoL::FindBrute(double_vec.begin(), double_vec.end(), double_vec[i]) - double_vec.begin(), i);
+    }
+
+    EXPECT_EQ(AoL::FindBrute(byte_vec.begin(), byte_vec.end(), static_cast<unsigned char>(49)), byte_vec.end());
+    EXPECT_EQ(AoL::FindBrute(uint64_vec.begin(), uint64_vec.end(), 1ull), uint64_vec.end());
+    EXPECT_EQ(AoL::FindBrute(float_vec.begin(), float_vec.end(), 0.25f), float_vec.end());
+    EXPECT_EQ(AoL::FindBrute(double_vec.begin(), double_vec.end(), std::numeric_limits<double>::quiet_NaN()), double_vec.end());
+}
+
+// Sizes around every multiple of the vector width, so the 4x loop leaves each possible remainder (0 to 4 vectors)
+template<typename T>
+static void ExpectFindBruteMatchesStdFind()
+{
+    for (std::size_t size = 0; size <= 270; ++size)
+    {
+        std::vector<T> vec(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            vec[i] = static_cast<T>(i % 120 + 1);
+        }
+
+        for (std::size_t i = 0; i <= 121; ++i)
+        {
+            const T value = static_cast<T>(i);
+            const auto it = AoL::FindBrute(vec.begin(), vec.end(), value);
+            ASSERT_LE(it - vec.begin(), static_cast<std::ptrdiff_t>(size)) << "size " << size;
+            EXPECT_EQ(it, std::find(vec.begin(), vec.end(), value)) << "size " << size << " value " << i;
+        }
+    }
+}
+
+TEST_F(FindBruteTest, FindStaysInRangeForEveryWidth)
+{
+    ExpectFindBruteMatchesStdFind<std::int8_t>();
+    ExpectFindBruteMatchesStdFind<short>();
+    ExpectFindBruteMatchesStdFind<int>();
+    ExpectFindBruteMatchesStdFind<float>();
+    ExpectFindBruteMatchesStdFind<std::int64_t>();
+    ExpectFindBruteMatchesStdFind<double>();
+}
+
+TEST_F(FindBruteTest, FindInConstantExpression)
+{
+    constexpr std::array<int, 5> arr{ 1, 2, 3, 4, 5 };
+    static_assert(*AoL::FindBrute(arr.begin(), arr.end(), 4) == 4);
+}
+
 // ===================================================================
 // FIND LOWER BOUND GENERAL TESTS
 // ===================================================================
@@ -355,6 +454,307 @@ TEST_F(FindLowerBoundBranchlessTest, BranchlessLowerBoundCustomComparator)
     EXPECT_NE(it, vec.end());
 }
 
+// ===================================================================
+// FIND LOWER BOUND BATCH TESTS
+// ===================================================================
+
+class FindLowerBoundBatchTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(FindLowerBoundBatchTest, BatchMatchesSingleSearches)
+{
+    IntVector vec;
+    for (int i = 0; i < 1000; ++i)
+    {
+        vec.push_back(i * 2);
+    }
+
+    IntVector keys;
+    for (int i = -3; i < 2010; i += 3)
+    {
+        keys.push_back(i);
+    }
+
+    std::vector<IntVector::iterator> results;
+    AoL::FindLowerBoundBatch(vec.begin(), vec.end(), keys.begin(), keys.end(), std::back_inserter(results));
+
+    ASSERT_EQ(results.size(), keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(results[i], std::lower_bound(vec.begin(), vec.end(), keys[i])) << "key " << keys[i];
+    }
+}
+
+TEST_F(FindLowerBoundBatchTest, BatchPartialGroupAndSmallLanes)
+{
+    IntVector vec{ 1, 3, 3, 5, 7, 9, 11 };
+    IntVector keys{ 0, 3, 4, 11, 12 };
+
+    std::vector<const int*> results(keys.size());
+    auto out_end = AoL::FindLowerBoundBatch<2>(vec.data(), vec.data() + vec.size(), keys.begin(), keys.end(), results.begin());
+
+    EXPECT_EQ(out_end, results.end());
+    EXPECT_EQ(results[0], vec.data());
+    EXPECT_EQ(results[1], vec.data() + 1);
+    EXPECT_EQ(results[2], vec.data() + 3);
+    EXPECT_EQ(results[3], vec.data() + 6);
+    EXPECT_EQ(results[4], vec.data() + vec.size());
+}
+
+TEST_F(FindLowerBoundBatchTest, BatchEmptyRangeAndEmptyKeys)
+{
+    IntVector vec;
+    IntVector keys{ 1, 2, 3 };
+
+    std::vector<IntVector::iterator> results;
+    AoL::FindLowerBoundBatch(vec.begin(), vec.end(), keys.begin(), keys.end(), std::back_inserter(results));
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(results[0], vec.end());
+
+    IntVector no_keys;
+    IntVector data{ 1, 2, 3 };
+    std::vector<IntVector::iterator> no_results;
+    AoL::FindLowerBoundBatch(data.begin(), data.end(), no_keys.begin(), no_keys.end(), std::back_inserter(no_results));
+    EXPECT_TRUE(no_results.empty());
+}
+
+TEST_F(FindLowerBoundBatchTest, BatchCustomComparator)
+{
+    IntVector vec{ 100, 80, 60, 40, 20 };
+    IntVector keys{ 90, 60, 10 };
+
+    std::vector<IntVector::iterator> results;
+    AoL::FindLowerBoundBatch(vec.begin(), vec.end(), keys.begin(), keys.end(), std::back_inserter(results), std::greater<int>());
+
+    EXPECT_EQ(*results[0], 80);
+    EXPECT_EQ(*results[1], 60);
+    EXPECT_EQ(results[2], vec.end());
+}
+
+// ===================================================================
+// FIND LOWER BOUND GALLOPING TESTS
+// ===================================================================
+
+class FindLowerBoundGallopingTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(FindLowerBoundGallopingTest, ForwardMatchesStdFromEveryHint)
+{
+    IntVector vec;
+    for (int i = 0; i < 70; ++i)
+    {
+        vec.push_back(i / 3 * 2);
+    }
+
+    for (int hint = 0; hint <= static_cast<int>(vec.size()); ++hint)
+    {
+        for (int value = -1; value <= 50; ++value)
+        {
+            auto expected = std::lower_bound(vec.begin() + hint, vec.end(), value);
+            EXPECT_EQ(AoL::FindLowerBoundGalloping(vec.begin() + hint, vec.end(), value), expected) << "hint " << hint << " value " << value;
+        }
+    }
+}
+
+TEST_F(FindLowerBoundGallopingTest, BidirectionalMatchesStdFromEveryHint)
+{
+    IntVector vec;
+    for (int i = 0; i < 70; ++i)
+    {
+        vec.push_back(i / 3 * 2);
+    }
+
+    for (int hint = 0; hint <= static_cast<int>(vec.size()); ++hint)
+    {
+        for (int value = -1; value <= 50; ++value)
+        {
+            auto expected = std::lower_bound(vec.begin(), vec.end(), value);
+            EXPECT_EQ(AoL::FindLowerBoundGalloping(vec.begin(), vec.begin() + hint, vec.end(), value), expected) << "hint " << hint << " value " << value;
+        }
+    }
+}
+
+TEST_F(FindLowerBoundGallopingTest, SortedProbesWithPreviousResult)
+{
+    IntVector vec;
+    for (int i = 0; i < 10000; ++i)
+    {
+        vec.push_back(i * 3);
+    }
+
+    auto it_hint = vec.begin();
+    for (int value = 0; value < 30010; value += 11)
+    {
+        it_hint = AoL::FindLowerBoundGalloping(it_hint, vec.end(), value);
+        EXPECT_EQ(it_hint, std::lower_bound(vec.begin(), vec.end(), value));
+    }
+}
+
+TEST_F(FindLowerBoundGallopingTest, EmptyRangeAndCustomComparator)
+{
+    IntVector empty;
+    EXPECT_EQ(AoL::FindLowerBoundGalloping(empty.begin(), empty.end(), 5), empty.end());
+    EXPECT_EQ(AoL::FindLowerBoundGalloping(empty.begin(), empty.begin(), empty.end(), 5), empty.end());
+
+    IntVector vec{ 90, 70, 50, 30, 10 };
+    auto it = AoL::FindLowerBoundGalloping(vec.begin(), vec.begin() + 4, vec.end(), 60, std::greater<int>{});
+    EXPECT_EQ(*it, 50);
+}
+
+// ===================================================================
+// FIND LOWER BOUND INTERPOLATION TESTS
+// ===================================================================
+
+class FindLowerBoundInterpolationTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(FindLowerBoundInterpolationTest, UniformKeysMatchStd)
+{
+    for (int size = 0; size <= 300; size += (size < 40 ? 1 : 17))
+    {
+        IntVector vec;
+        for (int i = 0; i < size; ++i)
+        {
+            vec.push_back(i * 5 - size);
+        }
+
+        for (int value = -size - 6; value <= size * 4 + 6; ++value)
+        {
+            auto expected = std::lower_bound(vec.begin(), vec.end(), value);
+            EXPECT_EQ(AoL::FindLowerBoundInterpolation(vec.begin(), vec.end(), value), expected) << "size " << size << " value " << value;
+        }
+    }
+}
+
+TEST_F(FindLowerBoundInterpolationTest, SkewedKeysAndDuplicatesMatchStd)
+{
+    std::vector<std::int64_t> vec;
+    for (std::int64_t i = 0; i < 5000; ++i)
+    {
+        vec.push_back(i * i * i / 16);
+    }
+
+    for (std::int64_t value = -3; value < 7812500000ll; value = value * 3 / 2 + 7)
+    {
+        auto expected = std::lower_bound(vec.begin(), vec.end(), value);
+        EXPECT_EQ(AoL::FindLowerBoundInterpolation(vec.begin(), vec.end(), value), expected) << "value " << value;
+    }
+    for (std::int64_t key : vec)
+    {
+        EXPECT_EQ(AoL::FindLowerBoundInterpolation(vec.begin(), vec.end(), key), std::lower_bound(vec.begin(), vec.end(), key));
+    }
+}
+
+TEST_F(FindLowerBoundInterpolationTest, FullRangeUnsignedAndMixedValueTypes)
+{
+    std::vector<std::uint64_t> vec{ 0, 1, 2, 1ull << 32, 1ull << 62, (1ull << 63) + 5, std::numeric_limits<std::uint64_t>::max() - 1, std::numeric_limits<std::uint64_t>::max() };
+    for (std::uint64_t value : std::vector<std::uint64_t>{ 0, 3, 1ull << 40, 1ull << 63, std::numeric_limits<std::uint64_t>::max() })
+    {
+        EXPECT_EQ(AoL::FindLowerBoundInterpolation(vec.begin(), vec.end(), value), std::lower_bound(vec.begin(), vec.end(), value));
+    }
+
+    std::vector<std::uint8_t> bytes{ 0, 10, 20, 30, 255 };
+    EXPECT_EQ(AoL::FindLowerBoundInterpolation(bytes.begin(), bytes.end(), -1), bytes.begin());
+    EXPECT_EQ(AoL::FindLowerBoundInterpolation(bytes.begin(), bytes.end(), 15), bytes.begin() + 2);
+    EXPECT_EQ(AoL::FindLowerBoundInterpolation(bytes.begin(), bytes.end(), 1000), bytes.end());
+}
+
+// ===================================================================
+// FIND LOWER BOUND RANDOM TESTS
+// ===================================================================
+
+class FindLowerBoundRandomTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(FindLowerBoundRandomTest, StdRandMatchesStd)
+{
+    IntVector vec;
+    for (int i = 0; i < 100; ++i)
+    {
+        vec.push_back(i / 2 * 3);
+    }
+
+    for (int value = -1; value <= 150; ++value)
+    {
+        EXPECT_EQ(AoL::FindLowerBoundRandom(vec.begin(), vec.end(), value), std::lower_bound(vec.begin(), vec.end(), value)) << "value " << value;
+    }
+}
+
+TEST_F(FindLowerBoundRandomTest, RngAndPoolMatchStd)
+{
+    AoL::Rand::DefaultGen rng(42);
+    AoL::Rand::PoolBit64_8 pool8;
+    AoL::Rand::PoolBit64_32 pool32;
+
+    for (int size = 0; size <= 600; size += (size < 20 ? 1 : 37))
+    {
+        IntVector vec;
+        for (int i = 0; i < size; ++i)
+        {
+            vec.push_back(i / 3 * 2);
+        }
+
+        for (int value = -1; value <= size; ++value)
+        {
+            auto expected = std::lower_bound(vec.begin(), vec.end(), value);
+            EXPECT_EQ(AoL::FindLowerBoundRandom(vec.begin(), vec.end(), value, rng), expected) << "size " << size << " value " << value;
+            EXPECT_EQ(AoL::FindLowerBoundRandom(vec.begin(), vec.end(), value, rng, pool8), expected) << "size " << size << " value " << value;
+            EXPECT_EQ(AoL::FindLowerBoundRandom(vec.begin(), vec.end(), value, rng, pool32), expected) << "size " << size << " value " << value;
+        }
+    }
+}
+
+TEST_F(FindLowerBoundRandomTest, RngWithCustomComparator)
+{
+    AoL::Rand::DefaultGen rng(7);
+    AoL::Rand::PoolBit64_16 pool;
+
+    IntVector vec{ 90, 70, 50, 30, 10 };
+    EXPECT_EQ(*AoL::FindLowerBoundRandom(vec.begin(), vec.end(), 60, rng, std::greater<int>{}), 50);
+    EXPECT_EQ(*AoL::FindLowerBoundRandom(vec.begin(), vec.end(), 60, rng, pool, std::greater<int>{}), 50);
+    EXPECT_EQ(AoL::FindLowerBoundRandom(vec.begin(), vec.end(), 5, rng, pool, std::greater<int>{}), vec.end());
+}
+
 // ===================================================================
 // FIND LOWER BOUND DEFAULT TESTS
 // ===================================================================
@@ -399,6 +799,68 @@ TEST_F(FindLowerBoundDefaultTest, DefaultLowerBoundConsistency)
     EXPECT_EQ(it_default, it_eytzinger);
 }
 
+TEST_F(FindLowerBoundDefaultTest, DefaultLowerBoundMatchesStdAcrossLinearCutoff)
+{
+    const std::size_t cutoff_count = AoL::FindLowerBoundLinearCutoff() / sizeof(int);
+    for (int size = 0; size <= static_cast<int>(cutoff_count) + 40; ++size)
+    {
+        IntVector vec(size);
+        for (int i = 0; i < size; ++i)
+        {
+            vec[i] = (i / 2) * 3 - 20;
+        }
+
+        for (int value = -22; value <= size * 2; ++value)
+        {
+            EXPECT_EQ(AoL::FindLowerBound(vec.begin(), vec.end(), value), std::lower_bound(vec.begin(), vec.end(), value)) << "size " << size << " value " << value;
+        }
+    }
+}
+
+TEST_F(FindLowerBoundDefaultTest, LinearLowerBoundMatchesStd)
+{
+    std::vector<std::uint16_t> short_vec;
+    std::vector<double> double_vec;
+    for (int size = 0; size <= 70; ++size)
+    {
+        short_vec.assign(size, 0);
+        double_vec.assign(size, 0.0);
+        for (int i = 0; i < size; ++i)
+        {
+            short_vec[i] = static_cast<std::uint16_t>(i * 900);
+            double_vec[i] = i * 0.5 - 3.0;
+        }
+
+        for (int i = -1; i <= size; ++i)
+        {
+            const std::uint16_t short_value = static_cast<std::uint16_t>(i * 900 + 1);
+            const double double_value = i * 0.5 - 3.0;
+            EXPECT_EQ(AoL::FindLowerBoundLinear(short_vec.begin(), short_vec.end(), short_value), std::lower_bound(short_vec.begin(), short_vec.end(), short_value));
+            EXPECT_EQ(AoL::FindLowerBoundLinear(double_vec.begin(), double_vec.end(), double_value), std::lower_bound(double_vec.begin(), double_vec.end(), double_value));
+        }
+    }
+}
+
+TEST_F(FindLowerBoundDefaultTest, LinearLowerBoundCustomComparator)
+{
+    IntVector vec{ 9, 7, 7, 5, 3, 1 };
+
+    auto it = AoL::FindLowerBoundLinear(vec.begin(), vec.end(), 7, std::greater<int>{});
+    EXPECT_EQ(it - vec.begin(), 1);
+
+    std::list<int> list{ 1, 3, 5, 7 };
+    EXPECT_EQ(*AoL::FindLowerBoundLinear(list.begin(), list.end(), 4), 5);
+}
+
+TEST_F(FindLowerBoundDefaultTest, CalibratedCutoffIsInRange)
+{
+    const std::size_t cutoff = AoL::CalibrateFindLowerBoundLinearCutoff();
+
+    EXPECT_LE(cutoff, 1024u);
+    EXPECT_EQ(cutoff % 32, 0u);
+    EXPECT_EQ(AoL::FindLowerBoundLinearCutoff(), AoL::FindLowerBoundLinearCutoff());
+}
+
 // ===================================================================
 // EDGE CASES AND STRESS TESTS (find-related)
 // ===================================================================
@@ -440,3 +902,324 @@ TEST_F(AlgorithmEdgeCasesTest, FindWithAllIdenticalElements)
 
     EXPECT_EQ(it, vec.begin());
 }
+
+// ===================================================================
+// EYTZINGER INDEX TESTS
+// ===================================================================
+
+class EytzingerIndexTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(EytzingerIndexTest, EmptyIndex)
+{
+    IntVector vec;
+    AoL::EytzingerIndex<int> index(vec.begin(), vec.end());
+
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.lower_bound(5), 0);
+}
+
+TEST_F(EytzingerIndexTest, MatchesStdLowerBoundForAllSizes)
+{
+    for (int size = 1; size <= 70; ++size)
+    {
+        IntVector vec;
+        for (int i = 0; i < size; ++i)
+        {
+            vec.push_back(i * 2);
+        }
+
+        AoL::EytzingerIndex<int> index(vec.begin(), vec.end());
+        ASSERT_EQ(index.size(), static_cast<std::size_t>(size));
+
+        for (int value = -1; value <= size * 2 + 1; ++value)
+        {
+            auto expected = std::lower_bound(vec.begin(), vec.end(), value) - vec.begin();
+            EXPECT_EQ(index.lower_bound(value), static_cast<std::size_t>(expected)) << "size " << size << " value " << value;
+        }
+    }
+}
+
+TEST_F(EytzingerIndexTest, DuplicatesReturnFirstOccurrence)
+{
+    IntVector vec{ 1, 3, 3, 3, 5, 5, 7, 9, 9, 9, 9 };
+    AoL::EytzingerIndex<int> index(vec.begin(), vec.end());
+
+    EXPECT_EQ(index.lower_bound(3), 1);
+    EXPECT_EQ(index.lower_bound(5), 4);
+    EXPECT_EQ(index.lower_bound(9), 7);
+    EXPECT_EQ(index.lower_bound(10), vec.size());
+}
+
+TEST_F(EytzingerIndexTest, LargeRange)
+{
+    IntVector vec;
+    for (int i = 0; i < 100000; ++i)
+    {
+        vec.push_back(i * 3);
+    }
+
+    AoL::EytzingerIndex<int> index(vec.begin(), vec.end());
+    for (int value = -5; value < 300010; value += 7)
+    {
+        auto expected = std::lower_bound(vec.begin(), vec.end(), value);
+        EXPECT_EQ(AoL::FindLowerBound(index, vec.begin(), value), expected);
+    }
+}
+
+TEST_F(EytzingerIndexTest, ProjectionAndCustomComparator)
+{
+    std::vector<std::pair<int, std::string>> vec{ {50, "a"}, {40, "b"}, {30, "c"}, {20, "d"}, {10, "e"} };
+    AoL::EytzingerIndex<int, std::greater<int>> index(vec.begin(), vec.end(), &std::pair<int, std::string>::first);
+
+    auto it = AoL::FindLowerBound(index, vec.begin(), 35);
+    EXPECT_EQ(it->first, 30);
+    EXPECT_EQ(it->second, "c");
+    EXPECT_EQ(index.lower_bound(5), vec.size());
+}
+
+TEST_F(EytzingerIndexTest, Rebuild)
+{
+    IntVector first{ 1, 2, 3 };
+    IntVector second{ 10, 20, 30, 40 };
+
+    AoL::EytzingerIndex<int> index(first.begin(), first.end());
+    index.build(second.begin(), second.end());
+
+    EXPECT_EQ(index.size(), 4);
+    EXPECT_EQ(index.lower_bound(25), 2);
+
+    index.clear();
+    EXPECT_TRUE(index.empty());
+}
+
+// ============================================================================
+// STATIC B-TREE TESTS
+// ============================================================================
+class StaticBTreeTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(StaticBTreeTest, EmptyTree)
+{
+    IntVector vec;
+    AoL::StaticBTree<int> tree(vec.begin(), vec.end());
+
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.size(), 0);
+    EXPECT_EQ(tree.lower_bound(5), 0);
+}
+
+TEST_F(StaticBTreeTest, MatchesStdLowerBoundForAllSizes)
+{
+    for (int size = 1; size <= 600; size += (size < 40 ? 1 : 13))
+    {
+        IntVector vec;
+        for (int i = 0; i < size; ++i)
+        {
+            vec.push_back(i * 2 - size);
+        }
+
+        AoL::StaticBTree<int> tree(vec.begin(), vec.end());
+        ASSERT_EQ(tree.size(), static_cast<std::size_t>(size));
+
+        for (int value = -size - 1; value <= size + 1; ++value)
+        {
+            auto expected = std::lower_bound(vec.begin(), vec.end(), value) - vec.begin();
+            EXPECT_EQ(tree.lower_bound(value), static_cast<std::size_t>(expected)) << "size " << size << " value " << value;
+        }
+    }
+}
+
+TEST_F(StaticBTreeTest, DuplicatesReturnFirstOccurrence)
+{
+    IntVector vec;
+    for (int i = 0; i < 200; ++i)
+    {
+        vec.push_back(i / 7);
+    }
+
+    AoL::StaticBTree<int> tree(vec.begin(), vec.end());
+    for (int value = -1; value <= 30; ++value)
+    {
+        auto expected = std::lower_bound(vec.begin(), vec.end(), value) - vec.begin();
+        EXPECT_EQ(tree.lower_bound(value), static_cast<std::size_t>(expected)) << "value " << value;
+    }
+}
+
+TEST_F(StaticBTreeTest, UnsignedAndFloatingPointKeys)
+{
+    std::vector<unsigned int> unsigned_vec;
+    std::vector<float> float_vec;
+    std::vector<std::int64_t> int64_vec;
+    std::vector<double> double_vec;
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        unsigned_vec.push_back(i * 4000000u);
+        float_vec.push_back(static_cast<float>(i) * 0.5f - 100.0f);
+        int64_vec.push_back(static_cast<std::int64_t>(i) * 10000000000ll - 5000000000000ll);
+        double_vec.push_back(static_cast<double>(i) * 0.25 - 50.0);
+    }
+
+    AoL::StaticBTree<unsigned int> unsigned_tree(unsigned_vec.begin(), unsigned_vec.end());
+    AoL::StaticBTree<float> float_tree(float_vec.begin(), float_vec.end());
+    AoL::StaticBTree<std::int64_t> int64_tree(int64_vec.begin(), int64_vec.end());
+    AoL::StaticBTree<double> double_tree(double_vec.begin(), double_vec.end());
+    for (unsigned int i = 0; i < 1001; ++i)
+    {
+        const unsigned int unsigned_value = i * 4000000u - 1;
+        const float float_value = static_cast<float>(i) * 0.5f - 100.25f;
+        const std::int64_t int64_value = static_cast<std::int64_t>(i) * 10000000000ll - 5000000000001ll;
+        const double double_value = static_cast<double>(i) * 0.25 - 50.1;
+
+        EXPECT_EQ(AoL::FindLowerBound(unsigned_tree, unsigned_vec.begin(), unsigned_value), std::lower_bound(unsigned_vec.begin(), unsigned_vec.end(), unsigned_value));
+        EXPECT_EQ(AoL::FindLowerBound(float_tree, float_vec.begin(), float_value), std::lower_bound(float_vec.begin(), float_vec.end(), float_value));
+        EXPECT_EQ(AoL::FindLowerBound(int64_tree, int64_vec.begin(), int64_value), std::lower_bound(int64_vec.begin(), int64_vec.end(), int64_value));
+        EXPECT_EQ(AoL::FindLowerBound(double_tree, double_vec.begin(), double_value), std::lower_bound(double_vec.begin(), double_vec.end(), double_value));
+    }
+}
+
+TEST_F(StaticBTreeTest, LargeRange)
+{
+    IntVector vec;
+    for (int i = 0; i < 100000; ++i)
+    {
+        vec.push_back(i * 3);
+    }
+
+    AoL::StaticBTree<int> tree(vec.begin(), vec.end());
+    for (int value = -5; value < 300010; value += 7)
+    {
+        auto expected = std::lower_bound(vec.begin(), vec.end(), value);
+        EXPECT_EQ(AoL::FindLowerBound(tree, vec.begin(), value), expected);
+    }
+}
+
+TEST_F(StaticBTreeTest, ProjectionAndCustomComparator)
+{
+    std::vector<std::pair<int, std::string>> vec;
+    for (int i = 0; i < 40; ++i)
+    {
+        vec.emplace_back(400 - i * 10, std::to_string(i));
+    }
+
+    AoL::StaticBTree<int, std::greater<int>> tree(vec.begin(), vec.end(), &std::pair<int, std::string>::first);
+
+    auto it = AoL::FindLowerBound(tree, vec.begin(), 235);
+    EXPECT_EQ(it->first, 230);
+    EXPECT_EQ(it->second, "17");
+    EXPECT_EQ(tree.lower_bound(5), vec.size());
+    EXPECT_EQ(tree.lower_bound(1000), 0);
+}
+
+// ============================================================================
+// LEARNED INDEX TESTS
+// ============================================================================
+class LearnedIndexTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(LearnedIndexTest, EmptyIndex)
+{
+    IntVector vec;
+    AoL::LearnedIndex<int> index(vec.begin(), vec.end());
+
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.segment_count(), 0);
+    EXPECT_EQ(index.lower_bound(vec.begin(), 5), vec.end());
+}
+
+TEST_F(LearnedIndexTest, UniformKeysUseOneSegment)
+{
+    std::vector<std::uint64_t> vec;
+    for (std::uint64_t i = 0; i < 100000; ++i)
+    {
+        vec.push_back(1000 + i * 7);
+    }
+
+    AoL::LearnedIndex<std::uint64_t> index(vec);
+    EXPECT_EQ(index.size(), vec.size());
+    EXPECT_EQ(index.segment_count(), 1);
+
+    for (std::uint64_t value = 0; value < 701010; value += 3)
+    {
+        EXPECT_EQ(AoL::FindLowerBound(index, vec.begin(), value), std::lower_bound(vec.begin(), vec.end(), value)) << "value " << value;
+    }
+}
+
+TEST_F(LearnedIndexTest, SkewedKeysAndGapsMatchStd)
+{
+    std::vector<std::int64_t> vec;
+    for (std::int64_t i = 0; i < 20000; ++i)
+    {
+        // Cubic growth with a large hole in the middle and a run of duplicates at the end
+        const std::int64_t key = i * i * i / 64 - 1000000;
+        vec.push_back(i < 10000 ? key : key + 1000000000000ll);
+    }
+    vec.insert(vec.end(), 500, vec.back());
+
+    for (std::size_t error : { std::size_t{ 1 }, std::size_t{ 8 }, AoL::LearnedIndex<std::int64_t>::default_max_error })
+    {
+        AoL::LearnedIndex<std::int64_t> index(vec.begin(), vec.end(), error);
+        EXPECT_GT(index.segment_count(), 1);
+        EXPECT_EQ(index.max_error(), error);
+
+        for (std::size_t i = 0; i < vec.size(); i += 3)
+        {
+            for (std::int64_t delta : { -1, 0, 1 })
+            {
+                const std::int64_t value = vec[i] + delta;
+                EXPECT_EQ(index.lower_bound(vec.begin(), value), std::lower_bound(vec.begin(), vec.end(), value)) << "error " << error << " value " << value;
+            }
+        }
+        EXPECT_EQ(index.lower_bound(vec.begin(), 15625000000000ll), std::lower_bound(vec.begin(), vec.end(), 15625000000000ll));
+        EXPECT_EQ(index.lower_bound(vec.begin(), std::numeric_limits<std::int64_t>::min()), vec.begin());
+        EXPECT_EQ(index.lower_bound(vec.begin(), std::numeric_limits<std::int64_t>::max()), vec.end());
+    }
+}
+
+TEST_F(LearnedIndexTest, ProjectionAndOutOfRangeQueries)
+{
+    std::vector<std::pair<std::uint16_t, std::string>> vec;
+    for (int i = 0; i < 300; ++i)
+    {
+        vec.emplace_back(static_cast<std::uint16_t>(i * i / 2), std::to_string(i));
+    }
+
+    AoL::LearnedIndex<std::uint16_t, decltype(&std::pair<std::uint16_t, std::string>::first)> index(vec.begin(), vec.end(), 4, &std::pair<std::uint16_t, std::string>::first);
+
+    auto it = AoL::FindLowerBound(index, vec.begin(), 5000);
+    EXPECT_EQ(it, std::lower_bound(vec.begin(), vec.end(), 5000, [](const auto& pair, int value) { return pair.first < value; }));
+    EXPECT_EQ(it->second, "100");
+    EXPECT_EQ(index.lower_bound(vec.begin(), -7), vec.begin());
+    EXPECT_EQ(index.lower_bound(vec.begin(), 70000), vec.end());
+}
@@ -1,11 +1,25 @@
 /********************************************************************
-* Sort algorithm tests: Sort, SortReverse, with comparators, arrays
+* Sort algorithm tests: Sort, SortReverse, with comparators, arrays, SortBy, SortAdaptive, SortFixed, SortVectorized, RadixSort, RadixSortByKey, SortParallel,
+* MergeSorted, KWayMerge, TopK and their parallel versions, ExternalSort
 ********************************************************************/
 
 
 #include "pch.h"
 
 #include "aol/algorithms.h"
+#include "aol/array.h"
+#include "aol/key_ordered_map.h"
+#include "aol/threads.h"
+
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <random>
 
 
 namespace
@@ -469,3 +483,1358 @@ TEST_F(AlgorithmEdgeCasesTest, MixedPositiveNegativeZero)
     EXPECT_EQ(vec[0], -100);
     EXPECT_EQ(vec[6], 100);
 }
+
+// ===================================================================
+// SORT BY PROJECTION TESTS
+// ===================================================================
+
+class SortByTest : public ::testing::Test
+{
+protected:
+    struct Event
+    {
+        std::int32_t priority;
+        std::uint64_t timestamp;
+        float score;
+        std::int16_t shard;
+        std::string name;
+
+        std::uint64_t Timestamp() const
+        {
+            return timestamp;
+        }
+    };
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    static std::vector<Event> RandomEvents(std::size_t size, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<Event> events(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            events[i].priority = static_cast<std::int32_t>(rng() % 201) - 100;
+            events[i].timestamp = rng();
+            events[i].score = static_cast<float>(static_cast<int>(rng() % 2001) - 1000) / 8.0f;
+            events[i].shard = static_cast<std::int16_t>(static_cast<int>(rng() % 7) - 3);
+            events[i].name = std::to_string(i);
+        }
+        return events;
+    }
+
+    // The cached key path keeps equal keys in order, so it matches std::stable_sort exactly
+    template<typename Projection, typename Comparator = std::less<>>
+    static void ExpectMatchesStableSort(std::vector<Event> events, Projection projection, Comparator compare = Comparator{})
+    {
+        std::vector<Event> expected = events;
+        std::stable_sort(expected.begin(), expected.end(), [&](const Event& a, const Event& b) { return compare(std::invoke(projection, a), std::invoke(projection, b)); });
+        AoL::SortBy(events.begin(), events.end(), projection, compare);
+        ASSERT_EQ(events.size(), expected.size());
+        for (std::size_t i = 0; i < events.size(); ++i)
+        {
+            ASSERT_EQ(events[i].name, expected[i].name) << "i = " << i;
+        }
+    }
+};
+
+TEST_F(SortByTest, CachedKeysMatchStableSort)
+{
+    for (std::size_t size : { 256, 1000, 50000 })
+    {
+        const std::vector<Event> events = RandomEvents(size, size);
+        ExpectMatchesStableSort(events, &Event::priority);
+        ExpectMatchesStableSort(events, &Event::priority, std::greater<>());
+        ExpectMatchesStableSort(events, &Event::score);
+        ExpectMatchesStableSort(events, &Event::score, std::greater<>());
+        ExpectMatchesStableSort(events, &Event::shard);
+    }
+}
+
+TEST_F(SortByTest, ComparedKeysAndSmallRanges)
+{
+    // Not an arithmetic key: std::sort on the projected keys
+    std::vector<Event> events = RandomEvents(3000, 5);
+    AoL::SortBy(events.begin(), events.end(), &Event::name);
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.name < b.name; }));
+
+    // Custom comparator on an arithmetic key
+    AoL::SortBy(events.begin(), events.end(), &Event::priority, [](int a, int b) { return a % 10 < b % 10; });
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.priority % 10 < b.priority % 10; }));
+
+    // 64 bit keys: std::sort on the projected keys
+    AoL::SortBy(events.begin(), events.end(), &Event::timestamp);
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.timestamp < b.timestamp; }));
+    AoL::SortBy(events.begin(), events.end(), &Event::Timestamp, std::greater<std::uint64_t>());
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.timestamp > b.timestamp; }));
+    const auto weighted = [](const Event& event) { return static_cast<double>(event.score) * event.shard; };
+    AoL::SortBy(events.begin(), events.end(), weighted);
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [&](const Event& a, const Event& b) { return weighted(a) < weighted(b); }));
+
+    // Under the cutoff
+    std::vector<Event> small = RandomEvents(20, 6);
+    AoL::SortBy(small.begin(), small.end(), &Event::timestamp, std::greater<>());
+    EXPECT_TRUE(std::is_sorted(small.begin(), small.end(), [](const Event& a, const Event& b) { return a.timestamp > b.timestamp; }));
+
+    std::vector<Event> empty;
+    AoL::SortBy(empty.begin(), empty.end(), &Event::priority);
+    EXPECT_TRUE(empty.empty());
+
+    // Pairs and raw pointers
+    std::vector<std::pair<int, int>> pairs(1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        pairs[static_cast<std::size_t>(i)] = { (i * 37) % 100, i };
+    }
+    AoL::SortBy(pairs.data(), pairs.data() + pairs.size(), &std::pair<int, int>::first);
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+}
+
+// ===================================================================
+// ADAPTIVE SORT TESTS
+// ===================================================================
+
+class SortAdaptiveTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    static std::vector<int> RandomValues(std::size_t size, int max_value, std::mt19937_64& rng)
+    {
+        std::vector<int> values(size);
+        for (auto& value : values)
+        {
+            value = static_cast<int>(rng() % static_cast<std::uint64_t>(max_value));
+        }
+        return values;
+    }
+
+    // Presorted shapes the run detection sees, and random ones it must hand to the fallback
+    static std::vector<std::vector<int>> Shapes(std::size_t size, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<std::vector<int>> shapes;
+
+        std::vector<int> sorted = RandomValues(size, 1 << 30, rng);
+        std::sort(sorted.begin(), sorted.end());
+        shapes.push_back(sorted);
+        shapes.emplace_back(sorted.rbegin(), sorted.rend());
+
+        // A few items appended to a sorted vector
+        std::vector<int> appended = sorted;
+        const std::vector<int> tail = RandomValues(size / 100 + 3, 1 << 30, rng);
+        appended.insert(appended.end(), tail.begin(), tail.end());
+        shapes.push_back(appended);
+
+        // Concatenated sorted runs of uneven lengths, some descending
+        std::vector<int> runs = RandomValues(size, 1 << 30, rng);
+        for (std::size_t begin = 0, length = 7; begin < runs.size(); begin += length, length = length * 3 % 997 + 1)
+        {
+            const auto it_end = runs.begin() + static_cast<std::ptrdiff_t>(std::min(runs.size(), begin + length));
+            std::sort(runs.begin() + static_cast<std::ptrdiff_t>(begin), it_end);
+            if (length % 2 == 0)
+            {
+                std::reverse(runs.begin() + static_cast<std::ptrdiff_t>(begin), it_end);
+            }
+        }
+        shapes.push_back(runs);
+
+        // Sorted with a few random swaps
+        std::vector<int> swapped = sorted;
+        for (std::size_t i = 0; i < size / 50 && size > 1; ++i)
+        {
+            std::swap(swapped[rng() % size], swapped[rng() % size]);
+        }
+        shapes.push_back(swapped);
+
+        shapes.push_back(RandomValues(size, 1 << 30, rng));
+        shapes.push_back(RandomValues(size, 4, rng));
+        return shapes;
+    }
+};
+
+TEST_F(SortAdaptiveTest, PresortedAndRandomShapesMatchStdSort)
+{
+    for (std::size_t size : { 0, 1, 5, 63, 64, 100, 1000, 100000 })
+    {
+        const std::vector<std::vector<int>> shapes = Shapes(size, size + 1);
+        for (std::size_t shape = 0; shape < shapes.size(); ++shape)
+        {
+            std::vector<int> values = shapes[shape];
+            std::vector<int> expected = values;
+            std::sort(expected.begin(), expected.end());
+            AoL::SortAdaptive(values.begin(), values.end());
+            EXPECT_EQ(values, expected) << "size = " << size << ", shape = " << shape;
+
+            values = shapes[shape];
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+            AoL::SortAdaptive(values.data(), values.data() + values.size(), std::greater<>());
+            EXPECT_EQ(values, expected) << "descending, size = " << size << ", shape = " << shape;
+        }
+    }
+}
+
+TEST_F(SortAdaptiveTest, NonTrivialElementsAndKeyOrderMapBuild)
+{
+    // Sorted names with unsorted ones appended, moved through the merge buffer
+    std::vector<std::string> names;
+    for (int i = 0; i < 3000; ++i)
+    {
+        names.push_back("name_" + std::to_string(100000 + i * 7));
+    }
+    for (int i = 0; i < 40; ++i)
+    {
+        names.push_back("name_" + std::to_string(100000 + (i * 7919) % 21000));
+    }
+    std::vector<std::string> expected = names;
+    std::sort(expected.begin(), expected.end());
+    AoL::SortAdaptive(names.begin(), names.end());
+    EXPECT_EQ(names, expected);
+
+    // Equal elements by value, every one kept
+    std::vector<CustomData> data;
+    for (int i = 0; i < 500; ++i)
+    {
+        data.emplace_back(i / 3, std::to_string(i));
+    }
+    data.emplace_back(17, "appended");
+    data.emplace_back(2, "appended");
+    AoL::SortAdaptive(data.begin(), data.end());
+    EXPECT_TRUE(std::is_sorted(data.begin(), data.end()));
+    EXPECT_EQ(std::count_if(data.begin(), data.end(), [](const CustomData& item) { return item.name == "appended"; }), 2);
+
+    // build_end() on a map whose storage is mostly sorted already
+    AoL::FlatKeyOrderMap<int, int> map;
+    map.build_start();
+    for (int i = 0; i < 5000; ++i)
+    {
+        map.build_add(i * 2, i);
+    }
+    for (int i = 0; i < 50; ++i)
+    {
+        map.build_add(i * 198 + 1, -i);
+    }
+    map.build_end();
+    ASSERT_EQ(map.size(), 5050u);
+    EXPECT_TRUE(std::is_sorted(map.begin(), map.end(), [](const auto& a, const auto& b) { return a.first < b.first; }));
+    EXPECT_EQ(map[199], -1);
+    EXPECT_EQ(map[200], 100);
+}
+
+// ===================================================================
+// SORTING NETWORK TESTS
+// ===================================================================
+
+class SortFixedTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    template<typename T, std::size_t N>
+    static void ExpectMatchesStdSort(std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        for (int round = 0; round < 50; ++round)
+        {
+            std::array<T, N> values{};
+            for (auto& value : values)
+            {
+                // Small range so duplicates show up
+                value = static_cast<T>(static_cast<int>(rng() % 41) - 20) / static_cast<T>(std::is_floating_point_v<T> ? 4 : 1);
+                if constexpr (std::is_unsigned_v<T>)
+                {
+                    value = static_cast<T>(rng());
+                }
+            }
+            std::array<T, N> expected = values;
+            std::sort(expected.begin(), expected.end());
+            AoL::SortFixed(values);
+            ASSERT_EQ(values, expected) << "N = " << N;
+        }
+    }
+
+    template<typename T, std::size_t... N>
+    static void ExpectEverySizeMatchesStdSort(std::index_sequence<N...>)
+    {
+        (ExpectMatchesStdSort<T, N + 1>(N), ...);
+    }
+
+    // Equivalent but distinct elements (x and -x under an abs compare, 0.0f and -0.0f) must all survive the network
+    template<std::size_t N>
+    static void ExpectKeepsEquivalentElements(std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        const auto abs_less = [](int a, int b) { return std::abs(a) < std::abs(b); };
+        for (int round = 0; round < 20; ++round)
+        {
+            std::array<int, N> ints{};
+            std::array<float, N> zeros{};
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                ints[i] = static_cast<int>(rng() % 7) - 3;
+                zeros[i] = (rng() & 1) != 0 ? -0.0f : static_cast<float>(rng() % 3);
+            }
+
+            std::array<int, N> sorted_ints = ints;
+            AoL::SortFixed(sorted_ints, abs_less);
+            ASSERT_TRUE(std::is_sorted(sorted_ints.begin(), sorted_ints.end(), abs_less)) << "N = " << N;
+            ASSERT_TRUE(std::is_permutation(sorted_ints.begin(), sorted_ints.end(), ints.begin())) << "N = " << N;
+
+            std::array<float, N> sorted_zeros = zeros;
+            AoL::SortFixed(sorted_zeros);
+            ASSERT_TRUE(std::is_sorted(sorted_zeros.begin(), sorted_zeros.end())) << "N = " << N;
+            ASSERT_EQ(FloatBits(sorted_zeros), FloatBits(zeros)) << "N = " << N;
+        }
+    }
+
+    template<std::size_t... N>
+    static void ExpectEverySizeKeepsEquivalentElements(std::index_sequence<N...>)
+    {
+        (ExpectKeepsEquivalentElements<N + 1>(N), ...);
+    }
+
+    // Sorted bit patterns, equal for two float ranges holding the same values with the same signs
+    template<typename Range>
+    static std::vector<std::uint32_t> FloatBits(const Range& values)
+    {
+        std::vector<std::uint32_t> bits;
+        for (float value : values)
+        {
+            bits.push_back(std::bit_cast<std::uint32_t>(value));
+        }
+        std::sort(bits.begin(), bits.end());
+        return bits;
+    }
+
+    // 0-1 principle: a network that sorts every sequence of 0s and 1s sorts everything
+    template<std::size_t N>
+    static void ExpectSortsEveryBinarySequence()
+    {
+        for (std::uint32_t bits = 0; bits < (1u << N); ++bits)
+        {
+            std::array<int, N> values{};
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                values[i] = (bits >> i) & 1;
+            }
+            AoL::SortFixed(values);
+            ASSERT_TRUE(std::is_sorted(values.begin(), values.end())) << "N = " << N << ", bits = " << bits;
+        }
+    }
+};
+
+TEST_F(SortFixedTest, EverySizeMatchesStdSort)
+{
+    ExpectEverySizeMatchesStdSort<int>(std::make_index_sequence<32>{});
+    ExpectEverySizeMatchesStdSort<unsigned int>(std::make_index_sequence<32>{});
+    ExpectEverySizeMatchesStdSort<float>(std::make_index_sequence<32>{});
+    ExpectEverySizeMatchesStdSort<double>(std::make_index_sequence<32>{});
+    ExpectEverySizeMatchesStdSort<std::int64_t>(std::make_index_sequence<32>{});
+    ExpectEverySizeMatchesStdSort<std::int16_t>(std::make_index_sequence<32>{});
+}
+
+TEST_F(SortFixedTest, SortsEveryBinarySequence)
+{
+    ExpectSortsEveryBinarySequence<4>();
+    ExpectSortsEveryBinarySequence<5>();
+    ExpectSortsEveryBinarySequence<8>();
+    ExpectSortsEveryBinarySequence<13>();
+    ExpectSortsEveryBinarySequence<16>();
+}
+
+TEST_F(SortFixedTest, KeepsEquivalentElements)
+{
+    int abs_values[3] = { -1, 1, 2 };
+    AoL::SortFixed(abs_values, [](int a, int b) { return std::abs(a) < std::abs(b); });
+    EXPECT_EQ(abs_values[0] + abs_values[1], 0);
+    EXPECT_EQ(abs_values[2], 2);
+
+    std::array<float, 2> zeros{ 0.0f, -0.0f };
+    AoL::SortFixed(zeros);
+    EXPECT_NE(std::signbit(zeros[0]), std::signbit(zeros[1]));
+
+    ExpectEverySizeKeepsEquivalentElements(std::make_index_sequence<32>{});
+}
+
+TEST_F(SortFixedTest, ExtremeValuesAroundThePadding)
+{
+    // Ranges shorter than a vector are padded with the largest value
+    std::array<int, 5> ints{ std::numeric_limits<int>::max(), 3, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), -1 };
+    AoL::SortFixed(ints);
+    EXPECT_EQ(ints, (std::array<int, 5>{ std::numeric_limits<int>::min(), -1, 3, std::numeric_limits<int>::max(), std::numeric_limits<int>::max() }));
+
+    std::array<unsigned int, 6> uints{ 0xFFFFFFFFu, 0u, 0x80000000u, 7u, 0x7FFFFFFFu, 0xFFFFFFFFu };
+    AoL::SortFixed(uints);
+    EXPECT_TRUE(std::is_sorted(uints.begin(), uints.end()));
+    EXPECT_EQ(uints[0], 0u);
+    EXPECT_EQ(uints[5], 0xFFFFFFFFu);
+
+    const float inf = std::numeric_limits<float>::infinity();
+    std::array<float, 7> floats{ inf, -0.5f, -inf, 2.0f, inf, 0.0f, -2.0f };
+    AoL::SortFixed(floats);
+    EXPECT_EQ(floats, (std::array<float, 7>{ -inf, -2.0f, -0.5f, 0.0f, 2.0f, inf, inf }));
+}
+
+TEST_F(SortFixedTest, ArraysComparatorsAndPartialSizes)
+{
+    AoL::ArrayNamed4<float> named{ 4.0f, -1.0f, 3.0f, 0.5f };
+    AoL::SortFixed(named);
+    EXPECT_FLOAT_EQ(named.x, -1.0f);
+    EXPECT_FLOAT_EQ(named.y, 0.5f);
+    EXPECT_FLOAT_EQ(named.z, 3.0f);
+    EXPECT_FLOAT_EQ(named.w, 4.0f);
+
+    AoL::ArrayNamed3<int> named3{ 3, 1, 2 };
+    AoL::SortFixed(named3, std::greater<>());
+    EXPECT_EQ(named3.x, 3);
+    EXPECT_EQ(named3.y, 2);
+    EXPECT_EQ(named3.z, 1);
+
+    // Only the first N elements are sorted
+    AoL::Array<int, 6> arr{ 9, 4, 7, 1, 0, -5 };
+    AoL::SortFixed<4>(arr);
+    EXPECT_EQ(arr, (AoL::Array<int, 6>{ 1, 4, 7, 9, 0, -5 }));
+
+    int raw[] = { 5, 2, 8, 1, 9, 3 };
+    AoL::SortFixed<6>(raw + 0);
+    EXPECT_TRUE(std::is_sorted(std::begin(raw), std::end(raw)));
+
+    std::array<std::string, 5> names{ "delta", "alpha", "echo", "charlie", "bravo" };
+    AoL::SortFixed(names);
+    EXPECT_EQ(names, (std::array<std::string, 5>{ "alpha", "bravo", "charlie", "delta", "echo" }));
+
+    std::array<CustomData, 4> custom{ CustomData(3, "c"), CustomData(1, "a"), CustomData(4, "d"), CustomData(2, "b") };
+    AoL::SortFixed(custom, [](const CustomData& a, const CustomData& b) { return a.value > b.value; });
+    EXPECT_EQ(custom[0].name, "d");
+    EXPECT_EQ(custom[3].name, "a");
+}
+
+TEST_F(SortFixedTest, SortDispatchesOnFixedSizes)
+{
+    AoL::ArrayNamed4<int> named{ 2, 4, 1, 3 };
+    AoL::Sort(named.begin(), named.end());
+    EXPECT_EQ(named.x, 1);
+    EXPECT_EQ(named.w, 4);
+
+    AoL::Sort(named.begin(), named.end(), std::greater<int>());
+    EXPECT_EQ(named.x, 4);
+    EXPECT_EQ(named.w, 1);
+
+    // A subrange of the ArrayNamed falls back to std::sort
+    AoL::Sort(named.begin() + 1, named.end());
+    EXPECT_EQ(named.x, 4);
+    EXPECT_EQ(named.y, 1);
+    EXPECT_EQ(named.w, 3);
+
+    AoL::Array<double, 8> arr{ 0.5, -3.0, 2.5, 1.0, -0.25, 8.0, 0.0, -1.0 };
+    AoL::Sort(arr);
+    EXPECT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+
+    int raw[] = { 5, 2, 8, 1, 9 };
+    AoL::Sort(raw, std::greater<int>());
+    EXPECT_TRUE(std::is_sorted(std::begin(raw), std::end(raw), std::greater<int>()));
+
+    // Larger than a network, the range Sort
+    AoL::Array<int, 100> large{};
+    for (int i = 0; i < 100; ++i)
+    {
+        large[i] = (i * 37) % 100;
+    }
+    AoL::Sort(large);
+    EXPECT_TRUE(std::is_sorted(large.begin(), large.end()));
+}
+
+TEST_F(SortFixedTest, SortsAtCompileTime)
+{
+    constexpr auto sorted = []()
+    {
+        std::array<int, 6> values{ 6, -2, 9, 0, 3, 3 };
+        AoL::SortFixed(values);
+        return values;
+    }();
+    static_assert(sorted == std::array<int, 6>{ -2, 0, 3, 3, 6, 9 });
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+}
+
+// ===================================================================
+// VECTORIZED SORT TESTS
+// ===================================================================
+
+class SortVectorizedTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    // Random, few distinct, sorted, reversed and mostly equal values around the partition and network sizes
+    template<typename T>
+    static std::vector<std::vector<T>> MakeInputs(std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<std::vector<T>> inputs;
+        for (std::size_t count : { 0, 1, 5, 31, 32, 33, 63, 64, 65, 129, 1000, 4097, 50000 })
+        {
+            for (int pattern = 0; pattern < 5; ++pattern)
+            {
+                std::vector<T> values(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    switch (pattern)
+                    {
+                    case 0:
+                        values[i] = std::is_floating_point_v<T> ? static_cast<T>(static_cast<std::int64_t>(rng())) / static_cast<T>(1e6) : static_cast<T>(rng());
+                        break;
+                    case 1: values[i] = static_cast<T>(rng() % 3); break;
+                    case 2: values[i] = static_cast<T>(i); break;
+                    case 3: values[i] = static_cast<T>(count - i); break;
+                    default: values[i] = rng() % 10 == 0 ? static_cast<T>(rng() % 1000) : static_cast<T>(7); break;
+                    }
+                }
+                inputs.push_back(std::move(values));
+            }
+        }
+        return inputs;
+    }
+
+    template<typename T, typename Kernel>
+    static void ExpectKernelMatchesStdSort(Kernel kernel)
+    {
+        for (std::vector<T>& values : MakeInputs<T>(sizeof(T)))
+        {
+            std::vector<T> expected = values;
+            std::sort(expected.begin(), expected.end());
+            kernel(values.data(), values.data() + values.size());
+            ASSERT_EQ(values, expected) << "size = " << values.size();
+        }
+    }
+
+    template<typename T>
+    static void ExpectSortVectorizedMatchesStdSort()
+    {
+        for (std::vector<T>& values : MakeInputs<T>(sizeof(T) + 1))
+        {
+            std::vector<T> descending = values;
+            std::vector<T> expected = values;
+            std::sort(expected.begin(), expected.end());
+            AoL::SortVectorized(values.begin(), values.end());
+            ASSERT_EQ(values, expected) << "size = " << values.size();
+
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+            AoL::SortVectorized(descending.begin(), descending.end(), std::greater<T>());
+            ASSERT_EQ(descending, expected) << "size = " << descending.size();
+        }
+    }
+};
+
+TEST_F(SortVectorizedTest, KernelsMatchStdSort)
+{
+#if AOL_SIMD_X86
+    if (AoL::Internal::Simd::RuntimeIsa() >= AoL::Internal::Simd::Isa::Avx2)
+    {
+        ExpectKernelMatchesStdSort<int>(AoL::Internal::VectorSortAvx2Kernel<int>);
+        ExpectKernelMatchesStdSort<unsigned int>(AoL::Internal::VectorSortAvx2Kernel<unsigned int>);
+        ExpectKernelMatchesStdSort<std::int64_t>(AoL::Internal::VectorSortAvx2Kernel<std::int64_t>);
+        ExpectKernelMatchesStdSort<float>(AoL::Internal::VectorSortAvx2Kernel<float>);
+        ExpectKernelMatchesStdSort<double>(AoL::Internal::VectorSortAvx2Kernel<double>);
+    }
+    if (AoL::Internal::Simd::RuntimeIsa() >= AoL::Internal::Simd::Isa::Avx512)
+    {
+        ExpectKernelMatchesStdSort<int>(AoL::Internal::VectorSortAvx512Kernel<int>);
+        ExpectKernelMatchesStdSort<unsigned int>(AoL::Internal::VectorSortAvx512Kernel<unsigned int>);
+        ExpectKernelMatchesStdSort<std::int64_t>(AoL::Internal::VectorSortAvx512Kernel<std::int64_t>);
+        ExpectKernelMatchesStdSort<float>(AoL::Internal::VectorSortAvx512Kernel<float>);
+        ExpectKernelMatchesStdSort<double>(AoL::Internal::VectorSortAvx512Kernel<double>);
+    }
+#endif
+}
+
+TEST_F(SortVectorizedTest, MatchesStdSortInBothOrders)
+{
+    ExpectSortVectorizedMatchesStdSort<int>();
+    ExpectSortVectorizedMatchesStdSort<unsigned int>();
+    ExpectSortVectorizedMatchesStdSort<std::int64_t>();
+    ExpectSortVectorizedMatchesStdSort<float>();
+    ExpectSortVectorizedMatchesStdSort<double>();
+}
+
+TEST_F(SortVectorizedTest, ExtremeValues)
+{
+    std::vector<int> ints(100);
+    for (std::size_t i = 0; i < ints.size(); ++i)
+    {
+        ints[i] = i % 3 == 0 ? std::numeric_limits<int>::min() : (i % 3 == 1 ? std::numeric_limits<int>::max() : static_cast<int>(i) - 50);
+    }
+    AoL::SortVectorized(ints.begin(), ints.end());
+    EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+
+    std::vector<unsigned int> uints(100);
+    for (std::size_t i = 0; i < uints.size(); ++i)
+    {
+        uints[i] = i % 2 == 0 ? 0xFFFFFFFFu - static_cast<unsigned int>(i) : static_cast<unsigned int>(i) << 24;
+    }
+    AoL::SortVectorized(uints.begin(), uints.end());
+    EXPECT_TRUE(std::is_sorted(uints.begin(), uints.end()));
+
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> doubles(100);
+    for (std::size_t i = 0; i < doubles.size(); ++i)
+    {
+        doubles[i] = i % 4 == 0 ? inf : (i % 4 == 1 ? -inf : (i % 4 == 2 ? -0.0 : static_cast<double>(i)));
+    }
+    AoL::SortVectorized(doubles.begin(), doubles.end());
+    EXPECT_TRUE(std::is_sorted(doubles.begin(), doubles.end()));
+    EXPECT_EQ(doubles.front(), -inf);
+    EXPECT_EQ(doubles.back(), inf);
+}
+
+TEST_F(SortVectorizedTest, SignedZerosArePermuted)
+{
+    // 0.0 and -0.0 compare equal: the output must still hold each of them, bit for bit
+    const auto expect_permuted = [](auto values)
+    {
+        using T = typename decltype(values)::value_type;
+        using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+        const auto sorted_bits = [](const std::vector<T>& range)
+        {
+            std::vector<Bits> bits;
+            for (T value : range)
+            {
+                bits.push_back(std::bit_cast<Bits>(value));
+            }
+            std::sort(bits.begin(), bits.end());
+            return bits;
+        };
+
+        const std::vector<T> input = values;
+        AoL::Sort(values.begin(), values.end());
+        ASSERT_TRUE(std::is_sorted(values.begin(), values.end())) << "size = " << values.size();
+        ASSERT_EQ(sorted_bits(values), sorted_bits(input)) << "size = " << values.size();
+    };
+
+    std::vector<float> one_each(20, 1.0f);
+    one_each[3] = 0.0f;
+    one_each[11] = -0.0f;
+    expect_permuted(one_each);
+
+    std::mt19937_64 rng{ 14 };
+    for (std::size_t count : { 2, 9, 17, 20, 32, 33, 100, 5000 })
+    {
+        std::vector<float> floats(count);
+        std::vector<double> doubles(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const int roll = static_cast<int>(rng() % 4);
+            floats[i] = roll == 0 ? -0.0f : (roll == 1 ? 0.0f : static_cast<float>(static_cast<int>(rng() % 5) - 2));
+            doubles[i] = static_cast<double>(floats[i]);
+        }
+        expect_permuted(floats);
+        expect_permuted(doubles);
+    }
+}
+
+TEST_F(SortVectorizedTest, NaNsGoToTheEnd)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> values(200);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = i % 7 == 0 ? nan : static_cast<float>((i * 37) % 200) - 100.0f;
+    }
+    const auto numbers = std::count_if(values.begin(), values.end(), [](float value) { return value == value; });
+
+    std::vector<float> descending = values;
+    AoL::SortVectorized(values.begin(), values.end());
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.begin() + numbers));
+    EXPECT_TRUE(std::all_of(values.begin() + numbers, values.end(), [](float value) { return value != value; }));
+
+    AoL::SortVectorized(descending.begin(), descending.end(), std::greater<>());
+    EXPECT_TRUE(std::is_sorted(descending.begin(), descending.begin() + numbers, std::greater<>()));
+    EXPECT_TRUE(std::all_of(descending.begin() + numbers, descending.end(), [](float value) { return value != value; }));
+}
+
+TEST_F(SortVectorizedTest, SortDispatchesOnPrimitiveRanges)
+{
+    std::mt19937_64 rng{ 42 };
+    std::vector<float> values(10000);
+    for (auto& value : values)
+    {
+        value = static_cast<float>(static_cast<int>(rng() % 20001) - 10000) / 8.0f;
+    }
+
+    std::vector<float> expected = values;
+    std::sort(expected.begin(), expected.end());
+    AoL::Sort(values.begin(), values.end());
+    EXPECT_EQ(values, expected);
+
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    AoL::Sort(values.begin(), values.end(), std::greater<float>());
+    EXPECT_EQ(values, expected);
+
+    std::sort(expected.begin(), expected.end());
+    AoL::SortReverse(values.begin(), values.end(), std::greater<>());
+    EXPECT_EQ(values, expected);
+
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    AoL::SortReverse(values.begin(), values.end());
+    EXPECT_EQ(values, expected);
+
+    // Raw pointers are contiguous too
+    std::int64_t raw[] = { 5, -2, 8, 1, -9, 3, 0, 7, 4, -6, 2, 11, -1, 6, 10, -3, 9, 12, -4, 13, 14, -5, 15, 16, -7, 17, 18, -8, 19, 20, -10, 21, 22 };
+    AoL::Sort(raw + 0, raw + std::size(raw));
+    EXPECT_TRUE(std::is_sorted(std::begin(raw), std::end(raw)));
+
+    // Custom comparators keep std::sort
+    std::vector<int> ints{ 5, 2, 8, 1, 9, 3 };
+    AoL::Sort(ints.begin(), ints.end(), [](int a, int b) { return a % 5 < b % 5; });
+    EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end(), [](int a, int b) { return a % 5 < b % 5; }));
+}
+
+// ===================================================================
+// RADIX SORT TESTS
+// ===================================================================
+
+class RadixSortTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    template<typename T>
+    static std::vector<T> RandomValues(std::size_t size, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<T> values(size);
+        for (auto& value : values)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                value = std::uniform_real_distribution<T>{ static_cast<T>(-1000), static_cast<T>(1000) }(rng);
+            }
+            else
+            {
+                value = static_cast<T>(rng());
+            }
+        }
+        return values;
+    }
+
+    template<typename T>
+    static void ExpectMatchesStdSort(std::vector<T> values)
+    {
+        std::vector<T> expected = values;
+        std::sort(expected.begin(), expected.end());
+        AoL::RadixSort(values.begin(), values.end());
+        EXPECT_EQ(values, expected);
+    }
+};
+
+TEST_F(RadixSortTest, IntegralTypesMatchStdSort)
+{
+    for (std::size_t size : { 0, 1, 2, 63, 64, 65, 1000, 20000 })
+    {
+        ExpectMatchesStdSort(RandomValues<std::uint8_t>(size, size));
+        ExpectMatchesStdSort(RandomValues<std::int8_t>(size, size));
+        ExpectMatchesStdSort(RandomValues<std::uint16_t>(size, size));
+        ExpectMatchesStdSort(RandomValues<std::int16_t>(size, size));
+        ExpectMatchesStdSort(RandomValues<std::uint32_t>(size, size));
+        ExpectMatchesStdSort(RandomValues<std::int32_t>(size, size));
+        ExpectMatchesStdSort(RandomValues<std::uint64_t>(size, size));
+        ExpectMatchesStdSort(RandomValues<std::int64_t>(size, size));
+    }
+}
+
+TEST_F(RadixSortTest, FloatingPointMatchesStdSort)
+{
+    for (std::size_t size : { 10, 500, 20000 })
+    {
+        ExpectMatchesStdSort(RandomValues<float>(size, size));
+        ExpectMatchesStdSort(RandomValues<double>(size, size));
+    }
+
+    std::vector<double> specials{ 0.0, -1.5, std::numeric_limits<double>::infinity(), 3.25, -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::max(), 1e300, -1e-300 };
+    for (int i = 0; i < 100; ++i)
+    {
+        specials.push_back(static_cast<double>(i % 7) - 3.0);
+    }
+    ExpectMatchesStdSort(specials);
+}
+
+TEST_F(RadixSortTest, SmallKeysAndReusedScratch)
+{
+    // Only the low byte differs, every other pass is skipped
+    std::vector<std::uint64_t> values;
+    for (int i = 0; i < 5000; ++i)
+    {
+        values.push_back(static_cast<std::uint64_t>((i * 37) % 256));
+    }
+
+    std::vector<std::uint64_t> scratch;
+    std::vector<std::uint64_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+    AoL::RadixSort(values.begin(), values.end(), scratch);
+    EXPECT_EQ(values, expected);
+    EXPECT_GE(scratch.size(), values.size());
+
+    IntVector negatives{ -5, -1, -3, -2, -4 };
+    std::vector<int> int_scratch;
+    AoL::RadixSort(negatives.data(), negatives.data() + negatives.size(), int_scratch);
+    EXPECT_EQ(negatives, (IntVector{ -5, -4, -3, -2, -1 }));
+}
+
+TEST_F(RadixSortTest, SortByKeyIsStable)
+{
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 3000; ++i)
+    {
+        pairs.emplace_back((i * 7919) % 101 - 50, i);
+    }
+
+    std::vector<std::pair<int, int>> expected = pairs;
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    AoL::RadixSortByKey(pairs.begin(), pairs.end());
+    EXPECT_EQ(pairs, expected);
+
+    std::vector<std::pair<std::string, double>> by_second{ { "c", 2.5 }, { "a", -1.0 }, { "b", 0.0 } };
+    AoL::RadixSortByKey(by_second.begin(), by_second.end(), &std::pair<std::string, double>::second);
+    EXPECT_EQ(by_second[0].first, "a");
+    EXPECT_EQ(by_second[2].first, "c");
+}
+
+TEST_F(RadixSortTest, KeyValuePairsAndMapBuild)
+{
+    using Pair = AoL::Internal::KeyValuePairEx<std::int64_t, std::string>;
+    std::vector<Pair> pairs;
+    for (std::int64_t i = 0; i < 1000; ++i)
+    {
+        const std::int64_t key = (i * 7919) % 1000 - 500;
+        pairs.push_back(Pair{ key, std::to_string(key) });
+    }
+
+    std::vector<Pair> scratch;
+    AoL::RadixSortByKey(pairs.begin(), pairs.end(), scratch);
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+    {
+        EXPECT_EQ(pairs[i].first, static_cast<std::int64_t>(i) - 500);
+        EXPECT_EQ(pairs[i].second, std::to_string(pairs[i].first));
+    }
+
+    AoL::FlatKeyOrderMap<std::int64_t, std::string> map;
+    map.build_start();
+    for (std::int64_t i = 999; i >= 0; --i)
+    {
+        map.build_add(i * 3 - 1000, std::to_string(i));
+    }
+    map.build_end();
+    EXPECT_TRUE(std::is_sorted(map.begin(), map.end()));
+    EXPECT_EQ(map.begin()->first, -1000);
+    EXPECT_EQ(map[-1000 + 3 * 500], "500");
+}
+
+// ===================================================================
+// PARALLEL SORT TESTS
+// ===================================================================
+
+class SortParallelTest : public ::testing::Test
+{
+protected:
+    using IntVector = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    static IntVector RandomInts(std::size_t size, int max_value, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::uniform_int_distribution<int> dist{ -max_value, max_value };
+        IntVector values(size);
+        for (auto& value : values)
+        {
+            value = dist(rng);
+        }
+        return values;
+    }
+};
+
+TEST_F(SortParallelTest, TaskGroupRunsNestedTasks)
+{
+    AoL::ThreadPool pool(3);
+    std::atomic<int> count{ 0 };
+    {
+        AoL::TaskGroup group(pool);
+        for (int i = 0; i < 16; ++i)
+        {
+            group.run([&]()
+            {
+                AoL::TaskGroup inner(pool);
+                for (int j = 0; j < 16; ++j)
+                {
+                    inner.run([&]() { count.fetch_add(1); });
+                }
+                inner.wait();
+            });
+        }
+        group.wait();
+    }
+    EXPECT_EQ(count.load(), 256);
+
+    // No worker, the waiting thread runs everything
+    AoL::ThreadPool inline_pool(0);
+    AoL::TaskGroup group(inline_pool);
+    group.run([&]() { count.fetch_add(1); });
+    group.wait();
+    EXPECT_EQ(count.load(), 257);
+}
+
+TEST_F(SortParallelTest, MatchesStdSortOnEveryPoolSize)
+{
+    const IntVector source = RandomInts(300000, 1 << 30, 7);
+    IntVector expected = source;
+    std::sort(expected.begin(), expected.end());
+
+    for (std::size_t worker_count : { 0, 1, 3, 7 })
+    {
+        AoL::ThreadPool pool(worker_count);
+        IntVector values = source;
+        AoL::SortParallel(pool, values.begin(), values.end());
+        EXPECT_EQ(values, expected);
+    }
+}
+
+TEST_F(SortParallelTest, DuplicatesComparatorsAndSmallRanges)
+{
+    AoL::ThreadPool pool(3);
+
+    // Few distinct values, some buckets get much more than their share
+    IntVector values = RandomInts(200000, 3, 11);
+    IntVector expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<>{});
+    AoL::SortParallel(pool, values.begin(), values.end(), std::greater<>{});
+    EXPECT_EQ(values, expected);
+
+    // Every value equal
+    IntVector equal(100000, 5);
+    AoL::SortParallel(pool, equal.begin(), equal.end());
+    EXPECT_TRUE(std::all_of(equal.begin(), equal.end(), [](int value) { return value == 5; }));
+
+    IntVector small = { 3, 1, 2 };
+    AoL::SortParallel(pool, small.begin(), small.end());
+    EXPECT_EQ(small, (IntVector{ 1, 2, 3 }));
+
+    IntVector empty;
+    AoL::SortParallel(pool, empty.begin(), empty.end());
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST_F(SortParallelTest, NonTrivialElementsAndParallelPolicy)
+{
+    std::vector<std::string> strings(100000);
+    std::mt19937_64 rng{ 5 };
+    for (auto& string : strings)
+    {
+        string = std::to_string(rng() % 1000000);
+    }
+    std::vector<std::string> expected = strings;
+    std::sort(expected.begin(), expected.end());
+
+    AoL::ThreadPool pool(3);
+    AoL::SortParallel(pool, strings.begin(), strings.end());
+    EXPECT_EQ(strings, expected);
+
+    IntVector values = RandomInts(100000, 1000000, 3);
+    IntVector reversed = values;
+    std::sort(values.begin(), values.end());
+    AoL::SortReverse(std::execution::par, reversed.begin(), reversed.end());
+    EXPECT_TRUE(std::equal(values.rbegin(), values.rend(), reversed.begin()));
+}
+
+// ===================================================================
+// MERGE TESTS
+// ===================================================================
+
+class MergeSortedTest : public ::testing::Test
+{
+protected:
+    // Key and the run it came from, ordered by key only so stability shows
+    using Tagged = std::pair<int, int>;
+
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    static bool KeyLess(const Tagged& a, const Tagged& b)
+    {
+        return a.first < b.first;
+    }
+
+    static std::vector<std::vector<Tagged>> SortedRuns(std::size_t run_count, std::size_t max_size, int max_value, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<std::vector<Tagged>> runs(run_count);
+        for (std::size_t run = 0; run < run_count; ++run)
+        {
+            runs[run].resize(rng() % (max_size + 1));
+            for (std::size_t i = 0; i < runs[run].size(); ++i)
+            {
+                runs[run][i] = { static_cast<int>(rng() % static_cast<std::uint64_t>(max_value)), static_cast<int>(run * max_size + i) };
+            }
+            std::stable_sort(runs[run].begin(), runs[run].end(), KeyLess);
+        }
+        return runs;
+    }
+
+    // The stable merge of runs is the stable sort of their concatenation
+    static std::vector<Tagged> ExpectedMerge(const std::vector<std::vector<Tagged>>& runs)
+    {
+        std::vector<Tagged> expected;
+        for (const auto& run : runs)
+        {
+            expected.insert(expected.end(), run.begin(), run.end());
+        }
+        std::stable_sort(expected.begin(), expected.end(), KeyLess);
+        return expected;
+    }
+};
+
+TEST_F(MergeSortedTest, MergeSortedIsStable)
+{
+    const auto runs = SortedRuns(2, 1000, 50, 1);
+    std::vector<Tagged> merged(runs[0].size() + runs[1].size());
+    const auto it_end = AoL::MergeSorted(runs[0].begin(), runs[0].end(), runs[1].begin(), runs[1].end(), merged.begin(), KeyLess);
+    EXPECT_EQ(it_end, merged.end());
+    EXPECT_EQ(merged, ExpectedMerge(runs));
+
+    std::vector<int> a{ 1, 3, 5 };
+    std::vector<int> empty;
+    std::vector<int> out(3);
+    AoL::MergeSorted(empty.begin(), empty.end(), a.begin(), a.end(), out.begin());
+    EXPECT_EQ(out, a);
+
+    std::vector<int> descending_a{ 9, 4, 1 };
+    std::vector<int> descending_b{ 8, 4, 2, 0 };
+    std::vector<int> descending(7);
+    AoL::MergeSorted(descending_a.begin(), descending_a.end(), descending_b.begin(), descending_b.end(), descending.begin(), std::greater<>());
+    EXPECT_EQ(descending, (std::vector<int>{ 9, 8, 4, 4, 2, 1, 0 }));
+}
+
+TEST_F(MergeSortedTest, MergeSortedParallelMatchesOnEveryPoolSize)
+{
+    for (std::size_t worker_count : { 0, 1, 3, 7 })
+    {
+        AoL::ThreadPool pool(worker_count);
+        for (int max_value : { 4, 1 << 20 })
+        {
+            auto runs = SortedRuns(2, 200000, max_value, worker_count + 3);
+            const std::vector<Tagged> expected = ExpectedMerge(runs);
+            std::vector<Tagged> merged(expected.size());
+            const auto it_end = AoL::MergeSortedParallel(pool, runs[0].begin(), runs[0].end(), runs[1].begin(), runs[1].end(), merged.begin(), KeyLess);
+            EXPECT_EQ(it_end, merged.end());
+            EXPECT_EQ(merged, expected);
+
+            // Uneven sides, one of them empty
+            runs[1].clear();
+            std::vector<Tagged> copied(runs[0].size());
+            AoL::MergeSortedParallel(pool, runs[0].begin(), runs[0].end(), runs[1].begin(), runs[1].end(), copied.begin(), KeyLess);
+            EXPECT_EQ(copied, runs[0]);
+        }
+    }
+}
+
+TEST_F(MergeSortedTest, KWayMergeIsStableForAnyRunCount)
+{
+    for (std::size_t run_count : { 0, 1, 2, 3, 5, 8, 17 })
+    {
+        const auto runs = SortedRuns(run_count, 300, 40, run_count);
+        const std::vector<Tagged> expected = ExpectedMerge(runs);
+        std::vector<Tagged> merged(expected.size());
+        const auto it_end = AoL::KWayMerge(runs, merged.begin(), KeyLess);
+        EXPECT_EQ(it_end, merged.end());
+        EXPECT_EQ(merged, expected) << "runs = " << run_count;
+    }
+
+    // Output iterators and AoL::Vector shards work too
+    AoL::Vector<AoL::Vector<int>> shards{ { 1, 4, 9 }, { }, { 2, 3, 10 }, { 0 } };
+    std::vector<int> merged;
+    AoL::KWayMerge(shards, std::back_inserter(merged));
+    EXPECT_EQ(merged, (std::vector<int>{ 0, 1, 2, 3, 4, 9, 10 }));
+}
+
+TEST_F(MergeSortedTest, KWayMergeParallelMatchesOnEveryPoolSize)
+{
+    for (std::size_t worker_count : { 0, 1, 3, 7 })
+    {
+        AoL::ThreadPool pool(worker_count);
+        for (int max_value : { 3, 1 << 20 })
+        {
+            const auto runs = SortedRuns(6, 40000, max_value, worker_count);
+            const std::vector<Tagged> expected = ExpectedMerge(runs);
+            std::vector<Tagged> merged(expected.size());
+            const auto it_end = AoL::KWayMergeParallel(pool, runs, merged.begin(), KeyLess);
+            EXPECT_EQ(it_end, merged.end());
+            EXPECT_EQ(merged, expected);
+        }
+    }
+
+    // Many runs smaller than a sample each
+    AoL::ThreadPool pool(3);
+    const auto tiny_runs = SortedRuns(40000, 2, 1000, 9);
+    const std::vector<Tagged> expected = ExpectedMerge(tiny_runs);
+    std::vector<Tagged> merged(expected.size());
+    AoL::KWayMergeParallel(pool, tiny_runs, merged.begin(), KeyLess);
+    EXPECT_EQ(merged, expected);
+}
+
+// ===================================================================
+// TOP K TESTS
+// ===================================================================
+
+class TopKTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+    void TearDown() override
+    {
+    }
+
+    static std::vector<int> RandomScores(std::size_t size, int max_value, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<int> scores(size);
+        for (auto& score : scores)
+        {
+            score = static_cast<int>(rng() % static_cast<std::uint64_t>(max_value));
+        }
+        return scores;
+    }
+
+    template<typename Comparator = std::greater<>>
+    static std::vector<int> Expected(const std::vector<int>& scores, std::size_t k, Comparator compare = Comparator{})
+    {
+        std::vector<int> expected(std::min(k, scores.size()));
+        std::partial_sort_copy(scores.begin(), scores.end(), expected.begin(), expected.end(), compare);
+        return expected;
+    }
+};
+
+TEST_F(TopKTest, HeapAndQuickselectMatchPartialSort)
+{
+    // k small against n takes the heap, large k the quickselect
+    const std::vector<int> scores = RandomScores(100000, 1 << 30, 1);
+    for (std::size_t k : { 1, 10, 100, 1000, 1562, 1563, 5000, 50000, 99999, 100000 })
+    {
+        std::vector<int> top(k);
+        const auto it_end = AoL::TopK(scores.begin(), scores.end(), k, top.begin());
+        EXPECT_EQ(it_end, top.end());
+        EXPECT_EQ(top, Expected(scores, k)) << "k = " << k;
+    }
+
+    // Few distinct values
+    const std::vector<int> duplicates = RandomScores(50000, 5, 2);
+    std::vector<int> top(300);
+    AoL::TopK(duplicates.begin(), duplicates.end(), 300, top.begin());
+    EXPECT_EQ(top, Expected(duplicates, 300));
+}
+
+TEST_F(TopKTest, ComparatorsEdgeCasesAndIterators)
+{
+    const std::vector<int> scores = RandomScores(20000, 1000000, 3);
+
+    // std::less gives the k smallest
+    std::vector<int> bottom(50);
+    AoL::TopK(scores.begin(), scores.end(), 50, bottom.begin(), std::less<>());
+    EXPECT_EQ(bottom, Expected(scores, 50, std::less<>()));
+
+    std::vector<int> none;
+    AoL::TopK(scores.begin(), scores.end(), 0, std::back_inserter(none));
+    EXPECT_TRUE(none.empty());
+
+    // k larger than the range: every element, sorted
+    const std::vector<int> small{ 4, 9, 1 };
+    std::vector<int> all;
+    AoL::TopK(small.begin(), small.end(), 10, std::back_inserter(all));
+    EXPECT_EQ(all, (std::vector<int>{ 9, 4, 1 }));
+
+    // Forward iterators and non trivial elements
+    const std::list<std::string> names{ "delta", "alpha", "echo", "charlie", "bravo" };
+    std::vector<std::string> first_names;
+    AoL::TopK(names.begin(), names.end(), 2, std::back_inserter(first_names), std::less<>());
+    EXPECT_EQ(first_names, (std::vector<std::string>{ "alpha", "bravo" }));
+}
+
+TEST_F(TopKTest, ParallelMatchesOnEveryPoolSize)
+{
+    const std::vector<int> scores = RandomScores(1000000, 1 << 30, 4);
+    const std::vector<int> duplicates = RandomScores(1000000, 7, 5);
+    for (std::size_t worker_count : { 0, 1, 3, 7 })
+    {
+        AoL::ThreadPool pool(worker_count);
+        for (std::size_t k : { 1, 100, 1000, 20000 })
+        {
+            std::vector<int> top(k);
+            const auto it_end = AoL::TopKParallel(pool, scores.begin(), scores.end(), k, top.begin());
+            EXPECT_EQ(it_end, top.end());
+            EXPECT_EQ(top, Expected(scores, k)) << "k = " << k << ", workers = " << worker_count;
+        }
+
+        std::vector<int> bottom(100);
+        AoL::TopKParallel(pool, duplicates.begin(), duplicates.end(), 100, bottom.begin(), std::less<>());
+        EXPECT_EQ(bottom, Expected(duplicates, 100, std::less<>()));
+    }
+}
+
+// ===================================================================
+// EXTERNAL SORT TESTS
+// ===================================================================
+
+class ExternalSortTest : public ::testing::Test
+{
+protected:
+    // Event dump record: sorted by timestamp, the payload checks records are moved whole
+    struct Event
+    {
+        std::uint64_t timestamp;
+        std::uint32_t id;
+        std::uint32_t payload;
+    };
+
+    static bool EarlierEvent(const Event& a, const Event& b)
+    {
+        return a.timestamp < b.timestamp || (a.timestamp == b.timestamp && a.id < b.id);
+    }
+
+    std::filesystem::path directory;
+
+    void SetUp() override
+    {
+        directory = std::filesystem::temp_directory_path() / ("aol-external-sort-tests-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::create_directories(directory / "runs");
+    }
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    static std::vector<Event> RandomEvents(std::size_t size, std::uint64_t max_timestamp, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<Event> events(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            events[i].timestamp = rng() % max_timestamp;
+            events[i].id = static_cast<std::uint32_t>(i);
+            events[i].payload = static_cast<std::uint32_t>(events[i].timestamp * 31 + i);
+        }
+        return events;
+    }
+
+    static void WriteEvents(const std::filesystem::path& path, const std::vector<Event>& events)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(Event)));
+    }
+
+    static std::vector<Event> ReadEvents(const std::filesystem::path& path)
+    {
+        std::vector<Event> events(std::filesystem::file_size(path) / sizeof(Event));
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char*>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(Event)));
+        return events;
+    }
+
+    static void ExpectSame(const std::vector<Event>& actual, const std::vector<Event>& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i)
+        {
+            ASSERT_EQ(actual[i].timestamp, expected[i].timestamp) << "i = " << i;
+            ASSERT_EQ(actual[i].id, expected[i].id) << "i = " << i;
+            ASSERT_EQ(actual[i].payload, expected[i].payload) << "i = " << i;
+        }
+    }
+};
+
+TEST_F(ExternalSortTest, SortsFilesLargerThanTheBudget)
+{
+    // 6 MB of events with a 1 MB budget: 6 runs, more than the 1 MB fan in of 4, so two merge passes
+    std::vector<Event> events = RandomEvents(400000, 1 << 20, 1);
+    WriteEvents(directory / "events.bin", events);
+
+    AoL::ExternalSortFile<Event>(directory / "events.bin", directory / "sorted.bin", 1 << 20, EarlierEvent, directory / "runs");
+
+    std::sort(events.begin(), events.end(), EarlierEvent);
+    ExpectSame(ReadEvents(directory / "sorted.bin"), events);
+    EXPECT_TRUE(std::filesystem::is_empty(directory / "runs"));
+}
+
+TEST_F(ExternalSortTest, InMemoryEmptyAndFewRuns)
+{
+    for (std::size_t count : { 0, 1, 1000, 70000 })
+    {
+        std::vector<Event> events = RandomEvents(count, 100, count);
+        WriteEvents(directory / "events.bin", events);
+        AoL::ExternalSortFile<Event>(directory / "events.bin", directory / "sorted.bin", 1 << 20, EarlierEvent, directory / "runs");
+
+        std::sort(events.begin(), events.end(), EarlierEvent);
+        ExpectSame(ReadEvents(directory / "sorted.bin"), events);
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(directory / "runs"));
+}
+
+TEST_F(ExternalSortTest, SortsIteratorRanges)
+{
+    std::mt19937_64 rng{ 3 };
+    std::vector<std::uint32_t> values(1000000);
+    for (auto& value : values)
+    {
+        value = static_cast<std::uint32_t>(rng() % 5000);
+    }
+
+    std::vector<std::uint32_t> sorted;
+    AoL::ExternalSort(values.begin(), values.end(), std::back_inserter(sorted), 1 << 19, std::greater<>(), directory / "runs");
+
+    std::sort(values.begin(), values.end(), std::greater<>());
+    EXPECT_EQ(sorted, values);
+    EXPECT_TRUE(std::filesystem::is_empty(directory / "runs"));
+}
+
+TEST_F(ExternalSortTest, ReportsFileErrors)
+{
+    EXPECT_THROW(AoL::ExternalSortFile<Event>(directory / "missing.bin", directory / "sorted.bin", 1 << 20, EarlierEvent, directory / "runs"), std::filesystem::filesystem_error);
+
+    // Not a whole number of records
+    std::ofstream(directory / "truncated.bin", std::ios::binary) << "12345";
+    EXPECT_THROW(AoL::ExternalSortFile<Event>(directory / "truncated.bin", directory / "sorted.bin", 1 << 20, EarlierEvent, directory / "runs"), std::filesystem::filesystem_error);
+}
@@ -1,5 +1,5 @@
 /********************************************************************
-* FlatKeyOrderMap tests: all container operations
+* FlatKeyOrderMap tests: all container operations, erase, serialization, FlatKeyOrderMapSoA, FlatKeyOrderMapLog and ConstexprKeyOrderMap
 ********************************************************************/
 
 
@@ -8,6 +8,12 @@
 #include "aol/key_ordered_map.h"
 #include "aol/utilities.h"
 
+#include <list>
+#include <sstream>
+
+#include "cereal/archives/binary.hpp"
+#include "aol/serialization.h"
+
 
 namespace
 {
@@ -34,6 +40,20 @@ struct TestData
     }
 };
 
+enum class TestColor
+{
+    Red,
+    Green,
+    Blue,
+    Black
+};
+
+struct TestColorConfig
+{
+    int id;
+    const char* name;
+};
+
 }
 
 // ===================================================================
@@ -258,6 +278,154 @@ TEST_F(FlatKeyOrderMapInsertTest, InsertReverseOrder)
     );
 }
 
+// ===================================================================
+// INSERT BULK TESTS
+// ===================================================================
+
+class FlatKeyOrderMapInsertBulkTest : public ::testing::Test
+{
+protected:
+    using TestMap = AoL::FlatKeyOrderMap<int, std::string>;
+    using Pair = AoL::FlatKeyOrderMapPair<int, std::string>;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+    // Keys key_begin, key_begin + step, ... in a scrambled order
+    static std::vector<Pair> Batch(int key_begin, int step, int count)
+    {
+        std::vector<Pair> batch;
+        for (int i = 0; i < count; ++i)
+        {
+            const int key = key_begin + ((i * 7919) % count) * step;
+            batch.push_back({ key, std::to_string(key) });
+        }
+        return batch;
+    }
+
+    template<typename Map>
+    static void ExpectKeysAndValues(const Map& map, std::size_t size)
+    {
+        ASSERT_EQ(map.size(), size);
+        EXPECT_TRUE(std::is_sorted(map.begin(), map.end(), [](const auto& a, const auto& b) { return a.first < b.first; }));
+        for (const auto& pair : map)
+        {
+            EXPECT_EQ(pair.second, std::to_string(pair.first));
+        }
+    }
+};
+
+TEST_F(FlatKeyOrderMapInsertBulkTest, MergesIntoLiveMap)
+{
+    TestMap map;
+    const std::vector<Pair> evens = Batch(0, 2, 1000);
+    map.insert_bulk(evens.begin(), evens.end());
+    ExpectKeysAndValues(map, 1000);
+
+    // Interleaved, before and after the existing keys
+    const std::vector<Pair> odds = Batch(1, 2, 300);
+    map.insert_bulk(odds.begin(), odds.end());
+    const std::vector<Pair> outside{ { -10, "-10" }, { 5000, "5000" }, { -3, "-3" } };
+    map.insert_bulk(outside.begin(), outside.end());
+    ExpectKeysAndValues(map, 1303);
+    EXPECT_EQ(map[599], "599");
+    EXPECT_EQ(map.find(601), nullptr);
+
+    // Still usable with insert() and the build path
+    map.insert(603, "603");
+    map.build_start();
+    map.build_add(-100, "-100");
+    map.build_end();
+    ExpectKeysAndValues(map, 1305);
+}
+
+TEST_F(FlatKeyOrderMapInsertBulkTest, EmptyBatchesAndIteratorKinds)
+{
+    TestMap map;
+    const std::vector<Pair> none;
+    map.insert_bulk(none.begin(), none.end());
+    EXPECT_TRUE(map.empty());
+
+    const std::list<Pair> listed{ { 3, "3" }, { 1, "1" }, { 2, "2" } };
+    map.insert_bulk(listed.begin(), listed.end());
+    map.insert_bulk(none.begin(), none.end());
+    ExpectKeysAndValues(map, 3);
+
+    // Large radix sorted batch, and a non radix key type
+    AoL::FlatKeyOrderMap<std::uint64_t, std::uint64_t> ids;
+    std::vector<AoL::FlatKeyOrderMapPair<std::uint64_t, std::uint64_t>> id_batch;
+    for (std::uint64_t i = 0; i < 20000; ++i)
+    {
+        id_batch.push_back({ (i * 2654435761u) % 1000003u, i });
+    }
+    ids.insert_bulk(id_batch.begin(), id_batch.begin() + 10000);
+    ids.insert_bulk(id_batch.begin() + 10000, id_batch.end());
+    ASSERT_EQ(ids.size(), 20000);
+    for (const auto& pair : id_batch)
+    {
+        EXPECT_EQ(ids[pair.first], pair.second);
+    }
+
+    AoL::FlatKeyOrderMap<std::string, int> names;
+    const std::vector<AoL::FlatKeyOrderMapPair<std::string, int>> name_batch{ { "delta", 4 }, { "alpha", 1 }, { "charlie", 3 } };
+    names.insert_bulk(name_batch.begin(), name_batch.end());
+    names.insert("bravo", 2);
+    EXPECT_EQ(names.begin()->first, "alpha");
+    EXPECT_EQ(names[std::string("charlie")], 3);
+}
+
+TEST_F(FlatKeyOrderMapInsertBulkTest, DropsKeysAlreadyThereOrRepeated)
+{
+    TestMap map;
+    const std::vector<Pair> evens = Batch(0, 2, 100);
+    map.insert_bulk(evens.begin(), evens.end());
+
+    // 10 and 198 are in the map, 7 and 301 repeat in the batch
+    const std::vector<Pair> batch{ { 7, "7" }, { 10, "new" }, { 301, "301" }, { 7, "7" }, { 198, "new" }, { -1, "-1" }, { 301, "301" } };
+    map.insert_bulk(batch.begin(), batch.end());
+    ExpectKeysAndValues(map, 103);
+    EXPECT_EQ(map[7], "7");
+    EXPECT_EQ(map[301], "301");
+
+    // Only known keys: nothing changes
+    map.insert_bulk(batch.begin(), batch.end());
+    ExpectKeysAndValues(map, 103);
+
+    // Few keys over a large map (searched up front instead of by the merge)
+    TestMap large;
+    const std::vector<Pair> large_evens = Batch(0, 2, 2000);
+    large.insert_bulk(large_evens.begin(), large_evens.end());
+    const std::vector<Pair> sparse{ { 3001, "3001" }, { 10, "new" }, { 1001, "1001" }, { 3998, "new" }, { 1001, "1001" } };
+    large.insert_bulk(sparse.begin(), sparse.end());
+    ExpectKeysAndValues(large, 2002);
+    EXPECT_EQ(large[1001], "1001");
+    EXPECT_EQ(large[3001], "3001");
+
+    // Into an empty map, repeats only
+    TestMap empty;
+    const std::vector<Pair> repeats{ { 4, "4" }, { 4, "4" }, { 2, "2" }, { 4, "4" } };
+    empty.insert_bulk(repeats.begin(), repeats.end());
+    ExpectKeysAndValues(empty, 2);
+}
+
+TEST_F(FlatKeyOrderMapInsertBulkTest, StructureOfArrays)
+{
+    AoL::FlatKeyOrderMapSoA<int, std::string> map;
+    const std::vector<Pair> evens = Batch(0, 2, 1000);
+    const std::vector<Pair> odds = Batch(1, 2, 300);
+    map.insert_bulk(evens.begin(), evens.end());
+    map.insert_bulk(odds.begin(), odds.end());
+    ExpectKeysAndValues(map, 1300);
+
+    AoL::FlatKeyOrderMapSoA<std::string, int> names;
+    const std::vector<AoL::FlatKeyOrderMapPair<std::string, int>> name_batch{ { "delta", 4 }, { "alpha", 1 }, { "charlie", 3 } };
+    names.insert_bulk(name_batch.begin(), name_batch.begin() + 2);
+    names.insert_bulk(name_batch.begin() + 2, name_batch.end());
+    EXPECT_EQ(names.begin()->first, "alpha");
+    EXPECT_EQ((names.begin() + 1)->first, "charlie");
+    EXPECT_EQ(names[std::string("delta")], 4);
+}
+
 // ===================================================================
 // ACCESS OPERATIONS TESTS
 // ===================================================================
@@ -393,6 +561,120 @@ TEST_F(FlatKeyOrderMapFindTest, FindMultipleElements)
     }
 }
 
+TEST_F(FlatKeyOrderMapFindTest, FindFromWalksSortedKeys)
+{
+    TestMap map;
+    for (int i = 0; i < 200; i += 2)
+    {
+        map.insert(i, "value_" + std::to_string(i));
+    }
+
+    const TestMap::value_type* p_hint = nullptr;
+    for (int key = 0; key < 200; key += 6)
+    {
+        auto ptr = map.find_from(p_hint, key);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(ptr->first, key);
+        p_hint = ptr;
+    }
+
+    EXPECT_EQ(map.find_from(p_hint, 7), nullptr);
+    EXPECT_EQ(map.find_from(p_hint, 1000), nullptr);
+}
+
+TEST_F(FlatKeyOrderMapFindTest, FindFromHintAfterKey)
+{
+    TestMap map;
+    for (int i = 0; i < 50; ++i)
+    {
+        map.insert(i * 10, std::to_string(i));
+    }
+
+    const TestMap& const_map = map;
+    const auto* p_hint = const_map.find(400);
+    ASSERT_NE(p_hint, nullptr);
+
+    auto ptr = const_map.find_from(p_hint, 30);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(ptr->second, "3");
+    EXPECT_EQ(const_map.find_from(map.data() + map.size(), 490)->second, "49");
+    EXPECT_EQ(const_map.find_from(p_hint, -5), nullptr);
+}
+
+TEST_F(FlatKeyOrderMapFindTest, LowerAndUpperBound)
+{
+    TestMap map;
+    for (int i = 0; i < 20; ++i)
+    {
+        map.insert(i * 5, std::to_string(i));
+    }
+
+    for (int key = -3; key <= 100; ++key)
+    {
+        auto expected_lower = std::lower_bound(map.begin(), map.end(), key, [](const auto& pair, int value) { return pair.first < value; });
+        auto expected_upper = std::upper_bound(map.begin(), map.end(), key, [](int value, const auto& pair) { return value < pair.first; });
+        EXPECT_EQ(map.lower_bound(key), expected_lower) << "key " << key;
+        EXPECT_EQ(map.upper_bound(key), expected_upper) << "key " << key;
+    }
+
+    const TestMap& const_map = map;
+    EXPECT_EQ(const_map.lower_bound(42)->first, 45);
+    EXPECT_EQ(const_map.upper_bound(45)->first, 50);
+    EXPECT_EQ(const_map.upper_bound(95), const_map.end());
+}
+
+TEST_F(FlatKeyOrderMapFindTest, EqualRange)
+{
+    TestMap map;
+    for (int i = 0; i < 10; ++i)
+    {
+        map.insert(i * 2, std::to_string(i));
+    }
+
+    auto hit = map.equal_range(6);
+    ASSERT_EQ(hit.size(), 1);
+    EXPECT_EQ(hit[0].second, "3");
+    hit[0].second = "three";
+    EXPECT_EQ(map[6], "three");
+
+    const TestMap& const_map = map;
+    auto miss = const_map.equal_range(7);
+    EXPECT_TRUE(miss.empty());
+    EXPECT_EQ(miss.begin()->first, 8);
+    EXPECT_TRUE(const_map.equal_range(100).empty());
+    EXPECT_EQ(const_map.equal_range(100).begin(), const_map.end());
+}
+
+TEST_F(FlatKeyOrderMapFindTest, RangeIsHalfOpen)
+{
+    TestMap map;
+    for (int i = 0; i < 100; ++i)
+    {
+        map.insert(i * 3, std::to_string(i));
+    }
+
+    auto sub = map.range(10, 31);
+    ASSERT_EQ(sub.size(), 7);
+    EXPECT_EQ(sub.begin()->first, 12);
+    EXPECT_EQ(sub[6].first, 30);
+
+    int count = 0;
+    for (const auto& pair : map.range(30, 60))
+    {
+        EXPECT_GE(pair.first, 30);
+        EXPECT_LT(pair.first, 60);
+        ++count;
+    }
+    EXPECT_EQ(count, 10);
+
+    const TestMap& const_map = map;
+    EXPECT_TRUE(const_map.range(31, 32).empty());
+    EXPECT_TRUE(const_map.range(50, 50).empty());
+    EXPECT_EQ(const_map.range(-100, 1000).size(), map.size());
+    EXPECT_EQ(const_map.range(290, 1000).size(), 3);
+    EXPECT_TRUE(TestMap{}.range(0, 10).empty());
+}
+
 // ===================================================================
 // CONTAINS TESTS
 // ===================================================================
@@ -591,6 +873,247 @@ TEST_F(FlatKeyOrderMapClearTest, SizeTracking)
     }
 }
 
+// ===================================================================
+// ERASE TESTS
+// ===================================================================
+
+class FlatKeyOrderMapEraseTest : public ::testing::Test
+{
+protected:
+    using TestMap = AoL::FlatKeyOrderMap<int, int>;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+    static TestMap MakeMap(int count)
+    {
+        TestMap map;
+        map.build_start();
+        for (int i = 0; i < count; ++i)
+        {
+            map.build_add(i, i * 10);
+        }
+        map.build_end();
+        return map;
+    }
+};
+
+TEST_F(FlatKeyOrderMapEraseTest, EraseHidesKeyUntilCompacted)
+{
+    TestMap map = MakeMap(100);
+
+    EXPECT_EQ(map.erase(42), 1);
+    EXPECT_EQ(map.erase(42), 0);
+    EXPECT_EQ(map.erase(1000), 0);
+
+    // Marked only, the storage keeps the element until compact()
+    EXPECT_EQ(map.size(), 99);
+    EXPECT_EQ(map.container_obj.size(), 100);
+    EXPECT_EQ(map.find(42), nullptr);
+    EXPECT_FALSE(map.contains(42));
+    EXPECT_EQ(map.at_ptr(42), nullptr);
+    EXPECT_EQ(map[41], 410);
+    EXPECT_EQ(map[43], 430);
+
+    map.compact();
+    EXPECT_EQ(map.container_obj.size(), 99);
+    EXPECT_EQ(map.size(), 99);
+    EXPECT_FALSE(map.contains(42));
+}
+
+TEST_F(FlatKeyOrderMapEraseTest, IterationSkipsErased)
+{
+    TestMap map = MakeMap(10);
+    map.erase(0);
+    map.erase(5);
+    map.erase(9);
+
+    std::vector<int> keys;
+    for (const auto& [key, value] : map)
+    {
+        keys.push_back(key);
+        EXPECT_EQ(value, key * 10);
+    }
+    EXPECT_EQ(keys, (std::vector<int>{ 1, 2, 3, 4, 6, 7, 8 }));
+
+    auto range = map.range(3, 8);
+    EXPECT_EQ(range.size(), 4);
+    EXPECT_EQ(range.begin()->first, 3);
+}
+
+TEST_F(FlatKeyOrderMapEraseTest, ConstAccessSkipsErased)
+{
+    // Marks under the automatic compaction, read through a const map that must not compact
+    TestMap map = MakeMap(200);
+    for (int key : { 0, 7, 8, 9, 31, 40, 63, 64, 127, 150 })
+    {
+        map.erase(key);
+    }
+    ASSERT_EQ(map.tombstone_count, 10);
+
+    const TestMap& const_map = map;
+    const int* p_value = &const_map.find(10)->second;
+    std::vector<int> keys;
+    for (const auto& [key, value] : const_map)
+    {
+        keys.push_back(key);
+        EXPECT_EQ(value, key * 10);
+    }
+    EXPECT_EQ(keys.size(), 190);
+    EXPECT_EQ(const_map.end() - const_map.begin(), 190);
+    EXPECT_EQ(std::distance(const_map.cbegin(), const_map.cend()), 190);
+    EXPECT_EQ(std::find_if(const_map.cbegin(), const_map.cend(), [](const auto& pair) { return pair.first == 7; }), const_map.cend());
+    EXPECT_EQ(const_map.begin()->first, 1);
+    EXPECT_EQ(const_map.rbegin()->first, 199);
+    EXPECT_EQ(std::distance(const_map.crbegin(), const_map.crend()), 190);
+
+    // Bounds land on the next live element
+    EXPECT_EQ(const_map.lower_bound(7)->first, 10);
+    EXPECT_EQ(const_map.upper_bound(6)->first, 10);
+    EXPECT_EQ(const_map.upper_bound(62)->first, 65);
+    EXPECT_EQ(const_map.upper_bound(199), const_map.end());
+    EXPECT_TRUE(const_map.equal_range(8).empty());
+    EXPECT_EQ(const_map.equal_range(10).size(), 1);
+    EXPECT_EQ(const_map.range(5, 12).size(), 4);
+    EXPECT_EQ(const_map.range(30, 42).size(), 10);
+    EXPECT_EQ(const_map.range(60, 160).size(), 96);
+    EXPECT_EQ(const_map.range(0, 200).size(), 190);
+    EXPECT_EQ(const_map.at_ref(10), 100);
+    EXPECT_EQ(const_map[62], 620);
+
+    // Nothing moved
+    EXPECT_EQ(map.tombstone_count, 10);
+    EXPECT_EQ(map.container_obj.size(), 200);
+    EXPECT_EQ(&const_map.find(10)->second, p_value);
+
+    map.compact();
+    EXPECT_EQ(const_map.end() - const_map.begin(), 190);
+    EXPECT_EQ(const_map.data()->first, 1);
+}
+
+TEST_F(FlatKeyOrderMapEraseTest, CompactsInBulk)
+{
+    TestMap map = MakeMap(100);
+
+    // Compaction waits until a quarter of the storage is marked
+    for (int i = 0; i < 25; ++i)
+    {
+        map.erase(i * 2);
+    }
+    EXPECT_EQ(map.container_obj.size(), 100);
+    EXPECT_EQ(map.size(), 75);
+
+    map.erase(50);
+    EXPECT_EQ(map.container_obj.size(), 74);
+    EXPECT_EQ(map.size(), 74);
+    EXPECT_FALSE(map.contains(48));
+    EXPECT_TRUE(map.contains(49));
+    EXPECT_FALSE(map.contains(50));
+    EXPECT_TRUE(map.contains(51));
+}
+
+TEST_F(FlatKeyOrderMapEraseTest, ReinsertErasedKey)
+{
+    TestMap map = MakeMap(10);
+    map.erase(3);
+    map.erase(7);
+
+    // Reuses the slot of the erased element, nothing is compacted
+    map.insert(3, 333);
+    EXPECT_EQ(map.container_obj.size(), 10);
+    EXPECT_EQ(map.size(), 9);
+    EXPECT_EQ(map[3], 333);
+
+    EXPECT_EQ(map.at_ref(7), 0);
+    EXPECT_EQ(map.size(), 10);
+
+    // A new key compacts first, then inserts in order
+    map.erase(4);
+    map.insert(20, 200);
+    EXPECT_EQ(map.container_obj.size(), 10);
+    EXPECT_FALSE(map.contains(4));
+    EXPECT_EQ(map.rbegin()->first, 20);
+}
+
+TEST_F(FlatKeyOrderMapEraseTest, EraseIf)
+{
+    TestMap map = MakeMap(100);
+    map.erase(1);
+    map.erase(2);
+
+    const auto erased = map.erase_if([](const auto& item) { return item.first % 2 == 1; });
+
+    // Odd keys but 1, which was already erased
+    EXPECT_EQ(erased, 49);
+    EXPECT_EQ(map.size(), 49);
+    EXPECT_EQ(map.container_obj.size(), 49);
+    EXPECT_FALSE(map.contains(2));
+
+    int expected_key = 0;
+    for (const auto& item : map)
+    {
+        EXPECT_EQ(item.first, expected_key);
+        EXPECT_EQ(item.second, expected_key * 10);
+        expected_key += expected_key == 0 ? 4 : 2;
+    }
+    EXPECT_EQ(map.erase_if([](const auto&) { return false; }), 0);
+}
+
+TEST_F(FlatKeyOrderMapEraseTest, EraseAllAndClear)
+{
+    TestMap map = MakeMap(4);
+    for (int i = 0; i < 3; ++i)
+    {
+        map.erase(i);
+    }
+    EXPECT_EQ(map.size(), 1);
+    map.erase(3);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+
+    map = MakeMap(8);
+    map.erase(1);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    map.insert(1, 1);
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map[1], 1);
+}
+
+TEST_F(FlatKeyOrderMapEraseTest, SerializesLiveElementsOnly)
+{
+    TestMap map = MakeMap(64);
+    map.erase(0);
+    map.erase(31);
+    map.erase(63);
+    ASSERT_EQ(map.tombstone_count, 3);
+
+    std::stringstream stream;
+    {
+        cereal::BinaryOutputArchive archive(stream);
+        archive(std::as_const(map));
+    }
+    EXPECT_EQ(map.tombstone_count, 3);
+
+    // Loaded over a map with its own pending marks
+    TestMap loaded = MakeMap(16);
+    loaded.erase(5);
+    {
+        cereal::BinaryInputArchive archive(stream);
+        archive(loaded);
+    }
+    EXPECT_EQ(loaded.tombstone_count, 0);
+    EXPECT_TRUE(loaded.tombstones_obj.empty());
+    ASSERT_EQ(loaded.size(), 61);
+    EXPECT_EQ(loaded.container_obj.size(), 61);
+    EXPECT_FALSE(loaded.contains(0));
+    EXPECT_FALSE(loaded.contains(31));
+    EXPECT_FALSE(loaded.contains(63));
+    EXPECT_EQ(loaded[5], 50);
+    EXPECT_EQ(loaded.begin()->first, 1);
+    EXPECT_EQ(std::prev(loaded.end())->first, 62);
+}
+
 // ===================================================================
 // DATA ACCESS TESTS
 // ===================================================================
@@ -846,3 +1369,337 @@ TEST_F(FlatKeyOrderMapPerformanceTest, IterationThroughAllElements)
 
     EXPECT_EQ(sum, expected);
 }
+
+// ===================================================================
+// STRUCTURE OF ARRAYS TESTS
+// ===================================================================
+
+class FlatKeyOrderMapSoATest : public ::testing::Test
+{
+protected:
+    using TestMap = AoL::FlatKeyOrderMapSoA<int, std::string>;
+
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(FlatKeyOrderMapSoATest, BuildInsertAndFind)
+{
+    TestMap map;
+    map.build_start();
+    for (int i = 999; i >= 0; i -= 2)
+    {
+        map.build_add(i, std::to_string(i));
+    }
+    map.build_end();
+
+    ASSERT_EQ(map.size(), 500);
+    EXPECT_TRUE(std::is_sorted(map.keys_data(), map.keys_data() + map.size()));
+    for (std::size_t i = 0; i < map.size(); ++i)
+    {
+        EXPECT_EQ(map.values_data()[i], std::to_string(map.keys_data()[i]));
+    }
+
+    map.insert(4, "four");
+    map.insert(-1, "minus one");
+    map.insert(1001, "last");
+    EXPECT_EQ(map.size(), 503);
+    EXPECT_EQ(map[4], "four");
+    EXPECT_EQ(map.begin()->second, "minus one");
+    EXPECT_EQ(map.rbegin()->first, 1001);
+
+    auto it = map.find(501);
+    ASSERT_NE(it, nullptr);
+    EXPECT_EQ(it->first, 501);
+    it->second = "changed";
+    EXPECT_EQ(map[501], "changed");
+    EXPECT_EQ(map.find(500), nullptr);
+    EXPECT_TRUE(map.contains(999));
+    EXPECT_FALSE(map.contains(998));
+
+    EXPECT_EQ(*map.at_ptr(7), "7");
+    EXPECT_EQ(map.at_ptr(8), nullptr);
+    map.at_ref(8) = "eight";
+    EXPECT_EQ(map[8], "eight");
+    EXPECT_EQ(map.size(), 504);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), nullptr);
+}
+
+TEST_F(FlatKeyOrderMapSoATest, SearchesMatchFlatKeyOrderMap)
+{
+    AoL::FlatKeyOrderMap<int, std::string> expected;
+    std::vector<AoL::FlatKeyOrderMapPair<int, std::string>> pairs;
+    for (int i = 0; i < 300; ++i)
+    {
+        const int key = (i * 7919) % 1200;
+        expected.insert(key, std::to_string(i));
+        pairs.push_back({ key, std::to_string(i) });
+    }
+    const TestMap map(pairs.begin(), pairs.end());
+    ASSERT_EQ(map.size(), expected.size());
+    EXPECT_TRUE(std::equal(map.begin(), map.end(), expected.begin(), expected.end(),
+        [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+
+    for (int key = -5; key <= 1205; ++key)
+    {
+        EXPECT_EQ(map.lower_bound(key) - map.begin(), expected.lower_bound(key) - expected.begin()) << "key " << key;
+        EXPECT_EQ(map.upper_bound(key) - map.begin(), expected.upper_bound(key) - expected.begin()) << "key " << key;
+        EXPECT_EQ(map.equal_range(key).size(), expected.equal_range(key).size()) << "key " << key;
+        EXPECT_EQ(map.range(key, key + 40).size(), expected.range(key, key + 40).size()) << "key " << key;
+    }
+
+    TestMap::const_iterator it_hint = nullptr;
+    for (const auto& pair : expected)
+    {
+        it_hint = map.find_from(it_hint, pair.first);
+        ASSERT_NE(it_hint, nullptr);
+        EXPECT_EQ(it_hint->second, pair.second);
+    }
+    EXPECT_EQ(map.find_from(map.end(), -1), nullptr);
+    EXPECT_EQ(map.equal_range(expected.begin()->first)[0].second, expected.begin()->second);
+}
+
+TEST_F(FlatKeyOrderMapSoATest, NonRadixKeysAndPresortedStorage)
+{
+    AoL::FlatKeyOrderMapSoA<std::string, int> names;
+    names.build_start();
+    for (int i = 0; i < 100; ++i)
+    {
+        names.build_add("name_" + std::to_string((i * 37) % 100), i);
+    }
+    names.build_end();
+    EXPECT_TRUE(std::is_sorted(names.keys_data(), names.keys_data() + names.size()));
+    EXPECT_EQ(names[std::string("name_37")], 1);
+
+    // Sorted keys with a few appended, the values follow their keys
+    std::vector<int> keys;
+    std::vector<int> values;
+    for (int i = 0; i < 5000; ++i)
+    {
+        keys.push_back(i * 2);
+        values.push_back(-i * 2);
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+        keys.push_back(i * 401 + 1);
+        values.push_back(-(i * 401 + 1));
+    }
+    const AoL::FlatKeyOrderMapSoA<int, int> map(AoL::Vector<int>(keys.begin(), keys.end()), AoL::Vector<int>(values.begin(), values.end()));
+    ASSERT_EQ(map.size(), 5020);
+    for (const auto& pair : map)
+    {
+        EXPECT_EQ(pair.second, -pair.first);
+    }
+}
+
+// ===================================================================
+// LOG STRUCTURED TESTS
+// ===================================================================
+
+class FlatKeyOrderMapLogTest : public ::testing::Test
+{
+protected:
+    using TestMap = AoL::FlatKeyOrderMapLog<int, std::string>;
+
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(FlatKeyOrderMapLogTest, FindsKeysInTailAndMain)
+{
+    TestMap map(16);
+    map.build_start();
+    for (int i = 0; i < 100; i += 2)
+    {
+        map.build_add(i, std::to_string(i));
+    }
+    map.build_end();
+
+    // Stays in the tail until it passes 16 elements
+    for (int i = 99; i > 70; i -= 2)
+    {
+        map.insert(i, std::to_string(i));
+    }
+    EXPECT_EQ(map.tail_obj.size(), 15);
+    EXPECT_EQ(map.size(), 65);
+    for (int i = 0; i < 100; ++i)
+    {
+        const bool expected = i % 2 == 0 || i > 70;
+        ASSERT_EQ(map.contains(i), expected) << "key " << i;
+        if (expected)
+        {
+            EXPECT_EQ(map[i], std::to_string(i));
+        }
+    }
+
+    map[75] = "changed";
+    EXPECT_EQ(*map.at_ptr(75), "changed");
+    map.insert(1, "1");
+    map.insert(3, "3");
+    EXPECT_TRUE(map.tail_obj.empty());
+    EXPECT_EQ(map.main_obj.size(), 67);
+    EXPECT_EQ(map[75], "changed");
+    EXPECT_EQ(map.at_ptr(5), nullptr);
+    map.at_ref(5) = "5";
+    EXPECT_EQ(map[5], "5");
+}
+
+TEST_F(FlatKeyOrderMapLogTest, CompactIterationAndBatches)
+{
+    TestMap map;
+    std::vector<AoL::FlatKeyOrderMapPair<int, std::string>> expected;
+    for (int i = 0; i < 5000; ++i)
+    {
+        const int key = (i * 7919) % 5003;
+        map.insert(key, std::to_string(key));
+        expected.push_back({ key, std::to_string(key) });
+    }
+    EXPECT_EQ(map.size(), 5000);
+    EXPECT_FALSE(map.tail_obj.empty());
+
+    std::sort(expected.begin(), expected.end());
+    EXPECT_TRUE(std::equal(map.begin(), map.end(), expected.begin(), expected.end(),
+        [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+    EXPECT_TRUE(map.tail_obj.empty());
+
+    const std::vector<AoL::FlatKeyOrderMapPair<int, std::string>> batch{ { 6000, "6000" }, { -1, "-1" } };
+    map.insert(5500, "5500");
+    map.insert_bulk(batch.begin(), batch.end());
+    EXPECT_TRUE(map.tail_obj.empty());
+    EXPECT_EQ(map.sorted().lower_bound(5400)->first, 5500);
+    EXPECT_EQ(map.sorted().range(-5, 3).size(), 4);
+
+    const TestMap& const_map = map;
+    EXPECT_EQ(const_map.begin()->first, -1);
+    EXPECT_EQ(const_map.size(), 5003);
+
+    // Empty batch with an empty tail leaves the main array untouched
+    const std::vector<AoL::FlatKeyOrderMapPair<int, std::string>> none;
+    map.insert_bulk(none.begin(), none.end());
+    EXPECT_EQ(map.size(), 5003);
+    EXPECT_EQ(map[5500], "5500");
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST_F(FlatKeyOrderMapLogTest, ConstIterationReadsTail)
+{
+    TestMap map(64);
+    for (int i = 0; i < 200; i += 2)
+    {
+        map.insert(i, std::to_string(i));
+    }
+    map.compact();
+    map.main_obj.erase(10);
+
+    // Odd keys stay in the tail, before, between and after the main keys
+    for (int i = -5; i < 210; i += 7)
+    {
+        if (i % 2 != 0)
+        {
+            map.insert(i, std::to_string(i));
+        }
+    }
+    ASSERT_FALSE(map.tail_obj.empty());
+
+    const TestMap& const_map = map;
+    EXPECT_EQ(const_map.end() - const_map.begin(), static_cast<std::ptrdiff_t>(const_map.size()));
+    EXPECT_EQ(std::distance(const_map.begin(), const_map.end()), static_cast<std::ptrdiff_t>(const_map.size()));
+
+    std::vector<int> keys;
+    for (const auto& pair : const_map)
+    {
+        EXPECT_EQ(pair.second, std::to_string(pair.first));
+        keys.push_back(pair.first);
+    }
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    EXPECT_EQ(keys.size(), const_map.size());
+    EXPECT_EQ(keys.front(), -5);
+    EXPECT_EQ(std::count(keys.begin(), keys.end(), 10), 0);
+    EXPECT_FALSE(map.tail_obj.empty());
+
+    // Same order as the compacted map
+    map.compact();
+    EXPECT_TRUE(std::equal(keys.begin(), keys.end(), const_map.begin(), const_map.end(),
+        [](int key, const auto& pair) { return key == pair.first; }));
+}
+
+// ===================================================================
+// COMPILE TIME MAP TESTS
+// ===================================================================
+
+class ConstexprKeyOrderMapTest : public ::testing::Test
+{
+protected:
+    static constexpr auto color_map = AoL::MakeConstexprKeyOrderMap<TestColor, TestColorConfig>({
+        { TestColor::Blue, { 3, "blue" } },
+        { TestColor::Red, { 1, "red" } },
+        { TestColor::Green, { 2, "green" } }
+    });
+
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(ConstexprKeyOrderMapTest, LookupsAtCompileTime)
+{
+    // Sorted by the consteval constructor, constant keys resolve at compile time
+    static_assert(color_map.size() == 3);
+    static_assert(color_map.begin()->first == TestColor::Red);
+    static_assert(color_map[TestColor::Green].id == 2);
+    static_assert(color_map.contains(TestColor::Blue));
+    static_assert(!color_map.contains(TestColor::Black));
+    static_assert(color_map.at_ptr(TestColor::Black) == nullptr);
+    static_assert(color_map.lower_bound(TestColor::Black) == color_map.end());
+
+    EXPECT_STREQ(color_map[TestColor::Blue].name, "blue");
+}
+
+TEST_F(ConstexprKeyOrderMapTest, LookupsAtRuntime)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        const TestColor color = static_cast<TestColor>(i);
+        const auto* p_item = color_map.find(color);
+        if (color == TestColor::Black)
+        {
+            EXPECT_EQ(p_item, nullptr);
+        }
+        else
+        {
+            ASSERT_NE(p_item, nullptr);
+            EXPECT_EQ(p_item->second.id, i + 1);
+        }
+    }
+}
+
+TEST_F(ConstexprKeyOrderMapTest, LargeTableFromArray)
+{
+    // Past SortFixed's 32 elements, the consteval sort is std::sort
+    static constexpr auto items = []
+    {
+        AoL::Array<AoL::FlatKeyOrderMapPair<int, int>, 500> result{ };
+        for (int i = 0; i < 500; ++i)
+        {
+            result[i] = { (i * 7919) % 500, i };
+        }
+        return result;
+    }();
+    static constexpr AoL::ConstexprKeyOrderMap<int, int, 500> map{ items };
+
+    static_assert(map.find(499) != nullptr);
+    static_assert(map.find(500) == nullptr);
+
+    int expected_key = 0;
+    for (const auto& item : map)
+    {
+        EXPECT_EQ(item.first, expected_key);
+        EXPECT_EQ((item.second * 7919) % 500, expected_key);
+        ++expected_key;
+    }
+    EXPECT_EQ(expected_key, 500);
+}
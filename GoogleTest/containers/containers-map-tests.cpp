@@ -1,5 +1,5 @@
 /********************************************************************
-* Map container tests: KeyOrderMap, HashMap, InsertOrderMap
+* Map container tests: KeyOrderMap, HashMap, FrozenHashMap, InsertOrderMap
 ********************************************************************/
 
 #include "pch.h"
@@ -10,6 +10,11 @@
 
 #include "aol/utilities.h"
 
+#include <sstream>
+
+#include "cereal/archives/binary.hpp"
+#include "aol/serialization.h"
+
 namespace
 {
 
@@ -249,6 +254,160 @@ TEST_F(HashMapTest, Reserve)
     EXPECT_EQ(AoL::GetContainerSize(map), 25);
 }
 
+// ===================================================================
+// FROZEN HASH MAP TESTS
+// ===================================================================
+
+class FrozenHashMapTest : public ::testing::Test
+{
+protected:
+    using SourceMap = AoL::FlatKeyOrderMap<int, std::string>;
+    using TestMap = AoL::FrozenHashMap<int, std::string>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static SourceMap MakeSource(int count)
+    {
+        SourceMap map;
+        map.build_start();
+        for (int i = 0; i < count; ++i)
+        {
+            map.build_add(i * 7, "val_" + std::to_string(i));
+        }
+        map.build_end();
+        return map;
+    }
+};
+
+TEST_F(FrozenHashMapTest, BuildFromFlatKeyOrderMap)
+{
+    const SourceMap source = MakeSource(1000);
+    TestMap map(source);
+
+    EXPECT_EQ(AoL::GetContainerSize(map), 1000);
+    for (const auto& item : source)
+    {
+        ASSERT_NE(map.find(item.first), nullptr);
+        EXPECT_EQ(map[item.first], item.second);
+    }
+    EXPECT_EQ(map.find(1), nullptr);
+    EXPECT_FALSE(map.contains(-7));
+    EXPECT_EQ(map.at_ptr(7000), nullptr);
+}
+
+TEST_F(FrozenHashMapTest, EverySlotHoldsOneKey)
+{
+    // Minimal: n keys in n slots, each key at the slot its hash leads to
+    TestMap map(MakeSource(4096));
+
+    std::vector<bool> seen(4096, false);
+    for (const auto& item : map)
+    {
+        ASSERT_EQ(item.first % 7, 0);
+        EXPECT_FALSE(seen[item.first / 7]);
+        seen[item.first / 7] = true;
+        EXPECT_EQ(map.find(item.first), &item);
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), 4096);
+}
+
+TEST_F(FrozenHashMapTest, BuildFromRangeAndMovedMap)
+{
+    std::vector<AoL::FlatKeyOrderMapPair<int, std::string>> pairs{ { 3, "three" }, { 1, "one" }, { 2, "two" } };
+    TestMap from_range(pairs.begin(), pairs.end());
+    EXPECT_EQ(AoL::GetContainerSize(from_range), 3);
+    EXPECT_EQ(from_range[2], "two");
+
+    SourceMap source = MakeSource(100);
+    source.erase(14);
+    TestMap from_moved(std::move(source));
+    EXPECT_EQ(AoL::GetContainerSize(from_moved), 99);
+    EXPECT_FALSE(from_moved.contains(14));
+    EXPECT_EQ(from_moved[21], "val_3");
+
+    from_moved[21] = "changed";
+    EXPECT_EQ(from_moved[21], "changed");
+}
+
+TEST_F(FrozenHashMapTest, BuildFromConstMapWithErasedKeys)
+{
+    SourceMap source = MakeSource(16);
+    source.erase(21);
+    const SourceMap& const_source = source;
+    TestMap map(const_source);
+
+    EXPECT_EQ(AoL::GetContainerSize(map), 15);
+    EXPECT_FALSE(map.contains(21));
+    EXPECT_EQ(map[14], "val_2");
+}
+
+TEST_F(FrozenHashMapTest, EmptyMap)
+{
+    TestMap map;
+    EXPECT_TRUE(AoL::IsContainerEmpty(map));
+    EXPECT_EQ(map.find(0), nullptr);
+
+    TestMap from_empty(SourceMap{ });
+    EXPECT_TRUE(AoL::IsContainerEmpty(from_empty));
+    EXPECT_FALSE(from_empty.contains(0));
+}
+
+TEST_F(FrozenHashMapTest, SerializationRoundTrip)
+{
+    const TestMap map(MakeSource(1000));
+    std::stringstream stream;
+    {
+        cereal::BinaryOutputArchive archive(stream);
+        archive(map, TestMap{ });
+    }
+
+    TestMap loaded;
+    TestMap loaded_empty(MakeSource(10));
+    {
+        cereal::BinaryInputArchive archive(stream);
+        archive(loaded, loaded_empty);
+    }
+    EXPECT_EQ(AoL::GetContainerSize(loaded), 1000);
+    EXPECT_EQ(loaded.seed, map.seed);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_NE(loaded.find(i * 7), nullptr);
+        EXPECT_EQ(loaded[i * 7], "val_" + std::to_string(i));
+    }
+
+    // Missing keys: between, below and above the stored ones
+    for (int key : { 1, 13, 6995, -7, 7000, 123456 })
+    {
+        EXPECT_EQ(loaded.find(key), nullptr) << "key = " << key;
+    }
+    EXPECT_TRUE(AoL::IsContainerEmpty(loaded_empty));
+    EXPECT_FALSE(loaded_empty.contains(0));
+}
+
+TEST_F(FrozenHashMapTest, LoadRejectsMismatchedPilots)
+{
+    TestMap map(MakeSource(100));
+    map.pilots_obj.pop_back();
+    std::stringstream stream;
+    {
+        cereal::BinaryOutputArchive archive(stream);
+        archive(map);
+    }
+
+    // Left empty, not with pilots find() would read past
+    TestMap loaded(MakeSource(10));
+    cereal::BinaryInputArchive archive(stream);
+    EXPECT_THROW(archive(loaded), cereal::Exception);
+    EXPECT_TRUE(AoL::IsContainerEmpty(loaded));
+    EXPECT_EQ(loaded.find(7), nullptr);
+}
+
 // ===================================================================
 // INSERT-ORDERED MAP TESTS
 // ===================================================================
@@ -15,7 +15,18 @@
 #include "types.h"
 
 #include "internal/algorithms/find.h"
+#include "internal/algorithms/eytzinger.h"
+#include "internal/algorithms/static-btree.h"
+#include "internal/algorithms/learned-index.h"
+#include "internal/algorithms/parallel-sort.h"
+#include "internal/algorithms/sorting-network.h"
+#include "internal/algorithms/vectorized-sort.h"
 #include "internal/algorithms/sort.h"
+#include "internal/algorithms/adaptive-sort.h"
+#include "internal/algorithms/merge.h"
+#include "internal/algorithms/top-k.h"
+#include "internal/algorithms/external-sort.h"
+#include "internal/algorithms/radix-sort.h"
 
 
 #endif // AOL_HEADER_ALGORITHMS_H
\ No newline at end of file
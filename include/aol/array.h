@@ -337,7 +337,7 @@ struct AOL_EMPTY_BASE_OPTIMIZATION ArrayNamedBase : public ArrayNamedSize<S>
     AOL_ATTRIB_NO_DISCARD constexpr const_reference operator [] (SizeT idx) const noexcept
     {
         assert(idx < S && "Invalid array access!");
-        return static_cast<Derived*>(this)->data_arr[idx];
+        return static_cast<const Derived*>(this)->data_arr[idx];
     }
 
     AOL_ATTRIB_NO_DISCARD constexpr auto begin() noexcept
@@ -347,12 +347,12 @@ struct AOL_EMPTY_BASE_OPTIMIZATION ArrayNamedBase : public ArrayNamedSize<S>
 
     AOL_ATTRIB_NO_DISCARD constexpr auto begin() const noexcept
     {
-        return const_iterator{ static_cast<Derived*>(this)->data_arr };
+        return const_iterator{ static_cast<const Derived*>(this)->data_arr };
     }
 
     AOL_ATTRIB_NO_DISCARD constexpr auto cbegin() const noexcept
     {
-        return const_iterator{ static_cast<Derived*>(this)->data_arr };
+        return const_iterator{ static_cast<const Derived*>(this)->data_arr };
     }
 
     AOL_ATTRIB_NO_DISCARD constexpr auto end() noexcept
@@ -362,12 +362,12 @@ struct AOL_EMPTY_BASE_OPTIMIZATION ArrayNamedBase : public ArrayNamedSize<S>
 
     AOL_ATTRIB_NO_DISCARD constexpr auto end() const noexcept
     {
-        return const_iterator{ static_cast<Derived*>(this)->data_arr, S };
+        return const_iterator{ static_cast<const Derived*>(this)->data_arr, S };
     }
 
     AOL_ATTRIB_NO_DISCARD constexpr auto cend() const noexcept
     {
-        return const_iterator{ static_cast<Derived*>(this)->data_arr, S };
+        return const_iterator{ static_cast<const Derived*>(this)->data_arr, S };
     }
 
     AOL_ATTRIB_NO_DISCARD constexpr auto rbegin() noexcept
@@ -377,12 +377,12 @@ struct AOL_EMPTY_BASE_OPTIMIZATION ArrayNamedBase : public ArrayNamedSize<S>
 
     AOL_ATTRIB_NO_DISCARD constexpr auto rbegin() const noexcept
     {
-        return const_reverse_iterator{ this->cend };
+        return const_reverse_iterator{ this->cend() };
     }
 
     AOL_ATTRIB_NO_DISCARD constexpr auto crbegin() const noexcept
     {
-        return const_reverse_iterator{ this->cend };
+        return const_reverse_iterator{ this->cend() };
     }
 
     AOL_ATTRIB_NO_DISCARD constexpr auto rend() noexcept
@@ -273,6 +273,26 @@
 #define AOL_CONFIG_FLAG_USE_UNORDERED_DENSE_HASH
 
 
+/*********************************************************************
+* ALGORITHMS
+/********************************************************************/
+
+/***************************************
+* Lower Bound
+****************************************/
+
+/**
+* This makes FindLowerBound use a fixed cutoff, in bytes of the searched range, up to which the range is
+* scanned linearly with SIMD compares instead of binary searched
+*
+* - By default, the cutoff is measured once by a short calibration run on the first FindLowerBound call
+*   (see AoL::CalibrateFindLowerBoundLinearCutoff())
+*
+* - Define this to skip the calibration, 128 fits AVX2 builds and 64 fits SSE2 builds. 0 disables the linear scan
+*/
+//#define AOL_CONFIG_FIND_LOWER_BOUND_LINEAR_CUTOFF_BYTES 128
+
+
 /*********************************************************************
 * RANDOM
 /********************************************************************/
@@ -13,6 +13,7 @@
 #include "types.h"
 #include "hashes.h"
 #include "allocators.h"
+#include "internal/containers/frozen-hash-map.h"
 
 #if defined(AOL_CONFIG_FLAG_USE_STD_UNORDERED_MAP)
 #include <unordered_map>
@@ -112,6 +113,53 @@ template<
 >
 using HashMapPool = HashMap<K, V, H, P, A>;
 
+/**
+* @details Read only hash map with a minimal perfect hash, built once from a FlatKeyOrderMap or a range of pairs
+*
+* - A lookup is one hash and one probe, no collisions to walk and no binary search
+*
+* - No insert or erase, values can still be changed in place
+*
+* - Serializable through include/aol/serialization.h, the build is not repeated on load,
+*   an archive whose pilot count does not match its slot count throws cereal::Exception
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam H Hash class/function (default: ankerl::unordered_dense::hash<K>)
+* @tparam P Key-value pair type (default: Internal::KeyValuePairEx<K,V>, the FlatKeyOrderMap pair)
+* @tparam A Allocator type (default: Internal::DefaultAllocator<P>)
+*/
+template<
+	typename K,
+	typename V,
+	typename H = Internal::DefaultHash<K>,
+	typename P = Internal::KeyValuePairEx<K, V>,
+	typename A = DefaultAllocator<P>
+>
+using FrozenHashMap = Internal::FrozenHashMapEx<K, V, P, H, A>;
+
+/**
+* @details FrozenHashMap but specialized for pool allocators
+*
+* - Default pool allocator is backed by mimalloc
+*
+* - Internally operates on `mi_heap_t`
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam H Hash class/function (default: ankerl::unordered_dense::hash<K>)
+* @tparam P Key-value pair type (default: Internal::KeyValuePairEx<K,V>)
+* @tparam A Allocator type (default: Internal::DefaultPoolAllocator<P>)
+*/
+template<
+	typename K,
+	typename V,
+	typename H = Internal::DefaultHash<K>,
+	typename P = Internal::KeyValuePairEx<K, V>,
+	typename A = DefaultPoolAllocator<P>
+>
+using FrozenHashMapPool = Internal::FrozenHashMapEx<K, V, P, H, A>;
+
 }
 
 
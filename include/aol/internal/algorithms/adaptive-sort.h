@@ -0,0 +1,286 @@
+/***************************************************************************************
+* Algorithm Adaptive Sort Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_ADAPTIVE_SORT_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_ADAPTIVE_SORT_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/algorithms/sort.h"
+
+#include <algorithm>	// std::upper_bound, std::lower_bound, std::reverse, std::move, std::move_backward
+#include <cassert>		// assert
+#include <functional>	// std::less
+#include <iterator>		// std::random_access_iterator, std::iter_value_t, std::make_move_iterator
+#include <utility>		// std::move
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Below this range size, SortAdaptive does not look for runs
+inline constexpr SizeT adaptive_sort_cutoff = 64;
+
+// Shorter runs are not worth a merge, consecutive ones are gathered and sorted together by the fallback sort
+inline constexpr SizeT adaptive_sort_min_run = 32;
+
+// Run on the powersort merge stack: its start, and the power of the boundary with the run after it
+struct AdaptiveSortRun
+{
+	SizeT begin;
+	U32 power;
+};
+
+/**
+* @details Powersort node power of the boundary between two neighbour runs
+*
+* - The midpoints of both runs as fractions of the range, the power is the first bit where their binary expansions differ
+*
+* - Runs are merged while the run below on the stack has a greater power, which keeps the merge tree close to
+*   the optimal one for the run lengths
+*/
+constexpr U32 AdaptiveSortPower(SizeT begin, SizeT left_count, SizeT right_count, SizeT count) noexcept
+{
+	const U64 scale = U64{ 2 } * count;
+	U64 left_mid = U64{ 2 } * begin + left_count;
+	U64 right_mid = left_mid + left_count + right_count;
+	U32 power = 0;
+	while (true)
+	{
+		++power;
+		left_mid <<= 1;
+		right_mid <<= 1;
+		if (left_mid >= scale)
+		{
+			left_mid -= scale;
+			right_mid -= scale;
+		}
+		else if (right_mid >= scale)
+		{
+			return power;
+		}
+	}
+}
+
+/**
+* @details Finds the runs of a range, returns their boundaries (0, ..., count)
+*
+* - Non-descending runs are kept, strictly descending ones are reversed
+*
+* - Consecutive runs under adaptive_sort_min_run elements are gathered into one block sorted by fallback,
+*   so random input ends as a single block sorted by fallback alone
+*/
+template<std::random_access_iterator It, typename Comparator, typename Fallback>
+constexpr AoL::Vector<SizeT> AdaptiveSortFindRuns(It it_begin, It it_end, Comparator& compare, Fallback& fallback)
+{
+	const SizeT count = static_cast<SizeT>(it_end - it_begin);
+	AoL::Vector<SizeT> bounds;
+	bounds.push_back(0);
+
+	SizeT block_begin = 0;
+	bool block_open = false;
+	const auto close_block = [&](SizeT block_end)
+	{
+		if (block_open)
+		{
+			fallback(it_begin + static_cast<PtrDiff>(block_begin), it_begin + static_cast<PtrDiff>(block_end));
+			bounds.push_back(block_end);
+			block_open = false;
+		}
+	};
+
+	SizeT run_begin = 0;
+	while (run_begin < count)
+	{
+		SizeT run_end = run_begin + 1;
+		if (run_end < count && compare(it_begin[static_cast<PtrDiff>(run_end)], it_begin[static_cast<PtrDiff>(run_end - 1)]))
+		{
+			while (run_end < count && compare(it_begin[static_cast<PtrDiff>(run_end)], it_begin[static_cast<PtrDiff>(run_end - 1)]))
+			{
+				++run_end;
+			}
+			if (run_end - run_begin >= adaptive_sort_min_run)
+			{
+				std::reverse(it_begin + static_cast<PtrDiff>(run_begin), it_begin + static_cast<PtrDiff>(run_end));
+			}
+		}
+		else
+		{
+			while (run_end < count && !compare(it_begin[static_cast<PtrDiff>(run_end)], it_begin[static_cast<PtrDiff>(run_end - 1)]))
+			{
+				++run_end;
+			}
+		}
+
+		if (run_end - run_begin >= adaptive_sort_min_run)
+		{
+			close_block(run_begin);
+			bounds.push_back(run_end);
+		}
+		else if (!block_open)
+		{
+			block_begin = run_begin;
+			block_open = true;
+		}
+		run_begin = run_end;
+	}
+	close_block(count);
+	return bounds;
+}
+
+/**
+* @details Merges the neighbour sorted runs [it_begin, it_mid) and [it_mid, it_end) in place
+*
+* - Left elements not greater than the right head, and right elements not less than the left tail, are already
+*   in place and skipped with binary searches
+*
+* - The shorter of what remains is moved into buffer and merged from its end of the range
+*
+* - The right run must not be empty, its head is read first
+*/
+template<std::random_access_iterator It, typename Comparator>
+constexpr void AdaptiveSortMerge(It it_begin, It it_mid, It it_end, AoL::Vector<std::iter_value_t<It>>& buffer, Comparator& compare)
+{
+	assert(it_mid != it_end && "Empty right run!");
+	it_begin = std::upper_bound(it_begin, it_mid, *it_mid, compare);
+	if (it_begin == it_mid)
+	{
+		return;
+	}
+	it_end = std::lower_bound(it_mid, it_end, *(it_mid - 1), compare);
+
+	if (it_mid - it_begin <= it_end - it_mid)
+	{
+		buffer.assign(std::make_move_iterator(it_begin), std::make_move_iterator(it_mid));
+		auto it_left = buffer.begin();
+		It it_right = it_mid;
+		It it_out = it_begin;
+		while (it_left != buffer.end() && it_right != it_end)
+		{
+			if (compare(*it_right, *it_left))
+			{
+				*it_out = std::move(*it_right);
+				++it_right;
+			}
+			else
+			{
+				*it_out = std::move(*it_left);
+				++it_left;
+			}
+			++it_out;
+		}
+		std::move(it_left, buffer.end(), it_out);
+	}
+	else
+	{
+		buffer.assign(std::make_move_iterator(it_mid), std::make_move_iterator(it_end));
+		auto it_right = buffer.end();
+		It it_left = it_mid;
+		It it_out = it_end;
+		while (it_right != buffer.begin() && it_left != it_begin)
+		{
+			if (compare(*(it_right - 1), *(it_left - 1)))
+			{
+				*--it_out = std::move(*--it_left);
+			}
+			else
+			{
+				*--it_out = std::move(*--it_right);
+			}
+		}
+		std::move_backward(buffer.begin(), it_right, it_out);
+	}
+	buffer.clear();
+}
+
+/**
+* @details Adaptive sort with the sort used on unordered blocks
+*
+* - Runs are found by AdaptiveSortFindRuns and merged in powersort order
+*
+* - fallback(it_first, it_last) must sort its range in compare order
+*/
+template<std::random_access_iterator It, typename Comparator, typename Fallback>
+constexpr void SortAdaptive(It it_begin, It it_end, Comparator& compare, Fallback fallback)
+{
+	const SizeT count = static_cast<SizeT>(it_end - it_begin);
+	if (count < adaptive_sort_cutoff)
+	{
+		fallback(it_begin, it_end);
+		return;
+	}
+
+	const AoL::Vector<SizeT> bounds = AdaptiveSortFindRuns(it_begin, it_end, compare, fallback);
+	if (bounds.size() <= 2)
+	{
+		return;
+	}
+
+	AoL::Vector<std::iter_value_t<It>> buffer;
+	AoL::Vector<AdaptiveSortRun> stack;
+
+	// Current run [run_begin, run_end), the runs under it on the stack end where the next one starts
+	SizeT run_begin = bounds[0];
+	for (SizeT i = 1; i + 1 < bounds.size(); ++i)
+	{
+		const SizeT run_end = bounds[i];
+		const SizeT next_end = bounds[i + 1];
+		const U32 power = AdaptiveSortPower(run_begin, run_end - run_begin, next_end - run_end, count);
+		while (!stack.empty() && stack.back().power > power)
+		{
+			const SizeT left_begin = stack.back().begin;
+			stack.pop_back();
+			AdaptiveSortMerge(it_begin + static_cast<PtrDiff>(left_begin), it_begin + static_cast<PtrDiff>(run_begin), it_begin + static_cast<PtrDiff>(run_end), buffer, compare);
+			run_begin = left_begin;
+		}
+		stack.push_back({ run_begin, power });
+		run_begin = run_end;
+	}
+	while (!stack.empty())
+	{
+		const SizeT left_begin = stack.back().begin;
+		stack.pop_back();
+		AdaptiveSortMerge(it_begin + static_cast<PtrDiff>(left_begin), it_begin + static_cast<PtrDiff>(run_begin), it_end, buffer, compare);
+		run_begin = left_begin;
+	}
+}
+
+} // Internal namespace
+
+/**
+* @details Adaptive sort: finds the runs already in the range and merges them (powersort, like TimSort)
+*
+* - Sorted input, a sorted range with a few elements appended or inserted, and concatenations of sorted ranges
+*   are sorted in close to O(n)
+*
+* - Non-descending runs are kept, strictly descending ones reversed, runs under 32 elements are gathered into
+*   blocks sorted with Sort, so random input costs one Sort and one scan
+*
+* - Not stable: equal elements in a block sorted by Sort can change their order
+*
+* @tparam It random access iterator type (can be a pointer)
+* @tparam Comparator comparison type (default: std::less)
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param compare comparison function
+*/
+template<std::random_access_iterator It, typename Comparator = std::less<>>
+constexpr void SortAdaptive(It it_begin, It it_end, Comparator compare = Comparator{})
+{
+	Internal::SortAdaptive(it_begin, it_end, compare, [&compare](It it_first, It it_last)
+	{
+		Sort(it_first, it_last, compare);
+	});
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_ADAPTIVE_SORT_H
@@ -0,0 +1,595 @@
+/***************************************************************************************
+* Algorithm External Sort Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_EXTERNAL_SORT_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_EXTERNAL_SORT_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/algorithms/merge.h"
+#include "aol/internal/algorithms/sort.h"
+
+#include <algorithm>	// std::copy, std::min, std::max, std::upper_bound
+#include <cerrno>		// errno
+#include <chrono>		// std::chrono::steady_clock
+#include <cstdint>		// std::uintptr_t, std::uintmax_t
+#include <filesystem>	// std::filesystem::path, std::filesystem::filesystem_error, std::filesystem::file_size, std::filesystem::remove
+#include <fstream>		// std::ifstream, std::ofstream
+#include <functional>	// std::less
+#include <future>		// std::async, std::future
+#include <iterator>		// std::input_iterator
+#include <memory>		// std::unique_ptr, std::make_unique
+#include <string>		// std::to_string
+#include <system_error>	// std::error_code, std::errc, std::generic_category
+#include <type_traits>	// std::is_trivially_copyable_v
+#include <utility>		// std::move, std::swap
+#include <vector>		// std::erase_if
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Smallest block read or written at once by the merge
+inline constexpr SizeT external_sort_min_block_bytes = SizeT{ 1 } << 16;
+
+// Merge memory per run, in blocks: the block being merged, the block being read and a share of the two output blocks
+inline constexpr SizeT external_sort_blocks_per_run = 4;
+
+// File errors are std::filesystem::filesystem_error, the files are std streams
+[[noreturn]] inline void ExternalSortThrowOpen(const std::filesystem::path& path)
+{
+	const std::error_code error = errno != 0 ? std::error_code{ errno, std::generic_category() } : std::make_error_code(std::errc::io_error);
+	throw std::filesystem::filesystem_error("AoL external sort: failed to open file", path, error);
+}
+
+[[noreturn]] inline void ExternalSortThrowIO(const std::filesystem::path& path, std::errc error)
+{
+	throw std::filesystem::filesystem_error("AoL external sort: failed to read or write file", path, std::make_error_code(error));
+}
+
+// Fixed size records that can be written to and read back from a file as raw bytes
+template<typename T>
+concept ExternalSortRecord = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+
+// Records of a file read front to back
+template<ExternalSortRecord T>
+class ExternalSortFileReader
+{
+public:
+	explicit ExternalSortFileReader(const std::filesystem::path& file_path) :
+		path{ file_path },
+		file{ file_path, std::ios::binary },
+		remaining{ 0 }
+	{
+		if (!file)
+		{
+			ExternalSortThrowOpen(path);
+		}
+
+		std::error_code error;
+		const std::uintmax_t size = std::filesystem::file_size(path, error);
+		if (error || size % sizeof(T) != 0)
+		{
+			// Not a whole number of records
+			ExternalSortThrowIO(path, std::errc::invalid_argument);
+		}
+		remaining = static_cast<SizeT>(size / sizeof(T));
+	}
+
+	AOL_ATTRIB_NO_DISCARD SizeT remaining_count() const noexcept
+	{
+		return remaining;
+	}
+
+	// Reads up to count records, returns how many were read
+	SizeT Read(T* p_records, SizeT count)
+	{
+		count = std::min(count, remaining);
+		file.read(reinterpret_cast<char*>(p_records), static_cast<std::streamsize>(count * sizeof(T)));
+		if (static_cast<SizeT>(file.gcount()) != count * sizeof(T))
+		{
+			ExternalSortThrowIO(path, std::errc::io_error);
+		}
+		remaining -= count;
+		return count;
+	}
+
+private:
+	std::filesystem::path path;
+	std::ifstream file;
+	SizeT remaining;
+};
+
+// Records of a file written front to back
+template<ExternalSortRecord T>
+class ExternalSortFileWriter
+{
+public:
+	explicit ExternalSortFileWriter(const std::filesystem::path& file_path) :
+		path{ file_path },
+		file{ file_path, std::ios::binary | std::ios::trunc }
+	{
+		if (!file)
+		{
+			ExternalSortThrowOpen(path);
+		}
+	}
+
+	void Write(const T* p_records, SizeT count)
+	{
+		file.write(reinterpret_cast<const char*>(p_records), static_cast<std::streamsize>(count * sizeof(T)));
+		if (!file)
+		{
+			ExternalSortThrowIO(path, std::errc::io_error);
+		}
+	}
+
+	void Close()
+	{
+		file.close();
+		if (!file)
+		{
+			ExternalSortThrowIO(path, std::errc::io_error);
+		}
+	}
+
+private:
+	std::filesystem::path path;
+	std::ofstream file;
+};
+
+/**
+* @details Double buffered reader of a sorted run
+*
+* - While the merge consumes the current block, the next one is read by an async task
+*
+* - Pinned in memory: the pending read writes to its own block
+*/
+template<ExternalSortRecord T>
+class ExternalSortRunReader
+{
+public:
+	ExternalSortRunReader(const std::filesystem::path& file_path, SizeT block_size) :
+		reader{ file_path },
+		blocks{ AoL::Vector<T>(block_size), AoL::Vector<T>(block_size) },
+		current{ 0 },
+		p_cursor{ nullptr },
+		p_end{ nullptr },
+		pending{ }
+	{
+		const SizeT count = reader.Read(blocks[0].data(), block_size);
+		p_cursor = blocks[0].data();
+		p_end = p_cursor + count;
+		Prefetch();
+	}
+
+	ExternalSortRunReader(const ExternalSortRunReader&) = delete;
+	ExternalSortRunReader& operator = (const ExternalSortRunReader&) = delete;
+
+	AOL_ATTRIB_NO_DISCARD bool empty() const noexcept
+	{
+		return p_cursor == p_end;
+	}
+
+	// Unmerged records of the current block
+	AOL_ATTRIB_NO_DISCARD T* begin() const noexcept
+	{
+		return p_cursor;
+	}
+
+	AOL_ATTRIB_NO_DISCARD T* end() const noexcept
+	{
+		return p_end;
+	}
+
+	// Records up to p_new_cursor were merged, moves to the next block once the current one is done
+	void Consume(T* p_new_cursor)
+	{
+		p_cursor = p_new_cursor;
+		if (p_cursor != p_end)
+		{
+			return;
+		}
+
+		if (pending.valid())
+		{
+			const SizeT count = pending.get();
+			current ^= 1;
+			p_cursor = blocks[current].data();
+			p_end = p_cursor + count;
+			Prefetch();
+		}
+	}
+
+private:
+	void Prefetch()
+	{
+		if (reader.remaining_count() != 0)
+		{
+			pending = std::async(std::launch::async, [this, p_block = blocks[current ^ 1].data(), size = blocks[current ^ 1].size()]()
+			{
+				return reader.Read(p_block, size);
+			});
+		}
+	}
+
+	ExternalSortFileReader<T> reader;
+	AoL::Vector<T> blocks[2];
+	SizeT current;
+	T* p_cursor;
+	T* p_end;
+	// Last member: destroyed first, waits for the read in flight
+	std::future<SizeT> pending;
+};
+
+// Double buffered file output of the merge: a full block is written by an async task while the next one is merged
+template<ExternalSortRecord T>
+class ExternalSortFileSink
+{
+public:
+	explicit ExternalSortFileSink(const std::filesystem::path& file_path) :
+		writer{ file_path },
+		blocks{ },
+		current{ 0 },
+		pending{ }
+	{
+	}
+
+	ExternalSortFileSink(const ExternalSortFileSink&) = delete;
+	ExternalSortFileSink& operator = (const ExternalSortFileSink&) = delete;
+
+	// Block the merge fills
+	AOL_ATTRIB_NO_DISCARD AoL::Vector<T>& block() noexcept
+	{
+		return blocks[current];
+	}
+
+	void Flush()
+	{
+		if (pending.valid())
+		{
+			pending.get();
+		}
+		pending = std::async(std::launch::async, [this, p_block = &blocks[current]]()
+		{
+			writer.Write(p_block->data(), p_block->size());
+		});
+		current ^= 1;
+	}
+
+	void Close()
+	{
+		if (pending.valid())
+		{
+			pending.get();
+		}
+		writer.Close();
+	}
+
+private:
+	ExternalSortFileWriter<T> writer;
+	AoL::Vector<T> blocks[2];
+	SizeT current;
+	std::future<void> pending;
+};
+
+// Output iterator output of the merge
+template<ExternalSortRecord T, typename Out>
+class ExternalSortIteratorSink
+{
+public:
+	explicit ExternalSortIteratorSink(Out output) :
+		out{ output },
+		buffer{ }
+	{
+	}
+
+	AOL_ATTRIB_NO_DISCARD AoL::Vector<T>& block() noexcept
+	{
+		return buffer;
+	}
+
+	void Flush()
+	{
+		out = std::copy(buffer.begin(), buffer.end(), out);
+	}
+
+	AOL_ATTRIB_NO_DISCARD Out output() const
+	{
+		return out;
+	}
+
+private:
+	Out out;
+	AoL::Vector<T> buffer;
+};
+
+/**
+* @details K-way merge of runs read block by block
+*
+* - Every record not greater than the smallest last record of the loaded blocks is already loaded in its run,
+*   so each step merges all of them with a loser tree and hands them to the sink in one block
+*
+* - The run whose block ends at that bound consumes its whole block, every step moves at least one block forward
+*/
+template<ExternalSortRecord T, typename Comparator, typename Sink>
+void ExternalSortMerge(AoL::Vector<std::unique_ptr<ExternalSortRunReader<T>>>& readers, Comparator& compare, Sink& sink)
+{
+	AoL::Vector<MergeRun<T*>> runs;
+	AoL::Vector<T*> splits;
+	for (;;)
+	{
+		std::erase_if(readers, [](const std::unique_ptr<ExternalSortRunReader<T>>& reader) { return reader->empty(); });
+		if (readers.empty())
+		{
+			return;
+		}
+
+		const T* p_bound = readers[0]->end() - 1;
+		for (const auto& reader : readers)
+		{
+			if (compare(*(reader->end() - 1), *p_bound))
+			{
+				p_bound = reader->end() - 1;
+			}
+		}
+
+		runs.clear();
+		splits.clear();
+		SizeT count = 0;
+		for (const auto& reader : readers)
+		{
+			T* p_split = std::upper_bound(reader->begin(), reader->end(), *p_bound, compare);
+			runs.push_back({ reader->begin(), p_split });
+			splits.push_back(p_split);
+			count += static_cast<SizeT>(p_split - reader->begin());
+		}
+
+		AoL::Vector<T>& block = sink.block();
+		block.resize(count);
+		LoserTreeMerge(runs.data(), runs.size(), block.data(), compare);
+		sink.Flush();
+
+		for (SizeT run = 0; run < readers.size(); ++run)
+		{
+			readers[run]->Consume(splits[run]);
+		}
+	}
+}
+
+/**
+* @details Run generation and merge passes of an external merge sort
+*
+* - Records are gathered in a chunk of the memory budget, every full chunk is sorted with Sort and spilled
+*   to a run file in the temp directory
+*
+* - Runs are merged by ExternalSortMerge with blocks sized so every run fits the budget, when there are
+*   more runs than that, earlier runs are merged into longer ones first
+*
+* - Run files are removed as soon as they are merged, and by the destructor on error
+*/
+template<ExternalSortRecord T, typename Comparator>
+class ExternalSorter
+{
+public:
+	ExternalSorter(SizeT memory_bytes, Comparator& comparator, const std::filesystem::path& directory) :
+		compare{ comparator },
+		temp_directory{ directory },
+		memory{ std::max(memory_bytes, external_sort_blocks_per_run * 2 * external_sort_min_block_bytes) },
+		chunk{ },
+		runs{ },
+		run_counter{ 0 },
+		file_prefix{ "aol-external-sort-" + std::to_string(reinterpret_cast<std::uintptr_t>(this) ^
+			static_cast<std::uintptr_t>(std::chrono::steady_clock::now().time_since_epoch().count())) + "-" }
+	{
+		chunk.reserve(chunk_capacity());
+	}
+
+	ExternalSorter(const ExternalSorter&) = delete;
+	ExternalSorter& operator = (const ExternalSorter&) = delete;
+
+	~ExternalSorter()
+	{
+		for (const std::filesystem::path& run : runs)
+		{
+			std::error_code error;
+			std::filesystem::remove(run, error);
+		}
+	}
+
+	AOL_ATTRIB_NO_DISCARD SizeT chunk_capacity() const noexcept
+	{
+		return std::max<SizeT>(1, memory / sizeof(T));
+	}
+
+	// Chunk the records are gathered in, Spill() once it holds chunk_capacity() records
+	AOL_ATTRIB_NO_DISCARD AoL::Vector<T>& chunk_records() noexcept
+	{
+		return chunk;
+	}
+
+	// Sorts the chunk and writes it to a new run file
+	void Spill()
+	{
+		Sort(chunk.begin(), chunk.end(), compare);
+		runs.push_back(NewRunPath());
+		ExternalSortFileWriter<T> writer(runs.back());
+		writer.Write(chunk.data(), chunk.size());
+		writer.Close();
+		chunk.clear();
+	}
+
+	// Sorts everything pushed so far to the sink
+	template<typename Sink>
+	void Finish(Sink& sink)
+	{
+		// Everything fit in memory
+		if (runs.empty())
+		{
+			Sort(chunk.begin(), chunk.end(), compare);
+			std::swap(sink.block(), chunk);
+			sink.Flush();
+			return;
+		}
+
+		if (!chunk.empty())
+		{
+			Spill();
+		}
+		AoL::Vector<T>().swap(chunk);
+
+		const SizeT max_fan_in = std::max<SizeT>(2, memory / (external_sort_blocks_per_run * external_sort_min_block_bytes));
+		while (runs.size() > max_fan_in)
+		{
+			AoL::Vector<std::filesystem::path> inputs(runs.begin(), runs.begin() + static_cast<PtrDiff>(max_fan_in));
+			runs.erase(runs.begin(), runs.begin() + static_cast<PtrDiff>(max_fan_in));
+			runs.push_back(NewRunPath());
+
+			ExternalSortFileSink<T> run_sink(runs.back());
+			MergeRuns(inputs, run_sink);
+			run_sink.Close();
+		}
+
+		AoL::Vector<std::filesystem::path> inputs = std::move(runs);
+		runs.clear();
+		MergeRuns(inputs, sink);
+	}
+
+private:
+	std::filesystem::path NewRunPath()
+	{
+		return temp_directory / (file_prefix + std::to_string(run_counter++) + ".run");
+	}
+
+	// Merges the input runs to the sink, then removes them
+	template<typename Sink>
+	void MergeRuns(AoL::Vector<std::filesystem::path>& inputs, Sink& sink)
+	{
+		const SizeT block_bytes = std::max(external_sort_min_block_bytes, memory / (external_sort_blocks_per_run * inputs.size()));
+		const SizeT block_size = std::max<SizeT>(1, block_bytes / sizeof(T));
+		{
+			AoL::Vector<std::unique_ptr<ExternalSortRunReader<T>>> readers;
+			readers.reserve(inputs.size());
+			for (const std::filesystem::path& input : inputs)
+			{
+				readers.push_back(std::make_unique<ExternalSortRunReader<T>>(input, block_size));
+			}
+			ExternalSortMerge(readers, compare, sink);
+		}
+		for (const std::filesystem::path& input : inputs)
+		{
+			std::error_code error;
+			std::filesystem::remove(input, error);
+		}
+	}
+
+	Comparator& compare;
+	std::filesystem::path temp_directory;
+	SizeT memory;
+	AoL::Vector<T> chunk;
+	AoL::Vector<std::filesystem::path> runs;
+	SizeT run_counter;
+	std::string file_prefix;
+};
+
+} // Internal namespace
+
+/**
+* @details External merge sort of a file of fixed size records, for files larger than the memory
+*
+* - The input is read in chunks of the memory budget, every chunk is sorted with Sort and spilled to a temp run file,
+*   then the runs are k-way merged to the output with double buffered reads and writes
+*
+* - A single merge pass up to (memory / 256 KB) runs, i.e. 65536 runs with 16 GB: a 100 GB file sorted with
+*   a 12 GB budget makes 9 runs of 12 GB, merged in 333 MB blocks. More runs are merged in several passes
+*
+* - Records are raw bytes of T, the input size must be a whole number of records. Not stable
+*
+* @tparam T record type, trivially copyable
+* @tparam Comparator comparison type (default: std::less)
+* @param input file to sort
+* @param output sorted file, created or overwritten, must not be the input
+* @param memory_bytes memory budget of the chunks and merge buffers
+* @param compare comparison function
+* @param temp_directory directory of the run files, about the size of the input is needed there
+* @throw std::filesystem::filesystem_error when a file cannot be opened, read or written,
+*   or the input is not a whole number of records (std::errc::invalid_argument)
+*/
+template<Internal::ExternalSortRecord T, typename Comparator = std::less<>>
+void ExternalSortFile(const std::filesystem::path& input, const std::filesystem::path& output, SizeT memory_bytes,
+	Comparator compare = Comparator{}, const std::filesystem::path& temp_directory = std::filesystem::temp_directory_path())
+{
+	Internal::ExternalSorter<T, Comparator> sorter(memory_bytes, compare, temp_directory);
+	{
+		Internal::ExternalSortFileReader<T> reader(input);
+		AoL::Vector<T>& chunk = sorter.chunk_records();
+		while (reader.remaining_count() != 0)
+		{
+			const SizeT size = chunk.size();
+			const SizeT count = std::min(sorter.chunk_capacity() - size, reader.remaining_count());
+			chunk.resize(size + count);
+			reader.Read(chunk.data() + size, count);
+			if (chunk.size() == sorter.chunk_capacity() && reader.remaining_count() != 0)
+			{
+				sorter.Spill();
+			}
+		}
+	}
+
+	Internal::ExternalSortFileSink<T> sink(output);
+	sorter.Finish(sink);
+	sink.Close();
+}
+
+/**
+* @details External merge sort of an input range to an output iterator, for ranges larger than the memory
+*
+* - Same as ExternalSortFile, records come from a single pass over the input and the sorted records
+*   are written to the output in merge blocks
+*
+* @tparam It input iterator type of fixed size records
+* @tparam Out output iterator type
+* @tparam Comparator comparison type (default: std::less)
+* @param it_begin start of the input
+* @param it_end end of the input
+* @param out start of the output
+* @param memory_bytes memory budget of the chunks and merge buffers
+* @param compare comparison function
+* @param temp_directory directory of the run files, about the size of the input is needed there
+* @return end of the output
+* @throw std::filesystem::filesystem_error when a run file cannot be created, read or written
+*/
+template<std::input_iterator It, typename Out, typename Comparator = std::less<>>
+	requires Internal::ExternalSortRecord<std::iter_value_t<It>>
+Out ExternalSort(It it_begin, It it_end, Out out, SizeT memory_bytes,
+	Comparator compare = Comparator{}, const std::filesystem::path& temp_directory = std::filesystem::temp_directory_path())
+{
+	using value_type = std::iter_value_t<It>;
+
+	Internal::ExternalSorter<value_type, Comparator> sorter(memory_bytes, compare, temp_directory);
+	AoL::Vector<value_type>& chunk = sorter.chunk_records();
+	for (; it_begin != it_end; ++it_begin)
+	{
+		if (chunk.size() == sorter.chunk_capacity())
+		{
+			sorter.Spill();
+		}
+		chunk.push_back(*it_begin);
+	}
+
+	Internal::ExternalSortIteratorSink<value_type, Out> sink(out);
+	sorter.Finish(sink);
+	return sink.output();
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_EXTERNAL_SORT_H
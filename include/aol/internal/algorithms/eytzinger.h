@@ -0,0 +1,208 @@
+/***************************************************************************************
+* Algorithm Eytzinger Layout Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_EYTZINGER_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_EYTZINGER_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+
+#include <bit>			// std::countr_one
+#include <cstdint>		// std::uintptr_t
+#include <functional>	// std::less, std::identity, std::invoke
+#include <iterator>		// std::distance
+
+
+namespace AoL
+{
+
+/**
+* @details Sorted keys laid out in Eytzinger (breadth-first) order for cache friendly lower bound searches
+*
+* - Build once from any sorted range, then query with lower_bound() or FindLowerBound(index, ...)
+*
+* - The descent is branch-free and prefetches the descendants four levels ahead, so the memory
+*   latency of deep levels is overlapped with the comparisons of the upper ones
+*
+* - Results are mapped back to positions in the original sorted range
+*
+* - Worth it for large read-mostly tables. For small ranges, FindLowerBound on the range itself is faster
+*
+* @tparam T key type
+* @tparam Comparator comparison predicate (default: std::less<void>)
+*/
+template<
+	typename T,
+	typename Comparator = std::less<void>
+>
+struct EytzingerIndex
+{
+public:
+	using key_type = T;
+	using size_type = SizeT;
+	using container_type = AoL::Vector<T>;
+	using rank_container_type = AoL::Vector<size_type>;
+
+private:
+	// Descendants four levels down from node k live at [16k, 16k + 16)
+	static constexpr size_type prefetch_level_width = 16;
+	static constexpr size_type prefetch_block_bytes = prefetch_level_width * sizeof(T);
+	static constexpr size_type cache_line_bytes = 64;
+
+	AOL_ATTRIB_NO_UNQ_ADDRESS Comparator compare;
+
+public:
+	container_type keys;		// 1-based, keys[0] is unused
+	rank_container_type ranks;	// eytzinger slot -> position in the original sorted range
+
+	EytzingerIndex() noexcept :
+		compare{ },
+		keys{ },
+		ranks{ }
+	{
+	}
+
+	template<typename It, typename Projection = std::identity>
+	explicit EytzingerIndex(It it_begin, It it_end, Projection projection = Projection{}, Comparator comparator = Comparator{}) :
+		compare{ comparator },
+		keys{ },
+		ranks{ }
+	{
+		this->build(it_begin, it_end, projection);
+	}
+
+	/**
+	* @details Rebuilds the index from a sorted range
+	*
+	* - The range must be sorted with respect to Comparator, otherwise, it is UB
+	*
+	* - The projection extracts the key from each element (i.e. &Pair::first for maps)
+	*
+	* @param it_begin start of the sorted range
+	* @param it_end end of the sorted range
+	* @param projection key extraction (default: std::identity)
+	*/
+	template<typename It, typename Projection = std::identity>
+	void build(It it_begin, It it_end, Projection projection = Projection{})
+	{
+		const size_type count = static_cast<size_type>(std::distance(it_begin, it_end));
+
+		keys.clear();
+		ranks.clear();
+		if (count == 0)
+		{
+			return;
+		}
+
+		keys.resize(count + 1);
+		ranks.resize(count + 1);
+
+		// In-order walk of the implicit tree visits the slots in sorted order
+		size_type k = 1;
+		while (2 * k <= count)
+		{
+			k = 2 * k;
+		}
+
+		for (size_type rank = 0; it_begin != it_end; ++it_begin, ++rank)
+		{
+			keys[k] = std::invoke(projection, *it_begin);
+			ranks[k] = rank;
+
+			if (2 * k + 1 <= count)
+			{
+				k = 2 * k + 1;
+				while (2 * k <= count)
+				{
+					k = 2 * k;
+				}
+			}
+			else
+			{
+				k >>= std::countr_one(k) + 1;
+			}
+		}
+	}
+
+	/**
+	* @details Lower bound search on the index
+	*
+	* @tparam K key type
+	* @param value value to be found
+	* @return position of the lower bound in the original sorted range (size() if none)
+	*/
+	template<typename K>
+	AOL_ATTRIB_NO_DISCARD size_type lower_bound(const K& value) const noexcept
+	{
+		Comparator comp = compare;
+		const size_type count = this->size();
+		const T* p_keys = keys.data();
+
+		size_type k = 1;
+		while (k <= count)
+		{
+			Prefetch(p_keys, k * prefetch_level_width);
+			k = 2 * k + static_cast<size_type>(comp(p_keys[k], value));
+		}
+
+		// Drop the trailing right turns and the last left turn to get the answer's slot
+		k >>= std::countr_one(k) + 1;
+		return k == 0 ? count : ranks[k];
+	}
+
+	AOL_ATTRIB_NO_DISCARD size_type size() const noexcept
+	{
+		return keys.empty() ? 0 : keys.size() - 1;
+	}
+
+	AOL_ATTRIB_NO_DISCARD bool empty() const noexcept
+	{
+		return keys.size() <= 1;
+	}
+
+	void clear() noexcept
+	{
+		keys.clear();
+		ranks.clear();
+	}
+
+private:
+	static void Prefetch(const T* p_keys, size_type slot) noexcept
+	{
+		// Address arithmetic done on integers since the slot can be past the end on the last levels
+		const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p_keys) + slot * sizeof(T);
+		for (size_type offset = 0; offset < prefetch_block_bytes; offset += cache_line_bytes)
+		{
+			AOL_MACRO_FUNC_PREFETCH(reinterpret_cast<const void*>(address + offset));
+		}
+	}
+};
+
+/**
+* @details Lower bound algorithm through a prebuilt EytzingerIndex
+*
+* - The index must have been built from [it_begin, it_begin + index.size())
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam T index key type
+* @tparam C index comparator type
+* @tparam K key type
+* @param index prebuilt index of the sorted range
+* @param it_begin start of the sorted range the index was built from
+* @param value value to be found
+* @return iterator to lower bound position for value
+*/
+template<typename It, typename T, typename C, typename K>
+It FindLowerBound(const EytzingerIndex<T, C>& index, It it_begin, const K& value) noexcept
+{
+	return it_begin + index.lower_bound(value);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_EYTZINGER_H
@@ -9,10 +9,22 @@
 #include "aol/macros.h"
 #include "aol/traits.h"
 #include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/algorithms/simd.h"
 
 #include <algorithm>    // std::find
+#include <atomic>       // std::atomic
 #include <bit>          // std::bit_floor, bit_ceil
-#include <utility>      // std::forward
+#include <chrono>       // std::chrono::steady_clock
+#include <concepts>     // std::integral
+#include <cstdlib>      // std::rand
+#include <execution>    // std::is_execution_policy_v
+#include <iterator>     // std::forward_iterator, std::contiguous_iterator, std::iter_value_t, std::next
+#include <limits>       // std::numeric_limits
+#include <memory>       // std::addressof, std::to_address
+#include <random>       // std::uniform_random_bit_generator
+#include <type_traits>  // std::is_constant_evaluated, std::remove_cvref_t
+#include <utility>      // std::forward, std::in_range, std::cmp_less
 #include <functional>   // std::less
 
 
@@ -20,10 +32,26 @@ namespace AoL
 {
 
 // Find a value from a container using brute force
-// - use std::find for custom size container
+// - contiguous ranges of integers and floating points searched with a value of the same type
+//   are scanned with SIMD compares (see AOL_SIMD_*)
+// - use std::find for everything else
 template<typename It, typename T>
 constexpr auto FindBrute(It it_begin, It it_end, T&& val) noexcept
 {
+	if constexpr (std::contiguous_iterator<It>)
+	{
+		using element_t = std::iter_value_t<It>;
+		if constexpr (Internal::Simd::Supported<element_t> && std::is_same_v<std::remove_cvref_t<T>, element_t>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const element_t* p_begin = std::to_address(it_begin);
+				const element_t* p_found = Internal::Simd::FindEqual(p_begin, p_begin + (it_end - it_begin), val);
+				return it_begin + (p_found - p_begin);
+			}
+		}
+	}
+
 	return std::find(it_begin, it_end, std::forward<T>(val));
 }
 
@@ -77,7 +105,8 @@ It FindLowerBoundGeneral(It it_begin, It it_end, const K& value, Comparator comp
 * 
 * - Usually faster than the general one, but always profile it
 *
-* - Upon benchmarking, it became slower than the Eytzinger implementation after 10000 elements
+* - Upon benchmarking (BM_SuiteFindLowerBoundBranchless vs BM_SuiteEytzingerIndex), EytzingerIndex overtakes it
+*   from tens of thousands of elements on cold caches and from millions of elements on hot caches
 *
 * @tparam It iterator type (can be a pointer)
 * @tparam K key type
@@ -123,11 +152,103 @@ constexpr It FindLowerBoundBranchless(It it_begin, It it_end, const K& value, Co
 }
 
 /*
-* @details Random lower bound algorith
+* @details Galloping (exponential) lower bound algorithm
 *
-* - Binary search but random
+* - Probes 1, 2, 4, 8... elements past the hint until it overshoots value, then binary searches the last gap
 *
-* - Can be really fast, can be really slow, depends on your luck
+* - Costs O(log distance) from the hint instead of O(log n), so a sorted batch of keys searched with
+*   the previous result as the hint is close to a linear merge
+*
+* - Only searches forward, the result is never before it_hint
+*
+* - Pays off when consecutive keys land close to each other. Chaining results as hints serializes the searches,
+*   so sparse probes over a huge range are faster as independent FindLowerBound calls
+*
+* - Requires the container to be sorted, otherwise, it is UB
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam K key type
+* @tparam Comparator comparison predicate (default: std::less<void>)
+* @param it_hint position to start searching from
+* @param it_end pointer to container end address
+* @param value value to be found
+* @param compare predicate for < comparison (defaulted to std::less<void>)
+* @return iterator to lower bound position for value in [it_hint, it_end]
+*/
+template<typename It, typename K, typename Comparator = std::less<void>>
+It FindLowerBoundGalloping(It it_hint, It it_end, const K& value, Comparator compare = Comparator{}) noexcept
+{
+    using diff_t = PtrDiff;
+
+    const diff_t length = static_cast<diff_t>(it_end - it_hint);
+
+    // Everything before low is less than value
+    diff_t low = 0;
+    diff_t high = 1;
+    while (high <= length && compare(it_hint[high - 1], value))
+    {
+        low = high;
+        high *= 2;
+    }
+
+    return FindLowerBoundBranchless(it_hint + low, it_hint + (high < length ? high : length), value, compare);
+}
+
+/*
+* @details Bidirectional galloping (exponential) lower bound algorithm
+*
+* - Same as the forward version, but gallops backward toward it_begin when value is not after the hint
+*
+* - Costs O(log distance) from the hint in both directions, any hint in [it_begin, it_end] is valid
+*
+* - Requires the container to be sorted, otherwise, it is UB
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam K key type
+* @tparam Comparator comparison predicate (default: std::less<void>)
+* @param it_begin pointer to container address or start
+* @param it_hint position to start searching from
+* @param it_end pointer to container end address
+* @param value value to be found
+* @param compare predicate for < comparison (defaulted to std::less<void>)
+* @return iterator to lower bound position for value
+*/
+template<typename It, typename K, typename Comparator = std::less<void>>
+It FindLowerBoundGalloping(It it_begin, It it_hint, It it_end, const K& value, Comparator compare = Comparator{}) noexcept
+{
+    using diff_t = PtrDiff;
+
+    if (it_hint != it_end && compare(*it_hint, value))
+    {
+        return FindLowerBoundGalloping(it_hint + 1, it_end, value, compare);
+    }
+
+    const diff_t length = static_cast<diff_t>(it_hint - it_begin);
+
+    // Everything from it_hint - high onward is not less than value
+    diff_t high = 0;
+    diff_t step = 1;
+    while (step <= length && !compare(it_hint[-step], value))
+    {
+        high = step;
+        step *= 2;
+    }
+
+    It it_low = step <= length ? it_hint - step + 1 : it_begin;
+    return FindLowerBoundBranchless(it_low, it_hint - high, value, compare);
+}
+
+/*
+* @details Linear lower bound algorithm
+*
+* - Counts the elements less than value over the whole range, so it never branches on the data
+*
+* - Contiguous ranges of integers and floating points compared with a plain < are counted with SIMD
+*   compares (see AOL_SIMD_*)
+*
+* - Only faster than a binary search on tiny ranges, FindLowerBound picks it below a calibrated size
+*
+* - Requires the container to be sorted, otherwise, it is UB
 *
 * @tparam It iterator type (can be a pointer)
 * @tparam K key type
@@ -139,23 +260,204 @@ constexpr It FindLowerBoundBranchless(It it_begin, It it_end, const K& value, Co
 * @return iterator to lower bound position for value
 */
 template<typename It, typename K, typename Comparator = std::less<void>>
-It FindLowerBoundRandom(It it_begin, It it_end, const K& value, Comparator compare = Comparator{}) noexcept
+It FindLowerBoundLinear(It it_begin, It it_end, const K& value, Comparator compare = Comparator{}) noexcept
 {
+    if constexpr (std::contiguous_iterator<It>)
+    {
+        using element_t = std::iter_value_t<It>;
+        if constexpr (Internal::Simd::Supported<element_t> && Internal::Simd::PlainLess<Comparator, element_t> && std::is_same_v<K, element_t>)
+        {
+            const element_t* p_begin = std::to_address(it_begin);
+            return it_begin + Internal::Simd::CountLess(p_begin, p_begin + (it_end - it_begin), value);
+        }
+    }
+
+    SizeT less_count = 0;
+    for (It it_current = it_begin; it_current != it_end; ++it_current)
+    {
+        less_count += static_cast<SizeT>(compare(*it_current, value));
+    }
+    return std::next(it_begin, static_cast<std::iter_difference_t<It>>(less_count));
+}
+
+/*
+* @details Batched lower bound algorithm
+*
+* - Runs the branchless lower bound for several keys in lockstep against the same sorted range
+*
+* - Every step prefetches each search's next probe, so the cache misses of independent keys overlap
+*   instead of being paid one search after another
+*
+* - Keys are processed in groups of Lanes, the last group can be smaller
+*
+* - Pays off once the range no longer fits in the cache. For small ranges, single searches are just as fast
+*
+* - Requires the container to be sorted, otherwise, it is UB
+*
+* @tparam Lanes number of searches advanced together (default: 16)
+* @tparam It iterator type (can be a pointer)
+* @tparam KeyIt key iterator type
+* @tparam OutIt output iterator type, receives It values
+* @tparam Comparator comparison predicate (default: std::less<void>)
+* @param it_begin pointer to container address or start
+* @param it_end pointer to container end address
+* @param keys_begin start of the keys to be found
+* @param keys_end end of the keys to be found
+* @param out output receiving the lower bound of each key, in key order
+* @param compare predicate for < comparison (defaulted to std::less<void>)
+* @return output iterator past the last written lower bound
+*/
+template<SizeT Lanes = 16, typename It, std::forward_iterator KeyIt, typename OutIt, typename Comparator = std::less<void>>
+OutIt FindLowerBoundBatch(It it_begin, It it_end, KeyIt keys_begin, KeyIt keys_end, OutIt out, Comparator compare = Comparator{}) noexcept
+{
+    static_assert(Lanes > 0, "Lanes must be greater than zero!");
+
     using diff_t = SizeT;
 
-    if (it_begin == it_end)
+    const diff_t length = it_end - it_begin;
+    if (length == 0)
     {
-        return it_end;
+        for (; keys_begin != keys_end; ++keys_begin, ++out)
+        {
+            *out = it_end;
+        }
+        return out;
+    }
+
+    It bases[Lanes];
+    KeyIt keys[Lanes];
+
+    while (keys_begin != keys_end)
+    {
+        SizeT lane_count = 0;
+        for (; lane_count < Lanes && keys_begin != keys_end; ++lane_count, ++keys_begin)
+        {
+            bases[lane_count] = it_begin;
+            keys[lane_count] = keys_begin;
+        }
+
+        for (diff_t remaining = length; remaining > 1; )
+        {
+            const diff_t half = remaining / 2;
+            for (SizeT lane = 0; lane < lane_count; ++lane)
+            {
+                bases[lane] = compare(bases[lane][half], *keys[lane]) ? bases[lane] + half : bases[lane];
+            }
+
+            remaining -= half;
+
+            const diff_t next_half = remaining / 2;
+            for (SizeT lane = 0; lane < lane_count; ++lane)
+            {
+                AOL_MACRO_FUNC_PREFETCH(std::addressof(bases[lane][next_half]));
+            }
+        }
+
+        for (SizeT lane = 0; lane < lane_count; ++lane, ++out)
+        {
+            *out = bases[lane] + compare(*bases[lane], *keys[lane]);
+        }
+    }
+
+    return out;
+}
+
+/*
+* @details Interpolation lower bound algorithm
+*
+* - Comparator-free search for integral keys, each probe is placed where value would sit if the keys
+*   between the current bounds were evenly spaced
+*
+* - Takes O(log log n) probes on near-uniform keys (i.e. dense ids). The probes are capped and the remaining
+*   window is binary searched, so skewed keys cost at most a few probes more than FindLowerBound
+*
+* - Requires the container to be sorted, otherwise, it is UB
+*
+* @tparam It iterator type (can be a pointer), with an integral value type
+* @tparam K integral key type
+* @param it_begin pointer to container address or start
+* @param it_end pointer to container end address
+* @param value value to be found
+* @return iterator to lower bound position for value
+*/
+template<typename It, std::integral K> requires std::integral<std::iter_value_t<It>>
+It FindLowerBoundInterpolation(It it_begin, It it_end, const K& value) noexcept
+{
+    using element_t = std::iter_value_t<It>;
+    using diff_t = SizeT;
+
+    constexpr diff_t binary_search_window = 16;
+    constexpr SizeT max_probes = 8;
+
+    if (!std::in_range<element_t>(value))
+    {
+        return std::cmp_less(value, std::numeric_limits<element_t>::min()) ? it_begin : it_end;
     }
+    const element_t key = static_cast<element_t>(value);
 
-    it_end--;
+    // The lower bound is in [low, high]
+    diff_t low = 0;
+    diff_t high = static_cast<diff_t>(it_end - it_begin);
+    for (SizeT probe = 0; probe < max_probes && high - low > binary_search_window; ++probe)
+    {
+        const element_t low_key = it_begin[low];
+        const element_t high_key = it_begin[high - 1];
+        if (!(low_key < key))
+        {
+            return it_begin + low;
+        }
+        if (high_key < key)
+        {
+            return it_begin + high;
+        }
 
+        // Differences taken in U64 stay exact for signed keys since low_key < key <= high_key
+        const double ratio = static_cast<double>(static_cast<U64>(key) - static_cast<U64>(low_key))
+            / static_cast<double>(static_cast<U64>(high_key) - static_cast<U64>(low_key));
+        diff_t position = low + static_cast<diff_t>(ratio * static_cast<double>(high - 1 - low));
+        position = position < high - 1 ? position : high - 1;
+
+        if (it_begin[position] < key)
+        {
+            low = position + 1;
+        }
+        else
+        {
+            high = position;
+        }
+    }
+
+    return FindLowerBoundBranchless(it_begin + low, it_begin + high, key);
+}
+
+namespace Internal
+{
+
+// Bit pools refilled from an RNG (see AoL::Rand::PoolBit)
+template<typename Pool, typename RNG>
+concept RandomBitPool = requires(Pool& pool, RNG& rng)
+{
+    Pool::OutputBitSize;
+    pool.Next(rng);
+};
+
+// Maps a Bits wide uniform draw to [0, range) with a multiply and shift instead of a modulo
+template<U64 Bits, typename Draw>
+SizeT ReduceRandomRange(Draw draw, SizeT range) noexcept
+{
+    return static_cast<SizeT>((static_cast<U128>(draw) * static_cast<U128>(range)) >> Bits);
+}
+
+// Probes a random position of [it_begin, it_end) each step, pick(n) returns an offset in [0, n)
+template<typename It, typename K, typename Pick, typename Comparator>
+It FindLowerBoundRandomImpl(It it_begin, It it_end, const K& value, Pick pick, Comparator& compare) noexcept
+{
     while (it_begin < it_end)
     {
-        It mid = it_begin + (std::rand() % static_cast<diff_t>(it_end - it_begin));
+        It mid = it_begin + pick(static_cast<SizeT>(it_end - it_begin));
         if (!compare(*mid, value))
         {
-            it_end = mid + 1;
+            it_end = mid;
         }
         else
         {
@@ -163,13 +465,234 @@ It FindLowerBoundRandom(It it_begin, It it_end, const K& value, Comparator compa
         }
     }
 
-    return compare(*it_begin, value) ? it_end : it_begin;
+    return it_begin;
+}
+
+} // Internal namespace
+
+/*
+* @details Random lower bound algorith
+*
+* - Binary search but random
+*
+* - Can be really fast, can be really slow, depends on your luck
+*
+* - Draws from std::rand, prefer the RNG overloads below in hot paths or from several threads
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam K key type
+* @tparam Comparator comparison predicate (default: std::less<void>)
+* @param p_start pointer to container address or start
+* @param p_end pointer to container end address
+* @param key value to be found
+* @param compare predicate for < comparison (defaulted to std::less<void>)
+* @return iterator to lower bound position for value
+*/
+template<typename It, typename K, typename Comparator = std::less<void>> requires (!std::uniform_random_bit_generator<Comparator>)
+It FindLowerBoundRandom(It it_begin, It it_end, const K& value, Comparator compare = Comparator{}) noexcept
+{
+    return Internal::FindLowerBoundRandomImpl(it_begin, it_end, value,
+        [](SizeT range) { return static_cast<SizeT>(std::rand()) % range; }, compare);
+}
+
+/*
+* @details Random lower bound algorithm with a caller provided RNG
+*
+* - Same search as the std::rand overload, but draws from rng (i.e. AoL::Rand::DefaultGen) and maps each draw
+*   to the range with a multiply-shift, so there is no global libc state, lock or modulo per probe
+*
+* - Thread-safe as long as every thread uses its own rng
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam K key type
+* @tparam RNG random number generator type
+* @tparam Comparator comparison predicate (default: std::less<void>)
+* @param it_begin pointer to container address or start
+* @param it_end pointer to container end address
+* @param value value to be found
+* @param rng random number generator object
+* @param compare predicate for < comparison (defaulted to std::less<void>)
+* @return iterator to lower bound position for value
+*/
+template<typename It, typename K, std::uniform_random_bit_generator RNG, typename Comparator = std::less<void>>
+    requires (!Internal::RandomBitPool<Comparator, RNG>)
+It FindLowerBoundRandom(It it_begin, It it_end, const K& value, RNG& rng, Comparator compare = Comparator{}) noexcept
+{
+    using rng_t = std::remove_cvref_t<decltype(rng())>;
+    static_assert(RNG::min() == 0 && RNG::max() == std::numeric_limits<rng_t>::max(), "RNG must output the full range of its result type!");
+
+    return Internal::FindLowerBoundRandomImpl(it_begin, it_end, value,
+        [&rng](SizeT range) { return Internal::ReduceRandomRange<sizeof(rng_t) * 8>(rng(), range); }, compare);
+}
+
+/*
+* @details Random lower bound algorithm with a caller provided RNG and bit pool
+*
+* - Each probe takes Pool::OutputBitSize bits from the pool (i.e. AoL::Rand::PoolBit64_16), so one rng call
+*   serves several probes
+*
+* - Probes land on one of 2^OutputBitSize evenly spaced positions, narrow pools only make the search
+*   coarser on huge ranges, the result is always the lower bound
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam K key type
+* @tparam RNG random number generator type
+* @tparam Pool bit pool type (see AoL::Rand::PoolBit)
+* @tparam Comparator comparison predicate (default: std::less<void>)
+* @param it_begin pointer to container address or start
+* @param it_end pointer to container end address
+* @param value value to be found
+* @param rng random number generator object
+* @param pool bit pool object, refilled from rng
+* @param compare predicate for < comparison (defaulted to std::less<void>)
+* @return iterator to lower bound position for value
+*/
+template<typename It, typename K, std::uniform_random_bit_generator RNG, Internal::RandomBitPool<RNG> Pool, typename Comparator = std::less<void>>
+It FindLowerBoundRandom(It it_begin, It it_end, const K& value, RNG& rng, Pool& pool, Comparator compare = Comparator{}) noexcept
+{
+    static_assert(Pool::OutputBitSize >= 8, "Pool must output at least 8 bits per draw!");
+
+    return Internal::FindLowerBoundRandomImpl(it_begin, it_end, value,
+        [&rng, &pool](SizeT range) { return Internal::ReduceRandomRange<Pool::OutputBitSize>(pool.Next(rng), range); }, compare);
+}
+
+namespace Internal
+{
+
+// Times FindLowerBound strategies on a range of U32 for the linear cutoff calibration, best of a few rounds
+template<typename Search>
+U64 TimeLowerBoundSearches(const AoL::Vector<U32>& values, SizeT count, const AoL::Vector<U32>& queries, Search search) noexcept
+{
+    constexpr SizeT round_count = 5;
+    constexpr SizeT repeat_count = 8;
+
+    const U32* p_begin = values.data();
+    const U32* p_end = p_begin + count;
+
+    U64 best_time = ~U64{ 0 };
+    SizeT sink = 0;
+    for (SizeT round = 0; round < round_count; ++round)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (SizeT repeat = 0; repeat < repeat_count; ++repeat)
+        {
+            for (U32 query : queries)
+            {
+                sink += static_cast<SizeT>(search(p_begin, p_end, query) - p_begin);
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const U64 time = static_cast<U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        best_time = time < best_time ? time : best_time;
+    }
+
+    // Keeps the searches from being optimized away
+    volatile SizeT sink_out = sink;
+    (void)sink_out;
+
+    return best_time;
+}
+
+inline constexpr SizeT find_lower_bound_cutoff_unset = ~SizeT{ 0 };
+inline std::atomic<SizeT> find_lower_bound_linear_cutoff{ find_lower_bound_cutoff_unset };
+
+} // Internal namespace
+
+/**
+* @details Measures the range size, in bytes, up to which FindLowerBoundLinear beats FindLowerBoundBranchless
+*
+* - Times both searches on U32 ranges of 32 bytes up to 1KB, the cutoff is the last size the linear scan
+*   still wins on (0 if it never wins)
+*
+* - Takes well under a millisecond in release builds. FindLowerBound runs it once on its first call unless
+*   AOL_CONFIG_FIND_LOWER_BOUND_LINEAR_CUTOFF_BYTES is defined
+*
+* @return linear scan cutoff in bytes
+*/
+inline SizeT CalibrateFindLowerBoundLinearCutoff() noexcept
+{
+    constexpr SizeT min_bytes = 32;
+    constexpr SizeT max_bytes = 1024;
+    constexpr SizeT query_count = 256;
+
+    AoL::Vector<U32> values(max_bytes / sizeof(U32));
+    for (SizeT i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<U32>(i * 2);
+    }
+
+    // Raw queries of a fixed xorshift, reduced per size so they spread over that size's whole value range, hits and misses mixed
+    AoL::Vector<U32> raw_queries(query_count);
+    U32 state = 0x9E3779B9u;
+    for (U32& query : raw_queries)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        query = state;
+    }
+
+    AoL::Vector<U32> queries(query_count);
+    SizeT cutoff = 0;
+    for (SizeT bytes = min_bytes; bytes <= max_bytes; bytes *= 2)
+    {
+        const SizeT count = bytes / sizeof(U32);
+        for (SizeT i = 0; i < query_count; ++i)
+        {
+            queries[i] = raw_queries[i] % static_cast<U32>(count * 2 + 1);
+        }
+
+        const U64 linear_time = Internal::TimeLowerBoundSearches(values, count, queries,
+            [](const U32* p_begin, const U32* p_end, U32 query) { return FindLowerBoundLinear(p_begin, p_end, query); });
+        const U64 branchless_time = Internal::TimeLowerBoundSearches(values, count, queries,
+            [](const U32* p_begin, const U32* p_end, U32 query) { return FindLowerBoundBranchless(p_begin, p_end, query); });
+
+        if (linear_time > branchless_time)
+        {
+            break;
+        }
+        cutoff = bytes;
+    }
+
+    return cutoff;
+}
+
+/**
+* @details Range size, in bytes, up to which FindLowerBound uses the linear scan
+*
+* - Either AOL_CONFIG_FIND_LOWER_BOUND_LINEAR_CUTOFF_BYTES or the result of a one-time calibration
+*
+* - Call it once at startup to keep the calibration out of the first search
+*
+* @return linear scan cutoff in bytes
+*/
+inline SizeT FindLowerBoundLinearCutoff() noexcept
+{
+#if defined(AOL_CONFIG_FIND_LOWER_BOUND_LINEAR_CUTOFF_BYTES)
+    return AOL_CONFIG_FIND_LOWER_BOUND_LINEAR_CUTOFF_BYTES;
+#else
+    // Threads racing on the first call may each calibrate, any of their results is fine
+    SizeT cutoff = Internal::find_lower_bound_linear_cutoff.load(std::memory_order_relaxed);
+    if (cutoff == Internal::find_lower_bound_cutoff_unset) AOL_ATTRIB_BRANCH_UNLIKELY
+    {
+        cutoff = CalibrateFindLowerBoundLinearCutoff();
+        Internal::find_lower_bound_linear_cutoff.store(cutoff, std::memory_order_relaxed);
+    }
+    return cutoff;
+#endif
 }
 
 /*
 * @details Default lower bound algorithm of the library
 *
-* - This uses the Eytzinger implementation
+* - Picks the search from the range size and element type
+*
+* - Contiguous ranges of integers and floating points compared with a plain < use the SIMD linear scan
+*   up to FindLowerBoundLinearCutoff() bytes, the branchless binary search otherwise
+*
+* - Every other range uses the branchless binary search
+*
+* - For large read-mostly tables, build a StaticBTree or EytzingerIndex once and use FindLowerBound(index, it_begin, value)
 *
 * - Requires the container to be sorted, otherwise, it is UB
 *
@@ -185,6 +708,18 @@ It FindLowerBoundRandom(It it_begin, It it_end, const K& value, Comparator compa
 template<typename It, typename K, typename Comparator = std::less<void>>
 It FindLowerBound(It it_begin, It it_end, const K& value, Comparator compare = Comparator{}) noexcept
 {
+    if constexpr (std::contiguous_iterator<It>)
+    {
+        using element_t = std::iter_value_t<It>;
+        if constexpr (Internal::Simd::Supported<element_t> && Internal::Simd::PlainLess<Comparator, element_t> && std::is_same_v<K, element_t>)
+        {
+            if (static_cast<SizeT>(it_end - it_begin) * sizeof(element_t) <= FindLowerBoundLinearCutoff())
+            {
+                return FindLowerBoundLinear(it_begin, it_end, value, compare);
+            }
+        }
+    }
+
     return FindLowerBoundBranchless(it_begin, it_end, value, compare);
 }
 
@@ -0,0 +1,283 @@
+/***************************************************************************************
+* Algorithm Learned Index Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_LEARNED_INDEX_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_LEARNED_INDEX_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/algorithms/find.h"
+
+#include <concepts>		// std::integral
+#include <functional>	// std::identity, std::invoke
+#include <limits>		// std::numeric_limits
+#include <utility>		// std::in_range, std::cmp_less
+
+
+namespace AoL
+{
+
+/**
+* @details Piecewise linear model of a sorted integral key range (PGM/RadixSpline style learned index)
+*
+* - The keys are split into segments, each one a line mapping a key to its predicted position.
+*   Every distinct key is predicted within max_error() positions of its lower bound
+*
+* - A lookup binary searches the segment start keys, evaluates the line and binary searches only the
+*   [prediction - max_error, prediction + max_error] window of the sorted range, so it touches a few
+*   cache lines of the range instead of log2(n) scattered ones
+*
+* - Segments are built greedily in one pass (shrinking cone), near-uniform keys need a single segment
+*
+* - Only positions are stored, the sorted range is kept by the caller and must not change after build
+*
+* - Keys outside a window (i.e. a long gap after a key) fall back to galloping, so lookups stay correct
+*   whatever the key distribution
+*
+* @tparam K integral key type
+* @tparam Projection key extraction from the range elements (default: std::identity)
+*/
+template<
+	std::integral K,
+	typename Projection = std::identity
+>
+struct LearnedIndex
+{
+public:
+	using key_type = K;
+	using size_type = SizeT;
+
+	static constexpr size_type default_max_error = 32;
+
+	struct Segment
+	{
+		K key;			// first key of the segment
+		size_type rank;	// lower bound position of key
+		double slope;	// positions per key unit
+	};
+
+	using key_container_type = AoL::Vector<K>;
+	using segment_container_type = AoL::Vector<Segment>;
+
+private:
+	AOL_ATTRIB_NO_UNQ_ADDRESS Projection projection;
+	size_type key_count;
+	size_type error;
+
+public:
+	key_container_type segment_keys;	// segment start keys, searched before touching segments
+	segment_container_type segments;
+
+	LearnedIndex() noexcept :
+		projection{ },
+		key_count{ 0 },
+		error{ default_max_error },
+		segment_keys{ },
+		segments{ }
+	{
+	}
+
+	template<typename It>
+	explicit LearnedIndex(It it_begin, It it_end, size_type max_error = default_max_error, Projection proj = Projection{}) :
+		projection{ proj },
+		key_count{ 0 },
+		error{ max_error },
+		segment_keys{ },
+		segments{ }
+	{
+		this->build(it_begin, it_end);
+	}
+
+	explicit LearnedIndex(const AoL::Vector<K>& sorted_keys, size_type max_error = default_max_error) :
+		LearnedIndex(sorted_keys.begin(), sorted_keys.end(), max_error)
+	{
+	}
+
+	/**
+	* @details Rebuilds the segments from a sorted range
+	*
+	* - The range must be sorted in ascending order of the projected keys, otherwise, it is UB
+	*
+	* @param it_begin start of the sorted range
+	* @param it_end end of the sorted range
+	*/
+	template<typename It>
+	void build(It it_begin, It it_end)
+	{
+		this->clear();
+
+		const double error_bound = static_cast<double>(error);
+		double slope_low = 0.0;
+		double slope_high = std::numeric_limits<double>::infinity();
+		bool has_previous = false;
+		K previous_key{ };
+
+		size_type rank = 0;
+		for (; it_begin != it_end; ++it_begin, ++rank)
+		{
+			const K key = std::invoke(projection, *it_begin);
+			if (has_previous && !(previous_key < key))
+			{
+				continue;
+			}
+			has_previous = true;
+			previous_key = key;
+
+			if (segments.empty())
+			{
+				this->StartSegment(key, rank, slope_low, slope_high);
+				continue;
+			}
+
+			// The segment line starts at its first point, slopes that keep every point within the error form a cone
+			Segment& segment = segments.back();
+			const double dx = static_cast<double>(static_cast<U64>(key) - static_cast<U64>(segment.key));
+			const double dy = static_cast<double>(rank - segment.rank);
+			if (dy < slope_low * dx || dy > slope_high * dx)
+			{
+				this->CloseSegment(slope_low, slope_high);
+				this->StartSegment(key, rank, slope_low, slope_high);
+				continue;
+			}
+
+			const double cone_low = (dy - error_bound) / dx;
+			const double cone_high = (dy + error_bound) / dx;
+			slope_low = cone_low > slope_low ? cone_low : slope_low;
+			slope_high = cone_high < slope_high ? cone_high : slope_high;
+		}
+
+		key_count = rank;
+		if (!segments.empty())
+		{
+			this->CloseSegment(slope_low, slope_high);
+		}
+	}
+
+	/**
+	* @details Lower bound search through the model
+	*
+	* - it_begin must be the start of the range the index was built from
+	*
+	* @tparam It iterator type (can be a pointer)
+	* @tparam KQ integral query type
+	* @param it_begin start of the sorted range
+	* @param value value to be found
+	* @return iterator to lower bound position for value
+	*/
+	template<typename It, std::integral KQ>
+	AOL_ATTRIB_NO_DISCARD It lower_bound(It it_begin, const KQ& value) const noexcept
+	{
+		if (!std::in_range<K>(value))
+		{
+			return it_begin + (std::cmp_less(value, std::numeric_limits<K>::min()) ? 0 : key_count);
+		}
+		const K key = static_cast<K>(value);
+
+		const K* p_keys_begin = segment_keys.data();
+		const K* p_keys_end = p_keys_begin + segment_keys.size();
+		const K* p_next = AoL::FindLowerBoundBranchless(p_keys_begin, p_keys_end, key,
+			[](const K& segment_key, const K& query) { return !(query < segment_key); });
+		if (p_next == p_keys_begin)
+		{
+			return it_begin;
+		}
+
+		// key is in [segment.key, next segment key), so is its lower bound in [segment.rank, next_rank]
+		const size_type index = static_cast<size_type>(p_next - p_keys_begin) - 1;
+		const Segment& segment = segments[index];
+		const size_type next_rank = index + 1 < segments.size() ? segments[index + 1].rank : key_count;
+
+		const double offset = segment.slope * static_cast<double>(static_cast<U64>(key) - static_cast<U64>(segment.key));
+		const double last_offset = static_cast<double>(next_rank - segment.rank);
+		const size_type prediction = segment.rank + static_cast<size_type>(offset < last_offset ? offset : last_offset);
+
+		// One more position on each side absorbs the floating point rounding of the prediction
+		const size_type reach = error + 1;
+		const size_type low = prediction - segment.rank > reach ? prediction - reach : segment.rank;
+		const size_type high = next_rank - prediction > reach ? prediction + reach + 1 : next_rank;
+
+		const auto less = [this](const auto& element, const K& query) { return std::invoke(projection, element) < query; };
+		if (low != segment.rank && !less(it_begin[low - 1], key)) AOL_ATTRIB_BRANCH_UNLIKELY
+		{
+			return AoL::FindLowerBoundGalloping(it_begin + segment.rank, it_begin + low, it_begin + low, key, less);
+		}
+
+		const It it_found = AoL::FindLowerBoundBranchless(it_begin + low, it_begin + high, key, less);
+		if (it_found == it_begin + high && high != next_rank) AOL_ATTRIB_BRANCH_UNLIKELY
+		{
+			return AoL::FindLowerBoundGalloping(it_found, it_begin + next_rank, key, less);
+		}
+		return it_found;
+	}
+
+	AOL_ATTRIB_NO_DISCARD size_type max_error() const noexcept
+	{
+		return error;
+	}
+
+	AOL_ATTRIB_NO_DISCARD size_type segment_count() const noexcept
+	{
+		return segments.size();
+	}
+
+	AOL_ATTRIB_NO_DISCARD size_type size() const noexcept
+	{
+		return key_count;
+	}
+
+	AOL_ATTRIB_NO_DISCARD bool empty() const noexcept
+	{
+		return key_count == 0;
+	}
+
+	void clear() noexcept
+	{
+		key_count = 0;
+		segment_keys.clear();
+		segments.clear();
+	}
+
+private:
+	void StartSegment(const K& key, size_type rank, double& slope_low, double& slope_high)
+	{
+		segments.push_back(Segment{ key, rank, 0.0 });
+		segment_keys.push_back(key);
+		slope_low = 0.0;
+		slope_high = std::numeric_limits<double>::infinity();
+	}
+
+	void CloseSegment(double slope_low, double slope_high) noexcept
+	{
+		// A single key segment has an unbounded cone, a flat line predicts its rank exactly
+		segments.back().slope = slope_high == std::numeric_limits<double>::infinity() ? 0.0 : (slope_low + slope_high) * 0.5;
+	}
+};
+
+/**
+* @details Lower bound algorithm through a prebuilt LearnedIndex
+*
+* - The index must have been built from [it_begin, it_begin + index.size())
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam T index key type
+* @tparam P index projection type
+* @tparam K integral key type
+* @param index prebuilt index of the sorted range
+* @param it_begin start of the sorted range the index was built from
+* @param value value to be found
+* @return iterator to lower bound position for value
+*/
+template<typename It, typename T, typename P, std::integral K>
+It FindLowerBound(const LearnedIndex<T, P>& index, It it_begin, const K& value) noexcept
+{
+	return index.lower_bound(it_begin, value);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_LEARNED_INDEX_H
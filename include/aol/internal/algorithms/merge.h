@@ -0,0 +1,460 @@
+/***************************************************************************************
+* Algorithm Merge Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_MERGE_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_MERGE_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/threads/thread-pool.h"
+
+#include <algorithm>	// std::copy, std::move, std::remove_if, std::lower_bound, std::sort, std::min, std::max
+#include <functional>	// std::less
+#include <iterator>		// std::input_iterator, std::random_access_iterator, std::iter_value_t
+#include <ranges>		// std::ranges::begin, std::ranges::end, std::ranges::iterator_t
+#include <type_traits>	// std::is_trivially_copyable_v, std::is_same_v
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Below this output size, a merge runs on one thread
+inline constexpr SizeT parallel_merge_cutoff = SizeT{ 1 } << 15;
+
+// Smallest output written by one merge task
+inline constexpr SizeT parallel_merge_min_block = SizeT{ 1 } << 13;
+
+// Samples per output part of the parallel k-way merge, more samples give more even parts
+inline constexpr SizeT parallel_merge_oversampling = 32;
+
+// Remaining elements of a sorted run
+template<typename It>
+struct MergeRun
+{
+	It it;
+	It end;
+};
+
+/**
+* @details Co-ranking (merge path): elements taken from a for the first diagonal elements of the merged output
+*
+* - Binary search on the cross diagonal, a's elements go first on ties so the split keeps the merge stable
+*/
+template<std::random_access_iterator ItA, std::random_access_iterator ItB, typename Comparator>
+SizeT MergeCoRank(ItA a_begin, SizeT a_count, ItB b_begin, SizeT b_count, SizeT diagonal, Comparator& compare)
+{
+	SizeT low = diagonal > b_count ? diagonal - b_count : 0;
+	SizeT high = std::min(diagonal, a_count);
+	while (low < high)
+	{
+		const SizeT middle = low + (high - low) / 2;
+		if (compare(b_begin[static_cast<PtrDiff>(diagonal - middle - 1)], a_begin[static_cast<PtrDiff>(middle)]))
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+	return low;
+}
+
+} // Internal namespace
+
+/**
+* @details Merge two sorted ranges
+*
+* - Stable: on equal elements, the ones of the first range are written first
+*
+* @tparam ItA input iterator type of the first range (can be a pointer)
+* @tparam ItB input iterator type of the second range (can be a pointer)
+* @tparam Out output iterator type
+* @tparam Comparator comparison type the ranges are sorted by (default: std::less)
+* @param a_begin start of the first range
+* @param a_end end of the first range
+* @param b_begin start of the second range
+* @param b_end end of the second range
+* @param out start of the output, must not overlap the inputs
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::input_iterator ItA, std::input_iterator ItB, typename Out, typename Comparator = std::less<>>
+constexpr Out MergeSorted(ItA a_begin, ItA a_end, ItB b_begin, ItB b_end, Out out, Comparator compare = Comparator{})
+{
+	while (a_begin != a_end && b_begin != b_end)
+	{
+		if (compare(*b_begin, *a_begin))
+		{
+			*out = *b_begin;
+			++b_begin;
+		}
+		else
+		{
+			*out = *a_begin;
+			++a_begin;
+		}
+		++out;
+	}
+	out = std::copy(a_begin, a_end, out);
+	return std::copy(b_begin, b_end, out);
+}
+
+namespace Internal
+{
+
+// Loser tree entry: the run, and a copy of its head for small trivially copyable elements so matches skip the indirection
+template<typename It, bool Cached = std::is_trivially_copyable_v<std::iter_value_t<It>> && sizeof(std::iter_value_t<It>) <= 16>
+struct LoserTreeEntry
+{
+	SizeT run;
+};
+
+template<typename It>
+struct LoserTreeEntry<It, true>
+{
+	std::iter_value_t<It> head;
+	SizeT run;
+};
+
+/**
+* @details Loser tree merge of k runs
+*
+* - Runs are leaves k..2k-1 of an implicit tree, every inner node keeps the loser of its match and node 0 the winner,
+*   so replacing the winner replays a single leaf to root path: log2(k) comparisons per element, without branches
+*
+* - A run that runs out leaves the tree, which is rebuilt for the others (k times at most),
+*   so the matches never check for the end of a run. The last two runs finish with MergeSorted
+*
+* - On equal elements the lower run wins so the merge is stable, runs keep their order when one leaves
+*
+* - p_runs is consumed
+*/
+template<typename It, typename Out, typename Comparator>
+Out LoserTreeMerge(MergeRun<It>* p_runs, SizeT run_count, Out out, Comparator& compare)
+{
+	using entry_type = LoserTreeEntry<It>;
+	constexpr bool cached = !std::is_same_v<entry_type, LoserTreeEntry<It, false>>;
+
+	const auto make_entry = [p_runs](SizeT run) -> entry_type
+	{
+		if constexpr (cached)
+		{
+			return { *p_runs[run].it, run };
+		}
+		else
+		{
+			return { run };
+		}
+	};
+	const auto head = [p_runs](const entry_type& entry) -> decltype(auto)
+	{
+		if constexpr (cached)
+		{
+			return (entry.head);
+		}
+		else
+		{
+			return *p_runs[entry.run].it;
+		}
+	};
+	// Ties go to the lower run
+	const auto beats = [&head, &compare](const entry_type& lhs, const entry_type& rhs) -> bool
+	{
+		return compare(head(lhs), head(rhs)) || (lhs.run < rhs.run && !compare(head(rhs), head(lhs)));
+	};
+
+	run_count = static_cast<SizeT>(std::remove_if(p_runs, p_runs + run_count, [](const MergeRun<It>& run) { return run.it == run.end; }) - p_runs);
+
+	AoL::Vector<entry_type> tree(run_count);
+	AoL::Vector<entry_type> winners(2 * run_count);
+	while (run_count > 2)
+	{
+		// Initial matches bottom up, winners[node] is the entry that came out of node
+		for (SizeT run = 0; run < run_count; ++run)
+		{
+			winners[run_count + run] = make_entry(run);
+		}
+		for (SizeT node = run_count - 1; node > 0; --node)
+		{
+			const entry_type& lhs = winners[2 * node];
+			const entry_type& rhs = winners[2 * node + 1];
+			const bool lhs_wins = beats(lhs, rhs);
+			tree[node] = lhs_wins ? rhs : lhs;
+			winners[node] = lhs_wins ? lhs : rhs;
+		}
+
+		entry_type winner = winners[1];
+		for (;;)
+		{
+			MergeRun<It>& run = p_runs[winner.run];
+			*out = *run.it;
+			++out;
+			if (++run.it == run.end)
+			{
+				break;
+			}
+
+			winner = make_entry(winner.run);
+			for (SizeT node = (run_count + winner.run) / 2; node > 0; node /= 2)
+			{
+				const entry_type loser = tree[node];
+				const bool swap = beats(loser, winner);
+				tree[node] = swap ? winner : loser;
+				winner = swap ? loser : winner;
+			}
+		}
+
+		std::move(p_runs + winner.run + 1, p_runs + run_count, p_runs + winner.run);
+		--run_count;
+	}
+
+	if (run_count == 2)
+	{
+		return MergeSorted(p_runs[0].it, p_runs[0].end, p_runs[1].it, p_runs[1].end, out, compare);
+	}
+	if (run_count == 1)
+	{
+		return std::copy(p_runs[0].it, p_runs[0].end, out);
+	}
+	return out;
+}
+
+} // Internal namespace
+
+/**
+* @details Merge two sorted ranges on a ThreadPool
+*
+* - Merge path: the output is cut into one block per task, and the start of every block in both inputs
+*   is found by co-ranking (a binary search on the block's diagonal), so the tasks merge independent pieces
+*
+* - Same order as MergeSorted, small outputs are merged by the calling thread
+*
+* @tparam ItA random access iterator type of the first range (can be a pointer)
+* @tparam ItB random access iterator type of the second range (can be a pointer)
+* @tparam Out random access iterator type of the output
+* @tparam Comparator comparison type the ranges are sorted by (default: std::less)
+* @param pool thread pool the tasks run on, the calling thread helps
+* @param a_begin start of the first range
+* @param a_end end of the first range
+* @param b_begin start of the second range
+* @param b_end end of the second range
+* @param out start of the output, must not overlap the inputs
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::random_access_iterator ItA, std::random_access_iterator ItB, std::random_access_iterator Out, typename Comparator = std::less<>>
+Out MergeSortedParallel(ThreadPool& pool, ItA a_begin, ItA a_end, ItB b_begin, ItB b_end, Out out, Comparator compare = Comparator{})
+{
+	const SizeT a_count = static_cast<SizeT>(a_end - a_begin);
+	const SizeT b_count = static_cast<SizeT>(b_end - b_begin);
+	const SizeT count = a_count + b_count;
+	const SizeT concurrency = pool.concurrency();
+	if (count < Internal::parallel_merge_cutoff || concurrency == 1)
+	{
+		return MergeSorted(a_begin, a_end, b_begin, b_end, out, compare);
+	}
+
+	const SizeT block_count = std::max<SizeT>(1, std::min(concurrency * 4, count / Internal::parallel_merge_min_block));
+	const SizeT block_size = (count + block_count - 1) / block_count;
+	{
+		TaskGroup group(pool);
+		for (SizeT block = 0; block < block_count; ++block)
+		{
+			group.run([&, block]()
+			{
+				const SizeT low = std::min(block * block_size, count);
+				const SizeT high = std::min(low + block_size, count);
+				const SizeT a_low = Internal::MergeCoRank(a_begin, a_count, b_begin, b_count, low, compare);
+				const SizeT a_high = Internal::MergeCoRank(a_begin, a_count, b_begin, b_count, high, compare);
+				MergeSorted(a_begin + static_cast<PtrDiff>(a_low), a_begin + static_cast<PtrDiff>(a_high),
+					b_begin + static_cast<PtrDiff>(low - a_low), b_begin + static_cast<PtrDiff>(high - a_high),
+					out + static_cast<PtrDiff>(low), compare);
+			});
+		}
+		group.wait();
+	}
+	return out + static_cast<PtrDiff>(count);
+}
+
+/**
+* @details Merge two sorted ranges on DefaultThreadPool()
+*
+* @param a_begin start of the first range
+* @param a_end end of the first range
+* @param b_begin start of the second range
+* @param b_end end of the second range
+* @param out start of the output, must not overlap the inputs
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::random_access_iterator ItA, std::random_access_iterator ItB, std::random_access_iterator Out, typename Comparator = std::less<>>
+Out MergeSortedParallel(ItA a_begin, ItA a_end, ItB b_begin, ItB b_end, Out out, Comparator compare = Comparator{})
+{
+	return MergeSortedParallel(DefaultThreadPool(), a_begin, a_end, b_begin, b_end, out, compare);
+}
+
+/**
+* @details Merge k sorted runs (i.e. per thread result shards) with a loser tree
+*
+* - log2(k) comparisons per element, every element is copied once: no concatenation and no full sort
+*
+* - Stable: on equal elements, the ones of the earlier run are written first
+*
+* @tparam Runs range of sorted ranges (i.e. AoL::Vector<AoL::Vector<T>>)
+* @tparam Out output iterator type
+* @tparam Comparator comparison type the runs are sorted by (default: std::less)
+* @param runs the sorted runs
+* @param out start of the output, must not overlap the runs
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::ranges::forward_range Runs, typename Out, typename Comparator = std::less<>>
+	requires std::ranges::forward_range<std::ranges::range_reference_t<const Runs&>>
+Out KWayMerge(const Runs& runs, Out out, Comparator compare = Comparator{})
+{
+	using run_iterator = std::ranges::iterator_t<std::ranges::range_reference_t<const Runs&>>;
+
+	AoL::Vector<Internal::MergeRun<run_iterator>> cursors;
+	for (auto&& run : runs)
+	{
+		cursors.push_back({ std::ranges::begin(run), std::ranges::end(run) });
+	}
+	return Internal::LoserTreeMerge(cursors.data(), cursors.size(), out, compare);
+}
+
+/**
+* @details Merge k sorted runs on a ThreadPool
+*
+* - The output is cut into about 4 parts per thread by splitters picked from a sample of the runs,
+*   every run is split at the splitters with a binary search, and every part is a loser tree merge of its own task
+*
+* - Same order as KWayMerge: all elements equal to a splitter fall in the same part.
+*   Many duplicates can make the parts uneven, never wrong
+*
+* @tparam Runs range of sorted random access ranges (i.e. AoL::Vector<AoL::Vector<T>>)
+* @tparam Out random access iterator type of the output
+* @tparam Comparator comparison type the runs are sorted by (default: std::less)
+* @param pool thread pool the tasks run on, the calling thread helps
+* @param runs the sorted runs
+* @param out start of the output, must not overlap the runs
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::ranges::forward_range Runs, std::random_access_iterator Out, typename Comparator = std::less<>>
+	requires std::ranges::random_access_range<std::ranges::range_reference_t<const Runs&>>
+Out KWayMergeParallel(ThreadPool& pool, const Runs& runs, Out out, Comparator compare = Comparator{})
+{
+	using run_iterator = std::ranges::iterator_t<std::ranges::range_reference_t<const Runs&>>;
+	using value_type = std::iter_value_t<run_iterator>;
+
+	AoL::Vector<Internal::MergeRun<run_iterator>> cursors;
+	SizeT count = 0;
+	for (auto&& run : runs)
+	{
+		cursors.push_back({ std::ranges::begin(run), std::ranges::end(run) });
+		count += static_cast<SizeT>(cursors.back().end - cursors.back().it);
+	}
+
+	const SizeT concurrency = pool.concurrency();
+	const SizeT run_count = cursors.size();
+	if (count < Internal::parallel_merge_cutoff || concurrency == 1 || run_count < 2)
+	{
+		return Internal::LoserTreeMerge(cursors.data(), run_count, out, compare);
+	}
+
+	// Splitters: evenly spaced samples of every run, in proportion to its size
+	const SizeT part_count = std::max<SizeT>(1, std::min(concurrency * 4, count / Internal::parallel_merge_min_block));
+	AoL::Vector<value_type> splitters;
+	{
+		const SizeT sample_count = part_count * Internal::parallel_merge_oversampling;
+		AoL::Vector<value_type> samples;
+		samples.reserve(sample_count + run_count);
+		for (const auto& cursor : cursors)
+		{
+			const SizeT run_size = static_cast<SizeT>(cursor.end - cursor.it);
+			const SizeT run_samples = run_size * sample_count / count;
+			for (SizeT i = 0; i < run_samples; ++i)
+			{
+				samples.push_back(cursor.it[static_cast<PtrDiff>(i * run_size / run_samples)]);
+			}
+		}
+		if (samples.size() < part_count) AOL_ATTRIB_BRANCH_UNLIKELY
+		{
+			// Too many tiny runs to sample
+			return Internal::LoserTreeMerge(cursors.data(), run_count, out, compare);
+		}
+		std::sort(samples.begin(), samples.end(), compare);
+
+		splitters.reserve(part_count - 1);
+		for (SizeT part = 1; part < part_count; ++part)
+		{
+			splitters.push_back(samples[part * samples.size() / part_count]);
+		}
+	}
+
+	// Split points: part p takes [splits[p * k + run], splits[(p + 1) * k + run]) of every run
+	AoL::Vector<run_iterator> splits((part_count + 1) * run_count);
+	AoL::Vector<SizeT> part_begins(part_count + 1, 0);
+	for (SizeT run = 0; run < run_count; ++run)
+	{
+		splits[run] = cursors[run].it;
+		splits[part_count * run_count + run] = cursors[run].end;
+		for (SizeT part = 1; part < part_count; ++part)
+		{
+			splits[part * run_count + run] = std::lower_bound(splits[(part - 1) * run_count + run], cursors[run].end, splitters[part - 1], compare);
+			part_begins[part] += static_cast<SizeT>(splits[part * run_count + run] - cursors[run].it);
+		}
+	}
+	part_begins[part_count] = count;
+
+	{
+		TaskGroup group(pool);
+		for (SizeT part = 0; part < part_count; ++part)
+		{
+			if (part_begins[part] == part_begins[part + 1])
+			{
+				continue;
+			}
+
+			group.run([&, part]()
+			{
+				AoL::Vector<Internal::MergeRun<run_iterator>> part_runs(run_count);
+				for (SizeT run = 0; run < run_count; ++run)
+				{
+					part_runs[run] = { splits[part * run_count + run], splits[(part + 1) * run_count + run] };
+				}
+				Internal::LoserTreeMerge(part_runs.data(), run_count, out + static_cast<PtrDiff>(part_begins[part]), compare);
+			});
+		}
+		group.wait();
+	}
+	return out + static_cast<PtrDiff>(count);
+}
+
+/**
+* @details Merge k sorted runs on DefaultThreadPool()
+*
+* @param runs the sorted runs
+* @param out start of the output, must not overlap the runs
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::ranges::forward_range Runs, std::random_access_iterator Out, typename Comparator = std::less<>>
+	requires std::ranges::random_access_range<std::ranges::range_reference_t<const Runs&>>
+Out KWayMergeParallel(const Runs& runs, Out out, Comparator compare = Comparator{})
+{
+	return KWayMergeParallel(DefaultThreadPool(), runs, out, compare);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_MERGE_H
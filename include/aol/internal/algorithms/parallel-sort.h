@@ -0,0 +1,287 @@
+/***************************************************************************************
+* Algorithm Parallel Sort Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_PARALLEL_SORT_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_PARALLEL_SORT_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/algorithms/find.h"
+#include "aol/internal/algorithms/vectorized-sort.h"
+#include "aol/internal/threads/thread-pool.h"
+
+#include <algorithm>	// std::sort, std::min, std::max
+#include <bit>			// std::bit_ceil
+#include <functional>	// std::less
+#include <iterator>		// std::random_access_iterator, std::iter_value_t
+#include <memory>		// std::allocator, std::construct_at, std::destroy_at
+#include <type_traits>	// std::is_copy_constructible_v
+#include <utility>		// std::move
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Below this size, a range is sorted by one thread
+inline constexpr SizeT parallel_sort_cutoff = SizeT{ 1 } << 15;
+
+// Smallest range classified or scattered by one task
+inline constexpr SizeT parallel_sort_min_block = SizeT{ 1 } << 13;
+
+// Samples per bucket, more samples give more even buckets
+inline constexpr SizeT parallel_sort_oversampling = 32;
+
+// Buckets larger than their share are sample sorted again, up to this depth
+inline constexpr SizeT parallel_sort_max_depth = 2;
+
+// Element storage for the scatter, elements are constructed in and moved out of it
+template<typename T>
+struct ParallelSortBuffer
+{
+	std::allocator<T> allocator;
+	T* p_data;
+	SizeT count;
+
+	explicit ParallelSortBuffer(SizeT size) :
+		allocator{ },
+		p_data{ allocator.allocate(size) },
+		count{ size }
+	{
+	}
+
+	ParallelSortBuffer(const ParallelSortBuffer&) = delete;
+	ParallelSortBuffer& operator = (const ParallelSortBuffer&) = delete;
+
+	~ParallelSortBuffer()
+	{
+		allocator.deallocate(p_data, count);
+	}
+};
+
+/**
+* @details Samplesort on a ThreadPool
+*
+* - Splitters are picked from a sorted random sample, each block of the range is classified against them
+*   and scattered to its buckets in parallel, then every bucket is moved back and sorted by its own task
+*
+* - Every element is moved twice, compared about log2(bucket count) times for the classification and
+*   sorted within a bucket of about n / bucket count elements
+*/
+template<std::random_access_iterator It, typename Comparator> requires std::is_copy_constructible_v<std::iter_value_t<It>>
+void ParallelSampleSort(ThreadPool& pool, It it_begin, It it_end, Comparator& compare, SizeT depth)
+{
+	using value_type = std::iter_value_t<It>;
+
+	const SizeT count = static_cast<SizeT>(it_end - it_begin);
+	const SizeT concurrency = pool.concurrency();
+	if (count < parallel_sort_cutoff || concurrency == 1 || depth > parallel_sort_max_depth)
+	{
+		SortSerial(it_begin, it_end, compare);
+		return;
+	}
+
+	// A few buckets per thread balance the bucket sorts, 256 keep the bucket ids in a byte
+	const SizeT bucket_count = std::min<SizeT>(std::bit_ceil(concurrency * 4), 256);
+	const SizeT block_count = std::max<SizeT>(1, std::min(concurrency * 4, count / parallel_sort_min_block));
+	const SizeT block_size = (count + block_count - 1) / block_count;
+
+	// Splitters from a random sample (splitmix64 positions, fixed seed so runs are reproducible)
+	AoL::Vector<value_type> splitters;
+	{
+		const SizeT sample_count = bucket_count * parallel_sort_oversampling;
+		AoL::Vector<value_type> samples;
+		samples.reserve(sample_count);
+
+		U64 state = 0x9E3779B97F4A7C15ull ^ count;
+		for (SizeT i = 0; i < sample_count; ++i)
+		{
+			state += 0x9E3779B97F4A7C15ull;
+			U64 bits = state;
+			bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+			bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+			bits ^= bits >> 31;
+			samples.push_back(it_begin[static_cast<PtrDiff>(bits % count)]);
+		}
+		std::sort(samples.begin(), samples.end(), compare);
+
+		// Every sample is equal, most likely a heavily duplicated range that buckets would not split
+		if (!compare(samples.front(), samples.back())) AOL_ATTRIB_BRANCH_UNLIKELY
+		{
+			SortSerial(it_begin, it_end, compare);
+			return;
+		}
+
+		splitters.reserve(bucket_count - 1);
+		for (SizeT bucket = 1; bucket < bucket_count; ++bucket)
+		{
+			splitters.push_back(samples[bucket * parallel_sort_oversampling]);
+		}
+	}
+
+	// Bucket of an element: the number of splitters not greater than it
+	const value_type* p_splitters_begin = splitters.data();
+	const value_type* p_splitters_end = p_splitters_begin + splitters.size();
+	const auto bucket_of = [&](const value_type& value) -> SizeT
+	{
+		const value_type* p_found = AoL::FindLowerBoundBranchless(p_splitters_begin, p_splitters_end, value,
+			[&compare](const value_type& splitter, const value_type& query) { return !compare(query, splitter); });
+		return static_cast<SizeT>(p_found - p_splitters_begin);
+	};
+
+	// Classify: bucket id of every element and bucket sizes per block
+	AoL::Vector<U8> bucket_ids(count);
+	AoL::Vector<SizeT> block_offsets(block_count * bucket_count, 0);
+	{
+		TaskGroup group(pool);
+		for (SizeT block = 0; block < block_count; ++block)
+		{
+			group.run([&, block]()
+			{
+				const SizeT low = block * block_size;
+				const SizeT high = std::min(low + block_size, count);
+				SizeT* p_sizes = block_offsets.data() + block * bucket_count;
+				for (SizeT i = low; i < high; ++i)
+				{
+					const SizeT bucket = bucket_of(it_begin[static_cast<PtrDiff>(i)]);
+					bucket_ids[i] = static_cast<U8>(bucket);
+					++p_sizes[bucket];
+				}
+			});
+		}
+		group.wait();
+	}
+
+	// Offsets, bucket major so every bucket is contiguous and blocks keep their order within it
+	AoL::Vector<SizeT> bucket_begins(bucket_count + 1);
+	SizeT offset = 0;
+	for (SizeT bucket = 0; bucket < bucket_count; ++bucket)
+	{
+		bucket_begins[bucket] = offset;
+		for (SizeT block = 0; block < block_count; ++block)
+		{
+			SizeT& block_offset = block_offsets[block * bucket_count + bucket];
+			const SizeT size = block_offset;
+			block_offset = offset;
+			offset += size;
+		}
+	}
+	bucket_begins[bucket_count] = count;
+
+	// Scatter every block to its bucket slots
+	ParallelSortBuffer<value_type> buffer(count);
+	{
+		TaskGroup group(pool);
+		for (SizeT block = 0; block < block_count; ++block)
+		{
+			group.run([&, block]()
+			{
+				const SizeT low = block * block_size;
+				const SizeT high = std::min(low + block_size, count);
+				SizeT* p_offsets = block_offsets.data() + block * bucket_count;
+				for (SizeT i = low; i < high; ++i)
+				{
+					std::construct_at(buffer.p_data + p_offsets[bucket_ids[i]]++, std::move(it_begin[static_cast<PtrDiff>(i)]));
+				}
+			});
+		}
+		group.wait();
+	}
+
+	// Move every bucket back and sort it, buckets much larger than their share are split again
+	{
+		const SizeT large_bucket = 2 * count / bucket_count;
+		TaskGroup group(pool);
+		for (SizeT bucket = 0; bucket < bucket_count; ++bucket)
+		{
+			const SizeT low = bucket_begins[bucket];
+			const SizeT high = bucket_begins[bucket + 1];
+			if (low == high)
+			{
+				continue;
+			}
+
+			group.run([&, low, high]()
+			{
+				const It it_low = it_begin + static_cast<PtrDiff>(low);
+				for (SizeT i = low; i < high; ++i)
+				{
+					it_begin[static_cast<PtrDiff>(i)] = std::move(buffer.p_data[i]);
+					std::destroy_at(buffer.p_data + i);
+				}
+
+				const It it_high = it_begin + static_cast<PtrDiff>(high);
+				if (high - low > large_bucket)
+				{
+					ParallelSampleSort(pool, it_low, it_high, compare, depth + 1);
+				}
+				else
+				{
+					SortSerial(it_low, it_high, compare);
+				}
+			});
+		}
+		group.wait();
+	}
+}
+
+} // Internal namespace
+
+/**
+* @details Parallel sort on a library thread pool, no std parallel backend (i.e. TBB) needed
+*
+* - Samplesort: the range is split into about 4 buckets per thread by sampled splitters, in parallel,
+*   then every bucket is sorted by its own task (SortVectorized for the types and comparators it takes, std::sort otherwise)
+*
+* - Ranges under 32K elements, single thread pools and non copyable elements are sorted by the calling thread
+*
+* - Needs a buffer of the range size and one byte per element
+*
+* - Not stable, same as Sort
+*
+* @tparam It random access iterator type (can be a pointer)
+* @tparam Comparator comparison type (default: std::less)
+* @param pool thread pool the tasks run on, the calling thread helps
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param compare comparison function
+*/
+template<std::random_access_iterator It, typename Comparator = std::less<>>
+void SortParallel(ThreadPool& pool, It it_begin, It it_end, Comparator compare = Comparator{}) noexcept
+{
+	// Splitters are copies of sampled elements
+	if constexpr (std::is_copy_constructible_v<std::iter_value_t<It>>)
+	{
+		Internal::ParallelSampleSort(pool, it_begin, it_end, compare, 0);
+	}
+	else
+	{
+		std::sort(it_begin, it_end, compare);
+	}
+}
+
+/**
+* @details Parallel sort on DefaultThreadPool()
+*
+* @tparam It random access iterator type (can be a pointer)
+* @tparam Comparator comparison type (default: std::less)
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param compare comparison function
+*/
+template<std::random_access_iterator It, typename Comparator = std::less<>>
+void SortParallel(It it_begin, It it_end, Comparator compare = Comparator{}) noexcept
+{
+	SortParallel(DefaultThreadPool(), it_begin, it_end, compare);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_PARALLEL_SORT_H
@@ -0,0 +1,265 @@
+/***************************************************************************************
+* Algorithm Radix Sort Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_RADIX_SORT_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_RADIX_SORT_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+
+#include <algorithm>	// std::move
+#include <bit>			// std::bit_cast
+#include <concepts>		// std::integral, std::same_as, std::invocable
+#include <functional>	// std::invoke
+#include <iterator>		// std::contiguous_iterator, std::iter_value_t
+#include <memory>		// std::to_address
+#include <type_traits>	// std::make_unsigned_t, std::remove_cvref_t, std::invoke_result_t
+#include <utility>		// std::swap
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Keys RadixSort can order by their bits
+template<typename T>
+concept RadixKey = (std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, float> || std::same_as<T, double>;
+
+// Default RadixSortByKey projection, the key of a KeyValuePairEx (or any pair)
+struct PairFirstProjection
+{
+	template<typename P>
+	constexpr const auto& operator () (const P& pair) const noexcept
+	{
+		return pair.first;
+	}
+};
+
+template<typename T>
+using RadixBitsType = std::conditional_t<std::integral<T>, std::make_unsigned_t<std::conditional_t<std::integral<T>, T, int>>,
+					  std::conditional_t<sizeof(T) == 4, U32, U64>>;
+
+// Maps a key to unsigned bits with the same order
+// - signed: the sign bit is flipped
+// - floating point: negatives have every bit flipped, positives only the sign bit (-0.0 sorts before 0.0, NaNs go to the ends)
+template<RadixKey T>
+constexpr RadixBitsType<T> RadixOrderedBits(T key) noexcept
+{
+	using bits_t = RadixBitsType<T>;
+	constexpr bits_t sign_bit = static_cast<bits_t>(bits_t{ 1 } << (sizeof(bits_t) * 8 - 1));
+
+	if constexpr (std::unsigned_integral<T>)
+	{
+		return key;
+	}
+	else if constexpr (std::signed_integral<T>)
+	{
+		return static_cast<bits_t>(static_cast<bits_t>(key) ^ sign_bit);
+	}
+	else
+	{
+		const bits_t bits = std::bit_cast<bits_t>(key);
+		return (bits & sign_bit) != 0 ? static_cast<bits_t>(~bits) : static_cast<bits_t>(bits | sign_bit);
+	}
+}
+
+// Below this size, the histograms cost more than sorting by insertion
+inline constexpr SizeT radix_sort_insertion_cutoff = 64;
+
+template<typename It, typename KeyOf>
+void RadixInsertionSort(It it_begin, It it_end, KeyOf& key_of)
+{
+	for (It it = it_begin; it != it_end; ++it)
+	{
+		auto value = std::move(*it);
+		const auto bits = RadixOrderedBits(key_of(value));
+
+		It it_hole = it;
+		for (; it_hole != it_begin && bits < RadixOrderedBits(key_of(*(it_hole - 1))); --it_hole)
+		{
+			*it_hole = std::move(*(it_hole - 1));
+		}
+		*it_hole = std::move(value);
+	}
+}
+
+// From this size, 64 bit keys use 11 bit digits (6 passes instead of 8), below it the larger histograms cost more than the saved passes
+inline constexpr SizeT radix_sort_wide_digit_cutoff = SizeT{ 1 } << 16;
+
+// LSD radix sort on DigitBits digits, ping-ponging between the range and scratch
+template<SizeT DigitBits, typename It, typename T, typename KeyOf>
+void RadixSortPasses(It it_begin, It it_end, AoL::Vector<T>& scratch, KeyOf& key_of)
+{
+	using bits_t = decltype(RadixOrderedBits(key_of(*it_begin)));
+
+	constexpr SizeT digit_bits = DigitBits;
+	constexpr SizeT bucket_count = SizeT{ 1 } << digit_bits;
+	constexpr SizeT digit_count = (sizeof(bits_t) * 8 + digit_bits - 1) / digit_bits;
+
+	const SizeT count = static_cast<SizeT>(it_end - it_begin);
+	if (scratch.size() < count)
+	{
+		scratch.resize(count);
+	}
+
+	// Histograms of every digit in one pass
+	AoL::Vector<SizeT> histograms(digit_count * bucket_count);
+	T* p_source = std::to_address(it_begin);
+	for (SizeT i = 0; i < count; ++i)
+	{
+		const bits_t bits = RadixOrderedBits(key_of(p_source[i]));
+		for (SizeT digit = 0; digit < digit_count; ++digit)
+		{
+			++histograms[digit * bucket_count + ((bits >> (digit * digit_bits)) & (bucket_count - 1))];
+		}
+	}
+
+	T* p_target = scratch.data();
+	const bits_t first_bits = RadixOrderedBits(key_of(p_source[0]));
+	for (SizeT digit = 0; digit < digit_count; ++digit)
+	{
+		SizeT* p_offsets = histograms.data() + digit * bucket_count;
+		const SizeT shift = digit * digit_bits;
+
+		// Every key has the same digit, the pass would not move anything
+		if (p_offsets[(first_bits >> shift) & (bucket_count - 1)] == count)
+		{
+			continue;
+		}
+
+		SizeT offset = 0;
+		for (SizeT bucket = 0; bucket < bucket_count; ++bucket)
+		{
+			const SizeT bucket_size = p_offsets[bucket];
+			p_offsets[bucket] = offset;
+			offset += bucket_size;
+		}
+
+		for (SizeT i = 0; i < count; ++i)
+		{
+			const SizeT bucket = (RadixOrderedBits(key_of(p_source[i])) >> shift) & (bucket_count - 1);
+			p_target[p_offsets[bucket]++] = std::move(p_source[i]);
+		}
+
+		std::swap(p_source, p_target);
+	}
+
+	if (p_source != std::to_address(it_begin))
+	{
+		std::move(p_source, p_source + count, std::to_address(it_begin));
+	}
+}
+
+template<typename It, typename T, typename KeyOf>
+void RadixSortImpl(It it_begin, It it_end, AoL::Vector<T>& scratch, KeyOf key_of)
+{
+	using bits_t = decltype(RadixOrderedBits(key_of(*it_begin)));
+
+	const SizeT count = static_cast<SizeT>(it_end - it_begin);
+	if (count < radix_sort_insertion_cutoff)
+	{
+		RadixInsertionSort(it_begin, it_end, key_of);
+	}
+	else if (sizeof(bits_t) == 8 && count >= radix_sort_wide_digit_cutoff)
+	{
+		RadixSortPasses<11>(it_begin, it_end, scratch, key_of);
+	}
+	else
+	{
+		RadixSortPasses<8>(it_begin, it_end, scratch, key_of);
+	}
+}
+
+} // Internal namespace
+
+/**
+* @details LSD radix sort for integral and floating point keys
+*
+* - Sorts in ascending order, same as Sort with std::less, in O(n * sizeof(T)) with no comparisons
+*
+* - One pass over the range builds the histograms of every digit (8 bits, 11 bits for large ranges of 64 bit keys), then
+*   each digit moves the elements once between the range and scratch. Digits shared by every key
+*   (i.e. the high bits of small values) are skipped
+*
+* - scratch is grown to the range size if needed and can be reused across calls to avoid reallocations
+*
+* - Ranges under 64 elements are insertion sorted
+*
+* @tparam It contiguous iterator type (can be a pointer)
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param scratch reusable buffer of the range's value type
+*/
+template<std::contiguous_iterator It> requires Internal::RadixKey<std::iter_value_t<It>>
+void RadixSort(It it_begin, It it_end, AoL::Vector<std::iter_value_t<It>>& scratch)
+{
+	Internal::RadixSortImpl(it_begin, it_end, scratch, [](const auto& value) { return value; });
+}
+
+/**
+* @details LSD radix sort for integral and floating point keys, with its own scratch buffer
+*
+* @tparam It contiguous iterator type (can be a pointer)
+* @param it_begin start of the range
+* @param it_end end of the range
+*/
+template<std::contiguous_iterator It> requires Internal::RadixKey<std::iter_value_t<It>>
+void RadixSort(It it_begin, It it_end)
+{
+	AoL::Vector<std::iter_value_t<It>> scratch;
+	RadixSort(it_begin, it_end, scratch);
+}
+
+/**
+* @details Stable LSD radix sort of elements by an integral or floating point key
+*
+* - Same passes as RadixSort, elements with equal keys keep their order
+*
+* - The default projection sorts KeyValuePairEx (and other pairs) by first
+*
+* - The elements are moved between the range and scratch, so they must be default constructible and movable
+*
+* @tparam It contiguous iterator type (can be a pointer)
+* @tparam Projection key extraction (default: .first)
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param scratch reusable buffer of the range's value type
+* @param projection key extraction
+*/
+template<std::contiguous_iterator It, typename Projection = Internal::PairFirstProjection>
+	requires std::invocable<Projection&, const std::iter_value_t<It>&>
+		&& Internal::RadixKey<std::remove_cvref_t<std::invoke_result_t<Projection&, const std::iter_value_t<It>&>>>
+void RadixSortByKey(It it_begin, It it_end, AoL::Vector<std::iter_value_t<It>>& scratch, Projection projection = Projection{})
+{
+	using key_t = std::remove_cvref_t<std::invoke_result_t<Projection&, const std::iter_value_t<It>&>>;
+	Internal::RadixSortImpl(it_begin, it_end, scratch, [&projection](const auto& value) -> key_t { return std::invoke(projection, value); });
+}
+
+/**
+* @details Stable LSD radix sort of elements by an integral or floating point key, with its own scratch buffer
+*
+* @tparam It contiguous iterator type (can be a pointer)
+* @tparam Projection key extraction (default: .first)
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param projection key extraction
+*/
+template<std::contiguous_iterator It, typename Projection = Internal::PairFirstProjection>
+	requires std::invocable<Projection&, const std::iter_value_t<It>&>
+		&& Internal::RadixKey<std::remove_cvref_t<std::invoke_result_t<Projection&, const std::iter_value_t<It>&>>>
+void RadixSortByKey(It it_begin, It it_end, Projection projection = Projection{})
+{
+	AoL::Vector<std::iter_value_t<It>> scratch;
+	RadixSortByKey(it_begin, it_end, scratch, projection);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_RADIX_SORT_H
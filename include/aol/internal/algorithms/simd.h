@@ -0,0 +1,486 @@
+/***************************************************************************************
+* Algorithm SIMD Helpers
+****************************************************************************************
+* - Thin wrappers over the SSE2/SSE4.2/AVX2 compare intrinsics used by the search algorithms
+* - Only the widest instruction set enabled at compile time is used (see AOL_SIMD_*)
+* - RuntimeIsa() reports the widest instruction set of the running CPU, for code compiled with
+*   AOL_TARGET_AVX2/AOL_TARGET_AVX512 that is picked at runtime
+* - Masks are always byte masks (one bit per byte of the vector), so the lane count of a
+*   mask is popcount(mask) / sizeof(T) and the first lane is countr_zero(mask) / sizeof(T)
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_SIMD_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_SIMD_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+
+#include <bit>			// std::popcount, std::countr_zero
+#include <concepts>		// std::integral
+#include <functional>	// std::less
+#include <type_traits>	// std::is_same_v, std::is_unsigned_v, std::make_signed_t
+
+#if AOL_SIMD_AVX2 || AOL_SIMD_SSE2 || AOL_SIMD_X86
+#include <immintrin.h>
+#endif
+#if AOL_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>		// __cpuid, __cpuidex, _xgetbv
+#endif
+
+
+namespace AoL::Internal::Simd
+{
+
+// Instruction sets picked at runtime, each one implies the previous ones
+enum class Isa : U8
+{
+	Scalar,
+	Avx2,
+	Avx512
+};
+
+// Widest instruction set the CPU and the OS (saved vector registers) support
+inline Isa DetectIsa() noexcept
+{
+#if AOL_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+	{
+		return Isa::Avx512;
+	}
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return Isa::Avx2;
+	}
+	return Isa::Scalar;
+#elif AOL_SIMD_X86 && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return Isa::Scalar;
+	}
+
+	// AVX needs OSXSAVE and the OS saving the YMM state, AVX-512 the opmask and ZMM states too
+	__cpuid(info, 1);
+	const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x06) == 0x06;
+	if (!os_saves_ymm)
+	{
+		return Isa::Scalar;
+	}
+
+	__cpuidex(info, 7, 0);
+	if ((info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6)
+	{
+		return Isa::Avx512;
+	}
+	return (info[1] & (1 << 5)) != 0 ? Isa::Avx2 : Isa::Scalar;
+#else
+	return Isa::Scalar;
+#endif
+}
+
+// DetectIsa() of the running CPU, detected once
+inline Isa RuntimeIsa() noexcept
+{
+	static const Isa isa = DetectIsa();
+	return isa;
+}
+
+#if AOL_SIMD_AVX2
+
+using VecI = __m256i;
+
+template<SizeT Bytes>
+struct IntOps
+{
+	static constexpr bool supported = false;
+};
+
+template<>
+struct IntOps<1>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I8 value) noexcept { return _mm256_set1_epi8(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm256_cmpgt_epi8(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm256_cmpeq_epi8(a, b); }
+};
+
+template<>
+struct IntOps<2>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I16 value) noexcept { return _mm256_set1_epi16(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm256_cmpgt_epi16(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm256_cmpeq_epi16(a, b); }
+};
+
+template<>
+struct IntOps<4>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I32 value) noexcept { return _mm256_set1_epi32(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm256_cmpgt_epi32(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm256_cmpeq_epi32(a, b); }
+};
+
+template<>
+struct IntOps<8>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I64 value) noexcept { return _mm256_set1_epi64x(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm256_cmpgt_epi64(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm256_cmpeq_epi64(a, b); }
+};
+
+inline VecI LoadI(const void* p) noexcept { return _mm256_loadu_si256(static_cast<const VecI*>(p)); }
+inline VecI XorI(VecI a, VecI b) noexcept { return _mm256_xor_si256(a, b); }
+inline U32 MaskI(VecI a) noexcept { return static_cast<U32>(_mm256_movemask_epi8(a)); }
+
+struct FloatOps
+{
+	using vec = __m256;
+	static vec Broadcast(float value) noexcept { return _mm256_set1_ps(value); }
+	static vec Load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+	static U32 LessMask(vec a, vec b) noexcept { return MaskI(_mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ))); }
+	static U32 EqualMask(vec a, vec b) noexcept { return MaskI(_mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+};
+
+struct DoubleOps
+{
+	using vec = __m256d;
+	static vec Broadcast(double value) noexcept { return _mm256_set1_pd(value); }
+	static vec Load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+	static U32 LessMask(vec a, vec b) noexcept { return MaskI(_mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_LT_OQ))); }
+	static U32 EqualMask(vec a, vec b) noexcept { return MaskI(_mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+};
+
+#elif AOL_SIMD_SSE2
+
+using VecI = __m128i;
+
+template<SizeT Bytes>
+struct IntOps
+{
+	static constexpr bool supported = false;
+};
+
+template<>
+struct IntOps<1>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I8 value) noexcept { return _mm_set1_epi8(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm_cmpgt_epi8(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm_cmpeq_epi8(a, b); }
+};
+
+template<>
+struct IntOps<2>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I16 value) noexcept { return _mm_set1_epi16(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm_cmpgt_epi16(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm_cmpeq_epi16(a, b); }
+};
+
+template<>
+struct IntOps<4>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I32 value) noexcept { return _mm_set1_epi32(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm_cmpgt_epi32(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm_cmpeq_epi32(a, b); }
+};
+
+// SSE2 has no 64-bit integer compares, equality comes with SSE4.1 and ordering with SSE4.2
+#if AOL_SIMD_SSE42
+template<>
+struct IntOps<8>
+{
+	static constexpr bool supported = true;
+	static VecI Broadcast(I64 value) noexcept { return _mm_set1_epi64x(value); }
+	static VecI Greater(VecI a, VecI b) noexcept { return _mm_cmpgt_epi64(a, b); }
+	static VecI Equal(VecI a, VecI b) noexcept { return _mm_cmpeq_epi64(a, b); }
+};
+#endif
+
+inline VecI LoadI(const void* p) noexcept { return _mm_loadu_si128(static_cast<const VecI*>(p)); }
+inline VecI XorI(VecI a, VecI b) noexcept { return _mm_xor_si128(a, b); }
+inline U32 MaskI(VecI a) noexcept { return static_cast<U32>(_mm_movemask_epi8(a)); }
+
+struct FloatOps
+{
+	using vec = __m128;
+	static vec Broadcast(float value) noexcept { return _mm_set1_ps(value); }
+	static vec Load(const float* p) noexcept { return _mm_loadu_ps(p); }
+	static U32 LessMask(vec a, vec b) noexcept { return MaskI(_mm_castps_si128(_mm_cmplt_ps(a, b))); }
+	static U32 EqualMask(vec a, vec b) noexcept { return MaskI(_mm_castps_si128(_mm_cmpeq_ps(a, b))); }
+};
+
+struct DoubleOps
+{
+	using vec = __m128d;
+	static vec Broadcast(double value) noexcept { return _mm_set1_pd(value); }
+	static vec Load(const double* p) noexcept { return _mm_loadu_pd(p); }
+	static U32 LessMask(vec a, vec b) noexcept { return MaskI(_mm_castpd_si128(_mm_cmplt_pd(a, b))); }
+	static U32 EqualMask(vec a, vec b) noexcept { return MaskI(_mm_castpd_si128(_mm_cmpeq_pd(a, b))); }
+};
+
+#endif
+
+/**
+* @details Per element type compare operations, supported is false when there is no SIMD path for T
+*
+* - Unsigned integers are biased by their sign bit so the signed compares order them correctly.
+*   Broadcast() applies the bias to the value, the compares apply it to the loaded vector
+*/
+template<typename T>
+struct Ops
+{
+	static constexpr bool supported = false;
+};
+
+#if AOL_SIMD_AVX2 || AOL_SIMD_SSE2
+
+template<std::integral T> requires (!std::is_same_v<T, bool> && IntOps<sizeof(T)>::supported)
+struct Ops<T>
+{
+	using vec = VecI;
+	using int_ops = IntOps<sizeof(T)>;
+
+	static constexpr bool supported = true;
+	static constexpr SizeT lanes = sizeof(vec) / sizeof(T);
+
+	static vec Bias() noexcept
+	{
+		using signed_t = std::make_signed_t<T>;
+		return int_ops::Broadcast(static_cast<signed_t>(std::make_unsigned_t<T>(1) << (sizeof(T) * 8 - 1)));
+	}
+
+	static vec Broadcast(T value) noexcept
+	{
+		const vec broadcast = int_ops::Broadcast(static_cast<std::make_signed_t<T>>(value));
+		if constexpr (std::is_unsigned_v<T>)
+		{
+			return XorI(broadcast, Bias());
+		}
+		else
+		{
+			return broadcast;
+		}
+	}
+
+	static vec Load(const T* p) noexcept
+	{
+		return LoadI(p);
+	}
+
+	// Byte mask of the lanes where a < b (b must come from Broadcast)
+	static U32 LessMask(vec a, vec b) noexcept
+	{
+		if constexpr (std::is_unsigned_v<T>)
+		{
+			a = XorI(a, Bias());
+		}
+		return MaskI(int_ops::Greater(b, a));
+	}
+
+	// Byte mask of the lanes where a == b (b must come from Broadcast)
+	static U32 EqualMask(vec a, vec b) noexcept
+	{
+		if constexpr (std::is_unsigned_v<T>)
+		{
+			a = XorI(a, Bias());
+		}
+		return MaskI(int_ops::Equal(a, b));
+	}
+};
+
+template<>
+struct Ops<float> : FloatOps
+{
+	static constexpr bool supported = true;
+	static constexpr SizeT lanes = sizeof(vec) / sizeof(float);
+};
+
+template<>
+struct Ops<double> : DoubleOps
+{
+	static constexpr bool supported = true;
+	static constexpr SizeT lanes = sizeof(vec) / sizeof(double);
+};
+
+#endif
+
+// True if T has a SIMD path on the instruction set enabled at compile time
+template<typename T>
+concept Supported = Ops<T>::supported;
+
+// True if Comparator is a plain < on T, the only comparison the SIMD paths reproduce
+template<typename Comparator, typename T>
+concept PlainLess = std::is_same_v<Comparator, std::less<void>> || std::is_same_v<Comparator, std::less<T>>;
+
+/**
+* @details Counts the elements of a fixed size block that are less than value
+*
+* - N must be a multiple of the lane count of T
+*
+* @tparam N number of elements in the block
+* @tparam T element type, must satisfy Supported<T>
+* @param p_keys start of the block
+* @param value value to compare against
+* @return number of elements in [p_keys, p_keys + N) that are < value
+*/
+template<SizeT N, typename T> requires Supported<T>
+SizeT CountLessFixed(const T* p_keys, T value) noexcept
+{
+	using ops = Ops<T>;
+	static_assert(N % ops::lanes == 0, "Block size must be a multiple of the lane count!");
+
+	const auto broadcast = ops::Broadcast(value);
+	SizeT bits = 0;
+	for (SizeT i = 0; i < N; i += ops::lanes)
+	{
+		bits += static_cast<SizeT>(std::popcount(ops::LessMask(ops::Load(p_keys + i), broadcast)));
+	}
+	return bits / sizeof(T);
+}
+
+/**
+* @details Counts the elements of a range that are less than value, without branching on the data
+*
+* - On a sorted range this is the lower bound position of value
+*
+* - The last partial vector is an overlapping load of the final lanes with the already counted
+*   lanes masked off. Ranges shorter than one vector are counted one element at a time
+*
+* @tparam T element type, must satisfy Supported<T>
+* @param p_first start of the range
+* @param p_last end of the range
+* @param value value to compare against
+* @return number of elements in [p_first, p_last) that are < value
+*/
+template<typename T> requires Supported<T>
+SizeT CountLess(const T* p_first, const T* p_last, T value) noexcept
+{
+	using ops = Ops<T>;
+	constexpr SizeT lanes = ops::lanes;
+
+	const SizeT count = static_cast<SizeT>(p_last - p_first);
+	if (count < lanes)
+	{
+		SizeT less_count = 0;
+		for (; p_first != p_last; ++p_first)
+		{
+			less_count += static_cast<SizeT>(*p_first < value);
+		}
+		return less_count;
+	}
+
+	const auto broadcast = ops::Broadcast(value);
+	SizeT bits = 0;
+	const T* p_current = p_first;
+	for (; p_last - p_current >= static_cast<PtrDiff>(lanes); p_current += lanes)
+	{
+		bits += static_cast<SizeT>(std::popcount(ops::LessMask(ops::Load(p_current), broadcast)));
+	}
+
+	const SizeT overlap_bytes = (lanes - static_cast<SizeT>(p_last - p_current)) * sizeof(T);
+	if (overlap_bytes != sizeof(typename ops::vec))
+	{
+		const U32 mask = ops::LessMask(ops::Load(p_last - lanes), broadcast);
+		bits += static_cast<SizeT>(std::popcount(mask >> overlap_bytes));
+	}
+
+	return bits / sizeof(T);
+}
+
+/**
+* @details Linear search for the first element equal to value
+*
+* - Compares four vectors per iteration and branches once on their combined mask
+*
+* - The last (up to four) vectors are loaded at clamped, overlapping positions that end exactly at
+*   p_last, so short ranges run without a loop. Ranges shorter than one vector are scanned one element at a time
+*
+* @tparam T element type, must satisfy Supported<T>
+* @param p_first start of the range
+* @param p_last end of the range
+* @param value value to be found
+* @return pointer to the first element == value, p_last if none
+*/
+template<typename T> requires Supported<T>
+const T* FindEqual(const T* p_first, const T* p_last, T value) noexcept
+{
+	using ops = Ops<T>;
+	constexpr SizeT lanes = ops::lanes;
+	constexpr SizeT mask_bits = sizeof(typename ops::vec);
+
+	if (static_cast<SizeT>(p_last - p_first) < lanes)
+	{
+		for (; p_first != p_last; ++p_first)
+		{
+			if (*p_first == value)
+			{
+				return p_first;
+			}
+		}
+		return p_last;
+	}
+
+	const auto broadcast = ops::Broadcast(value);
+	const T* p_current = p_first;
+	for (; p_last - p_current > static_cast<PtrDiff>(lanes * 4); p_current += lanes * 4)
+	{
+		const U32 mask_0 = ops::EqualMask(ops::Load(p_current), broadcast);
+		const U32 mask_1 = ops::EqualMask(ops::Load(p_current + lanes), broadcast);
+		const U32 mask_2 = ops::EqualMask(ops::Load(p_current + lanes * 2), broadcast);
+		const U32 mask_3 = ops::EqualMask(ops::Load(p_current + lanes * 3), broadcast);
+		if ((mask_0 | mask_1 | mask_2 | mask_3) != 0)
+		{
+			const U64 mask_low = static_cast<U64>(mask_0) | (static_cast<U64>(mask_1) << mask_bits);
+			const U64 mask_high = static_cast<U64>(mask_2) | (static_cast<U64>(mask_3) << mask_bits);
+			return mask_low != 0
+				? p_current + std::countr_zero(mask_low) / sizeof(T)
+				: p_current + lanes * 2 + std::countr_zero(mask_high) / sizeof(T);
+		}
+	}
+
+	// Overlapping lanes were either already checked or are checked by an earlier load, which holds no match
+	// - under one vector can remain after the loop, every load is clamped so it ends at p_last at most
+	// - the clamps compare the remaining count, p_current + lanes * k may already be past p_last
+	const SizeT remaining = static_cast<SizeT>(p_last - p_current);
+	const T* p_tail = p_last - lanes;
+	const T* p_load_0 = remaining > lanes ? p_current : p_tail;
+	const T* p_load_1 = remaining > lanes * 2 ? p_current + lanes : p_tail;
+	const T* p_load_2 = remaining > lanes * 3 ? p_current + lanes * 2 : p_tail;
+	const U32 mask_0 = ops::EqualMask(ops::Load(p_load_0), broadcast);
+	const U32 mask_1 = ops::EqualMask(ops::Load(p_load_1), broadcast);
+	const U32 mask_2 = ops::EqualMask(ops::Load(p_load_2), broadcast);
+	const U32 mask_3 = ops::EqualMask(ops::Load(p_tail), broadcast);
+	if (mask_0 != 0)
+	{
+		return p_load_0 + std::countr_zero(mask_0) / sizeof(T);
+	}
+	if (mask_1 != 0)
+	{
+		return p_load_1 + std::countr_zero(mask_1) / sizeof(T);
+	}
+	if (mask_2 != 0)
+	{
+		return p_load_2 + std::countr_zero(mask_2) / sizeof(T);
+	}
+	if (mask_3 != 0)
+	{
+		return p_tail + std::countr_zero(mask_3) / sizeof(T);
+	}
+
+	return p_last;
+}
+
+} // AoL::Internal::Simd namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_SIMD_H
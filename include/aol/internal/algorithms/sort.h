@@ -9,77 +9,350 @@
 #include "aol/macros.h"
 #include "aol/traits.h"
 #include "aol/types.h"
+#include "aol/internal/algorithms/parallel-sort.h"
+#include "aol/internal/algorithms/sorting-network.h"
+#include "aol/internal/algorithms/vectorized-sort.h"
+#include "aol/internal/algorithms/radix-sort.h"
 
 #include <algorithm>	// std::sort
-#include <utility>		// std::forward
-#include <iterator>		// std::make_reverse_iterator
+#include <bit>			// std::bit_cast
+#include <concepts>		// std::invocable
+#include <execution>	// std::is_execution_policy_v, std::execution::parallel_policy
+#include <functional>	// std::less, std::greater, std::invoke
+#include <type_traits>	// std::is_same_v, std::remove_cvref_t, std::is_constant_evaluated, std::invoke_result_t
+#include <utility>		// std::forward, std::move, std::pair
+#include <iterator>		// std::make_reverse_iterator, std::begin, std::end, std::iter_reference_t
+#include <memory>		// std::construct_at, std::destroy_at
 
 
 namespace AoL
 {
 
+namespace Internal
+{
+
+// Parallel policies run SortParallel, the std ones quietly run sequentially without a backend (i.e. TBB on libstdc++)
+template<typename E, typename It>
+concept SortParallelPolicy = std::random_access_iterator<It> &&
+	(std::is_same_v<std::remove_cvref_t<E>, std::execution::parallel_policy> || std::is_same_v<std::remove_cvref_t<E>, std::execution::parallel_unsequenced_policy>);
+
+// Below this size, SortBy compares the projected elements directly
+inline constexpr SizeT sort_by_decorate_cutoff = 256;
+
+template<typename It, typename Projection>
+using SortByKey = std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<It>>>;
+
+// Projections whose keys SortBy caches next to the element indices: arithmetic keys up to 32 bits compared with < or >
+// - 64 bit keys measured slower cached (key/index pairs, RadixSortByKey and the gather) than std::sort on the elements
+//   at every size from 4K to 2M 64 byte records, so they stay on std::sort
+template<typename It, typename Projection, typename Comparator>
+concept SortByDecorated = RadixKey<SortByKey<It, Projection>> && sizeof(RadixBitsType<SortByKey<It, Projection>>) <= 4
+	&& (Simd::PlainLess<Comparator, SortByKey<It, Projection>> || VectorSortGreater<Comparator, SortByKey<It, Projection>>);
+
+// Moves every element to its sorted position, order[i] is the index of the element that goes to i
+// - the elements are gathered into a buffer then moved back: the reads of the gather do not depend on each other
+//   so their cache misses overlap, unlike following the permutation cycles in place
+template<std::random_access_iterator It>
+void SortByPermute(It it_begin, const AoL::Vector<SizeT>& order) noexcept
+{
+	using value_type = std::iter_value_t<It>;
+
+	const SizeT count = order.size();
+	ParallelSortBuffer<value_type> buffer(count);
+	for (SizeT i = 0; i < count; ++i)
+	{
+		std::construct_at(buffer.p_data + i, std::move(it_begin[static_cast<PtrDiff>(order[i])]));
+	}
+	for (SizeT i = 0; i < count; ++i)
+	{
+		it_begin[static_cast<PtrDiff>(i)] = std::move(buffer.p_data[i]);
+		std::destroy_at(buffer.p_data + i);
+	}
+}
+
+/**
+* @details Decorate-sort-undecorate: the keys are extracted once into a contiguous array with the element indices,
+*   sorted there, and the elements are moved to their sorted position
+*
+* - Keys (up to 32 bits) are packed above their index in one I64 sorted by SortVectorized, equal keys keep their order
+*
+* - At most 2^32 elements, the index takes the low 32 bits
+*/
+template<bool Descending, std::random_access_iterator It, typename Projection>
+void SortByDecorate(It it_begin, It it_end, Projection& projection) noexcept
+{
+	using key_type = SortByKey<It, Projection>;
+	using bits_type = RadixBitsType<key_type>;
+
+	const SizeT count = static_cast<SizeT>(it_end - it_begin);
+	const auto ordered_bits = [&projection](std::iter_reference_t<It> element) -> bits_type
+	{
+		// + 0 turns -0.0 into 0.0, equal for < and so kept in order
+		const bits_type bits = RadixOrderedBits(static_cast<key_type>(std::invoke(projection, element) + key_type{ 0 }));
+		return Descending ? static_cast<bits_type>(~bits) : bits;
+	};
+
+	// Flipping the top bit turns the unsigned order of key and index into the signed order of I64
+	constexpr U64 sign_bit = U64{ 1 } << 63;
+	AoL::Vector<I64> packed(count);
+	for (SizeT i = 0; i < count; ++i)
+	{
+		packed[i] = std::bit_cast<I64>(((static_cast<U64>(ordered_bits(it_begin[static_cast<PtrDiff>(i)])) << 32) | i) ^ sign_bit);
+	}
+	SortVectorized(packed.begin(), packed.end());
+
+	AoL::Vector<SizeT> order(count);
+	for (SizeT i = 0; i < count; ++i)
+	{
+		order[i] = static_cast<SizeT>(static_cast<U32>(packed[i]));
+	}
+	SortByPermute(it_begin, order);
+}
+
+} // Internal namespace
+
 // Sort the whole container
 // - use std::sort for custom size container
+// - whole ArrayNamed2/3/4 ranges use SortFixed
+// - contiguous I32, U32, I64, float and double ranges use SortVectorized
 template<typename It>
 constexpr void Sort(It it_begin, It it_end) noexcept
 {
+	if constexpr (constexpr SizeT size = Internal::array_iterator_size_v<It>; size != 0 && size <= Internal::sorting_network_max_size)
+	{
+		if (it_end - it_begin == static_cast<PtrDiff>(size))
+		{
+			SortFixed<size>(it_begin);
+			return;
+		}
+	}
+	if constexpr (Internal::VectorSortable<It, std::less<>>)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SortVectorized(it_begin, it_end);
+			return;
+		}
+	}
 	std::sort(it_begin, it_end);
 }
 
 // Sort the whole container with comparator
 // - use std::sort for custom size container
+// - whole ArrayNamed2/3/4 ranges use SortFixed
+// - contiguous I32, U32, I64, float and double ranges with std::less or std::greater use SortVectorized
 template<typename It, typename F>
 constexpr void Sort(It it_begin, It it_end, F&& f) noexcept requires (!std::is_execution_policy_v<F>)
 {
+	if constexpr (constexpr SizeT size = Internal::array_iterator_size_v<It>; size != 0 && size <= Internal::sorting_network_max_size)
+	{
+		if (it_end - it_begin == static_cast<PtrDiff>(size))
+		{
+			SortFixed<size>(it_begin, std::forward<F>(f));
+			return;
+		}
+	}
+	if constexpr (Internal::VectorSortable<It, F>)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SortVectorized(it_begin, it_end, std::remove_cvref_t<F>{});
+			return;
+		}
+	}
 	std::sort(it_begin, it_end, std::forward<F>(f));
 }
 
+// Sort a fixed size container (C array, AoL::Array, ArrayNamed2/3/4)
+// - up to 32 elements use SortFixed, larger ones Sort
+template<Internal::FixedSizeContainer A>
+constexpr void Sort(A& arr) noexcept
+{
+	if constexpr (Internal::fixed_size_v<A> <= Internal::sorting_network_max_size)
+	{
+		SortFixed(arr);
+	}
+	else
+	{
+		Sort(std::begin(arr), std::end(arr));
+	}
+}
+
+// Sort a fixed size container (C array, AoL::Array, ArrayNamed2/3/4) with comparator
+// - up to 32 elements use SortFixed, larger ones Sort
+template<Internal::FixedSizeContainer A, typename F>
+constexpr void Sort(A& arr, F&& f) noexcept requires (!std::is_execution_policy_v<std::remove_cvref_t<F>>)
+{
+	if constexpr (Internal::fixed_size_v<A> <= Internal::sorting_network_max_size)
+	{
+		SortFixed(arr, std::forward<F>(f));
+	}
+	else
+	{
+		Sort(std::begin(arr), std::end(arr), std::forward<F>(f));
+	}
+}
+
 // Sort the whole container with custom execution
 // - use std::sort for custom size container
+// - par and par_unseq use SortParallel on DefaultThreadPool()
 template<typename It, typename E>
-constexpr void Sort(E&& e, It it_begin, It it_end) noexcept requires std::is_execution_policy_v<E>
+constexpr void Sort(E&& e, It it_begin, It it_end) noexcept requires std::is_execution_policy_v<std::remove_cvref_t<E>>
 {
-	std::sort(std::forward<E>(e), it_begin, it_end);
+	if constexpr (Internal::SortParallelPolicy<E, It>)
+	{
+		SortParallel(it_begin, it_end);
+	}
+	else
+	{
+		std::sort(std::forward<E>(e), it_begin, it_end);
+	}
 }
 
 // Sort the whole container with custom execution and comparator
 // - use std::sort for custom size container
+// - par and par_unseq use SortParallel on DefaultThreadPool()
 template<typename It, typename F, typename E>
-constexpr void Sort(E&& e, It it_begin, It it_end, F&& f) noexcept requires (!std::is_execution_policy_v<F>) && std::is_execution_policy_v<E>
+constexpr void Sort(E&& e, It it_begin, It it_end, F&& f) noexcept requires (!std::is_execution_policy_v<F>) && std::is_execution_policy_v<std::remove_cvref_t<E>>
 {
-	std::sort(std::forward<E>(e), it_begin, it_end, std::forward<F>(f));
+	if constexpr (Internal::SortParallelPolicy<E, It>)
+	{
+		SortParallel(it_begin, it_end, std::forward<F>(f));
+	}
+	else
+	{
+		std::sort(std::forward<E>(e), it_begin, it_end, std::forward<F>(f));
+	}
 }
 
 // Reverse sort the whole container
 // - use std::sort for custom size container
+// - contiguous I32, U32, I64, float and double ranges use SortVectorized
 template<typename It>
 constexpr void SortReverse(It it_begin, It it_end) noexcept
 {
+	if constexpr (Internal::VectorSortable<It, std::greater<>>)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			SortVectorized(it_begin, it_end, std::greater<>{});
+			return;
+		}
+	}
 	std::sort(std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin));
 }
 
 // Reverse sort the whole container with comparator
 // - use std::sort for custom size container
+// - contiguous I32, U32, I64, float and double ranges with std::less or std::greater use SortVectorized
 template<typename It, typename F>
 constexpr void SortReverse(It it_begin, It it_end, F&& f) noexcept requires (!std::is_execution_policy_v<F>)
 {
+	if constexpr (Internal::VectorSortable<It, F>)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			if constexpr (Internal::VectorSortGreater<std::remove_cvref_t<F>, std::iter_value_t<It>>)
+			{
+				SortVectorized(it_begin, it_end, std::less<>{});
+			}
+			else
+			{
+				SortVectorized(it_begin, it_end, std::greater<>{});
+			}
+			return;
+		}
+	}
 	std::sort(std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin), std::forward<F>(f));
 }
 
 // Reverse sort the whole container with custom execution
 // - use std::sort for custom size container
+// - par and par_unseq use SortParallel on DefaultThreadPool()
 template<typename It, typename E>
-constexpr void SortReverse(E&& e, It it_begin, It it_end) noexcept requires std::is_execution_policy_v<E>
+constexpr void SortReverse(E&& e, It it_begin, It it_end) noexcept requires std::is_execution_policy_v<std::remove_cvref_t<E>>
 {
-	std::sort(std::forward<E>(e), std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin));
+	if constexpr (Internal::SortParallelPolicy<E, It>)
+	{
+		SortParallel(std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin));
+	}
+	else
+	{
+		std::sort(std::forward<E>(e), std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin));
+	}
 }
 
 // Reverse sort the whole container with custom execution and comparator
 // - use std::sort for custom size container
+// - par and par_unseq use SortParallel on DefaultThreadPool()
 template<typename It, typename F, typename E>
-constexpr void SortReverse(E&& e, It it_begin, It it_end, F&& f) noexcept requires (!std::is_execution_policy_v<F>) && std::is_execution_policy_v<E>
+constexpr void SortReverse(E&& e, It it_begin, It it_end, F&& f) noexcept requires (!std::is_execution_policy_v<F>) && std::is_execution_policy_v<std::remove_cvref_t<E>>
+{
+	if constexpr (Internal::SortParallelPolicy<E, It>)
+	{
+		SortParallel(std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin), std::forward<F>(f));
+	}
+	else
+	{
+		std::sort(std::forward<E>(e), std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin), std::forward<F>(f));
+	}
+}
+
+/**
+* @details Sort the whole container by a projected key with a comparator on the keys
+*
+* - std::less and std::greater on integral and floating point keys up to 32 bits take the cached key path, see SortBy
+*
+* @tparam It random access iterator type (can be a pointer)
+* @tparam Projection key extraction, any std::invoke callable (member pointer, member function pointer, lambda)
+* @tparam Comparator comparison type of the keys
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param projection key extraction
+* @param compare comparison function of the keys
+*/
+template<std::random_access_iterator It, typename Projection, typename Comparator>
+	requires std::invocable<Projection&, std::iter_reference_t<It>>
+void SortBy(It it_begin, It it_end, Projection projection, Comparator compare) noexcept
+{
+	if constexpr (Internal::SortByDecorated<It, Projection, Comparator>)
+	{
+		const SizeT count = static_cast<SizeT>(it_end - it_begin);
+		if (count >= Internal::sort_by_decorate_cutoff && count <= SizeT{ 0xFFFFFFFF })
+		{
+			Internal::SortByDecorate<Internal::VectorSortGreater<Comparator, Internal::SortByKey<It, Projection>>>(it_begin, it_end, projection);
+			return;
+		}
+	}
+	std::sort(it_begin, it_end, [&projection, &compare](const auto& lhs, const auto& rhs)
+	{
+		return compare(std::invoke(projection, lhs), std::invoke(projection, rhs));
+	});
+}
+
+/**
+* @details Sort the whole container by a projected key (i.e. SortBy(begin, end, &Event::timestamp)), ascending
+*
+* - Integral and floating point keys up to 32 bits are extracted once into a contiguous key and index array,
+*   sorted there by SortVectorized, then the elements are moved to their sorted position:
+*   every compare reads two cached keys instead of two elements
+*
+* - Other keys (64 bit ones included, where the cached path measured slower), and ranges under 256 elements,
+*   are sorted with std::sort on the projected keys
+*
+* - Equal keys keep their order on the cached key path, not on the std::sort one
+*
+* @tparam It random access iterator type (can be a pointer)
+* @tparam Projection key extraction, any std::invoke callable (member pointer, member function pointer, lambda)
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param projection key extraction
+*/
+template<std::random_access_iterator It, typename Projection>
+	requires std::invocable<Projection&, std::iter_reference_t<It>>
+void SortBy(It it_begin, It it_end, Projection projection) noexcept
 {
-	std::sort(std::forward<E>(e), std::make_reverse_iterator(it_end), std::make_reverse_iterator(it_begin), std::forward<F>(f));
+	SortBy(it_begin, it_end, projection, std::less<>{});
 }
 
 } // AoL namespace
@@ -0,0 +1,453 @@
+/***************************************************************************************
+* Algorithm Sorting Network Implementations
+****************************************************************************************
+* - Branch-free sorts of compile-time sized ranges (up to 32 elements)
+* - The comparators come from Batcher's odd-even merge sort, generated at compile time for N
+* - float, I32 and U32 ranges of up to 4 (SSE) or 8 (AVX2) elements are sorted in one register
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_SORTING_NETWORK_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_SORTING_NETWORK_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/array.h"
+#include "aol/internal/algorithms/simd.h"
+
+#include <array>		// std::array
+#include <functional>	// std::less
+#include <iterator>		// std::random_access_iterator, std::iter_value_t, std::iter_swap, std::begin
+#include <limits>		// std::numeric_limits
+#include <memory>		// std::to_address
+#include <type_traits>	// std::is_arithmetic_v, std::is_array_v, std::is_signed_v, std::remove_cvref_t
+#include <utility>		// std::index_sequence, std::make_index_sequence
+
+#if AOL_SIMD_AVX2 || AOL_SIMD_SSE2
+#include <immintrin.h>
+#endif
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Largest range SortFixed sorts with a network, Sort on larger fixed size containers uses std::sort
+inline constexpr SizeT sorting_network_max_size = 32;
+
+// One compare-exchange, the smaller element goes to lo
+struct SortingNetworkPair
+{
+	U8 lo;
+	U8 hi;
+	U8 layer; // comparators of the same layer touch different elements
+};
+
+// Batcher's odd-even merge sort for any N, calls emit(lo, hi, layer) for every comparator
+template<typename Emit>
+constexpr void SortingNetworkGenerate(SizeT n, Emit&& emit)
+{
+	SizeT layer = 0;
+	for (SizeT p = 1; p < n; p <<= 1)
+	{
+		for (SizeT k = p; k >= 1; k >>= 1, ++layer)
+		{
+			for (SizeT j = k % p; j + k < n; j += 2 * k)
+			{
+				for (SizeT i = 0; i < k && i + j + k < n; ++i)
+				{
+					if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+					{
+						emit(i + j, i + j + k, layer);
+					}
+				}
+			}
+		}
+	}
+}
+
+template<SizeT N>
+struct SortingNetwork
+{
+	static_assert(N <= sorting_network_max_size, "Sorting networks are only generated for up to 32 elements!");
+
+	static constexpr SizeT size = []()
+	{
+		SizeT count = 0;
+		SortingNetworkGenerate(N, [&count](SizeT, SizeT, SizeT) { ++count; });
+		return count;
+	}();
+
+	static constexpr SizeT layers = []()
+	{
+		SizeT count = 0;
+		SortingNetworkGenerate(N, [&count](SizeT, SizeT, SizeT layer) { count = layer + 1; });
+		return count;
+	}();
+
+	static constexpr std::array<SortingNetworkPair, size> pairs = []()
+	{
+		std::array<SortingNetworkPair, size> result{ };
+		SizeT count = 0;
+		SortingNetworkGenerate(N, [&](SizeT lo, SizeT hi, SizeT layer)
+		{
+			result[count++] = { static_cast<U8>(lo), static_cast<U8>(hi), static_cast<U8>(layer) };
+		});
+		return result;
+	}();
+
+	// Lane permutation of a layer, every lane reads its partner (or itself when it has no comparator)
+	static constexpr std::array<U8, N> LayerPartners(SizeT layer)
+	{
+		std::array<U8, N> partners{ };
+		for (SizeT i = 0; i < N; ++i)
+		{
+			partners[i] = static_cast<U8>(i);
+		}
+		for (const SortingNetworkPair& pair : pairs)
+		{
+			if (pair.layer == layer)
+			{
+				partners[pair.lo] = pair.hi;
+				partners[pair.hi] = pair.lo;
+			}
+		}
+		return partners;
+	}
+
+	// Bit i is set when lane i keeps the larger element of its comparator
+	static constexpr int LayerMaxLanes(SizeT layer)
+	{
+		int mask = 0;
+		for (const SortingNetworkPair& pair : pairs)
+		{
+			if (pair.layer == layer)
+			{
+				mask |= 1 << pair.hi;
+			}
+		}
+		return mask;
+	}
+};
+
+// Arithmetic types are exchanged with selects (cmov, minss/maxss) so the data never decides a branch
+template<typename It, typename Comparator>
+constexpr void SortingNetworkCompareExchange(It it_lo, It it_hi, Comparator& compare)
+{
+	using value_type = std::iter_value_t<It>;
+
+	if constexpr (std::is_arithmetic_v<value_type>)
+	{
+		const value_type lo = *it_lo;
+		const value_type hi = *it_hi;
+		*it_lo = compare(hi, lo) ? hi : lo;
+		*it_hi = compare(hi, lo) ? lo : hi;
+	}
+	else
+	{
+		if (compare(*it_hi, *it_lo))
+		{
+			std::iter_swap(it_lo, it_hi);
+		}
+	}
+}
+
+template<SizeT N, typename It, typename Comparator>
+constexpr void SortingNetworkScalar(It it_begin, Comparator& compare)
+{
+	using network = SortingNetwork<N>;
+	[&]<SizeT... I>(std::index_sequence<I...>)
+	{
+		(SortingNetworkCompareExchange(it_begin + network::pairs[I].lo, it_begin + network::pairs[I].hi, compare), ...);
+	}(std::make_index_sequence<network::size>{});
+}
+
+/**
+* @details In-register network of one vector, supported is false when T has no min/max for Lanes
+*
+* - Every layer is one permute, a min, a max and a blend: each lane reads its partner, then the
+*   lanes that keep the larger element take the max
+*/
+template<typename T, SizeT Lanes>
+struct SortingNetworkVec
+{
+	static constexpr bool supported = false;
+};
+
+#if AOL_SIMD_AVX2 || AOL_SIMD_SSE2
+
+// Shuffle immediate of a 4 lane permutation
+template<SizeT Layer>
+inline constexpr int sorting_network_shuffle4 = []()
+{
+	constexpr auto partners = SortingNetwork<4>::LayerPartners(Layer);
+	return partners[0] | (partners[1] << 2) | (partners[2] << 4) | (partners[3] << 6);
+}();
+
+template<>
+struct SortingNetworkVec<float, 4>
+{
+	using vec = __m128;
+	static constexpr bool supported = true;
+
+	static vec Load(const float* p) noexcept { return _mm_loadu_ps(p); }
+	static void Store(float* p, vec v) noexcept { _mm_storeu_ps(p, v); }
+
+	template<SizeT Layer>
+	static vec ApplyLayer(vec v) noexcept
+	{
+		constexpr int max_lanes = SortingNetwork<4>::LayerMaxLanes(Layer);
+		const vec partner = _mm_shuffle_ps(v, v, sorting_network_shuffle4<Layer>);
+		const vec lo = _mm_min_ps(v, partner);
+		const vec hi = _mm_max_ps(v, partner);
+#if AOL_SIMD_SSE42
+		return _mm_blend_ps(lo, hi, max_lanes);
+#else
+		const vec mask = _mm_castsi128_ps(_mm_setr_epi32(-(max_lanes & 1), -((max_lanes >> 1) & 1), -((max_lanes >> 2) & 1), -((max_lanes >> 3) & 1)));
+		return _mm_or_ps(_mm_and_ps(mask, hi), _mm_andnot_ps(mask, lo));
+#endif
+	}
+};
+
+// Integer min/max come with SSE4.1
+#if AOL_SIMD_SSE42
+template<typename T> requires (std::is_same_v<T, I32> || std::is_same_v<T, U32>)
+struct SortingNetworkVec<T, 4>
+{
+	using vec = __m128i;
+	static constexpr bool supported = true;
+
+	static vec Load(const T* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const vec*>(p)); }
+	static void Store(T* p, vec v) noexcept { _mm_storeu_si128(reinterpret_cast<vec*>(p), v); }
+
+	template<SizeT Layer>
+	static vec ApplyLayer(vec v) noexcept
+	{
+		constexpr int max_lanes = SortingNetwork<4>::LayerMaxLanes(Layer);
+		const vec partner = _mm_shuffle_epi32(v, sorting_network_shuffle4<Layer>);
+		vec lo, hi;
+		if constexpr (std::is_signed_v<T>)
+		{
+			lo = _mm_min_epi32(v, partner);
+			hi = _mm_max_epi32(v, partner);
+		}
+		else
+		{
+			lo = _mm_min_epu32(v, partner);
+			hi = _mm_max_epu32(v, partner);
+		}
+		return _mm_castps_si128(_mm_blend_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), max_lanes));
+	}
+};
+#endif
+
+#if AOL_SIMD_AVX2
+// permutevar8x32 index vector of a layer
+template<SizeT Layer>
+inline __m256i SortingNetworkPermute8() noexcept
+{
+	constexpr auto partners = SortingNetwork<8>::LayerPartners(Layer);
+	return _mm256_setr_epi32(partners[0], partners[1], partners[2], partners[3], partners[4], partners[5], partners[6], partners[7]);
+}
+
+template<>
+struct SortingNetworkVec<float, 8>
+{
+	using vec = __m256;
+	static constexpr bool supported = true;
+
+	static vec Load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+	static void Store(float* p, vec v) noexcept { _mm256_storeu_ps(p, v); }
+
+	template<SizeT Layer>
+	static vec ApplyLayer(vec v) noexcept
+	{
+		constexpr int max_lanes = SortingNetwork<8>::LayerMaxLanes(Layer);
+		const vec partner = _mm256_permutevar8x32_ps(v, SortingNetworkPermute8<Layer>());
+		return _mm256_blend_ps(_mm256_min_ps(v, partner), _mm256_max_ps(v, partner), max_lanes);
+	}
+};
+
+template<typename T> requires (std::is_same_v<T, I32> || std::is_same_v<T, U32>)
+struct SortingNetworkVec<T, 8>
+{
+	using vec = __m256i;
+	static constexpr bool supported = true;
+
+	static vec Load(const T* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const vec*>(p)); }
+	static void Store(T* p, vec v) noexcept { _mm256_storeu_si256(reinterpret_cast<vec*>(p), v); }
+
+	template<SizeT Layer>
+	static vec ApplyLayer(vec v) noexcept
+	{
+		constexpr int max_lanes = SortingNetwork<8>::LayerMaxLanes(Layer);
+		const vec partner = _mm256_permutevar8x32_epi32(v, SortingNetworkPermute8<Layer>());
+		if constexpr (std::is_signed_v<T>)
+		{
+			return _mm256_blend_epi32(_mm256_min_epi32(v, partner), _mm256_max_epi32(v, partner), max_lanes);
+		}
+		else
+		{
+			return _mm256_blend_epi32(_mm256_min_epu32(v, partner), _mm256_max_epu32(v, partner), max_lanes);
+		}
+	}
+};
+#endif
+
+#endif
+
+// Number of lanes the in-register network of N elements of T uses, 0 if it has none
+template<typename T, SizeT N>
+inline constexpr SizeT sorting_network_lanes =
+	N < 4 ? 0 :
+	N <= 4 && SortingNetworkVec<T, 4>::supported ? 4 :
+	N <= 8 && SortingNetworkVec<T, 8>::supported ? 8 : 0;
+
+// Runs of fewer lanes than the vector are padded with the largest value, which stays at the back
+template<SizeT N, typename T>
+void SortingNetworkVector(T* p_data) noexcept
+{
+	constexpr SizeT lanes = sorting_network_lanes<T, N>;
+	using ops = SortingNetworkVec<T, lanes>;
+
+	const auto sort = [](auto v)
+	{
+		[&]<SizeT... L>(std::index_sequence<L...>)
+		{
+			((v = ops::template ApplyLayer<L>(v)), ...);
+		}(std::make_index_sequence<SortingNetwork<lanes>::layers>{});
+		return v;
+	};
+
+	if constexpr (N == lanes)
+	{
+		ops::Store(p_data, sort(ops::Load(p_data)));
+	}
+	else
+	{
+		T padded[lanes];
+		for (SizeT i = 0; i < lanes; ++i)
+		{
+			padded[i] = i < N ? p_data[i] : (std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max());
+		}
+		ops::Store(padded, sort(ops::Load(padded)));
+		for (SizeT i = 0; i < N; ++i)
+		{
+			p_data[i] = padded[i];
+		}
+	}
+}
+
+// Compile-time size of a container, 0 if it has none
+template<typename A>
+struct FixedSizeOf
+{
+	static constexpr SizeT value = 0;
+};
+
+template<typename T, SizeT N>
+struct FixedSizeOf<T[N]>
+{
+	static constexpr SizeT value = N;
+};
+
+template<typename T, SizeT N>
+struct FixedSizeOf<std::array<T, N>>
+{
+	static constexpr SizeT value = N;
+};
+
+// ArrayNamed2/3/4
+template<typename A> requires requires { A::ArrSize; }
+struct FixedSizeOf<A>
+{
+	static constexpr SizeT value = A::ArrSize;
+};
+
+// Containers whose size is known at compile time (C arrays, AoL::Array, ArrayNamed2/3/4)
+template<typename A>
+concept FixedSizeContainer = FixedSizeOf<std::remove_cvref_t<A>>::value != 0;
+
+template<typename A>
+inline constexpr SizeT fixed_size_v = FixedSizeOf<std::remove_cvref_t<A>>::value;
+
+// Size of the array an ArrayIterator walks, 0 for other iterators
+template<typename It>
+inline constexpr SizeT array_iterator_size_v = 0;
+
+template<typename T, SizeT S>
+inline constexpr SizeT array_iterator_size_v<ArrayIterator<T, S>> = S;
+
+} // Internal namespace
+
+/**
+* @details Sorts N elements with a sorting network generated at compile time for N
+*
+* - Batcher's odd-even merge sort: a fixed sequence of compare-exchanges, fully unrolled, so the
+*   order of the data never decides a branch. Arithmetic elements are exchanged with selects
+*
+* - float, I32 and U32 with std::less are sorted in one vector when N fits it: up to 4 elements
+*   on SSE (SSE4.1 for the integers), up to 8 on AVX2
+*
+* - Not stable, same as Sort
+*
+* @tparam N number of elements, up to 32
+* @tparam It random access iterator type (can be a pointer)
+* @param it_begin start of the N elements
+* @param compare strict weak ordering (default: std::less)
+*/
+template<SizeT N, std::random_access_iterator It, typename Comparator = std::less<>>
+	requires (N <= Internal::sorting_network_max_size)
+constexpr void SortFixed(It it_begin, Comparator compare = Comparator{}) noexcept
+{
+	using value_type = std::iter_value_t<It>;
+
+	if constexpr (N > 1)
+	{
+		if constexpr (std::contiguous_iterator<It> && Internal::Simd::PlainLess<Comparator, value_type> &&
+					  Internal::sorting_network_lanes<value_type, N> != 0)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				Internal::SortingNetworkVector<N>(std::to_address(it_begin));
+				return;
+			}
+		}
+		Internal::SortingNetworkScalar<N>(it_begin, compare);
+	}
+}
+
+/**
+* @details Sorts the first N elements of a fixed size container (AoL::Array, ArrayNamed2/3/4) with a sorting network
+*
+* @tparam N number of elements, up to 32 and up to the container size
+* @param arr container to sort
+* @param compare strict weak ordering (default: std::less)
+*/
+template<SizeT N, Internal::FixedSizeContainer A, typename Comparator = std::less<>>
+	requires (!std::is_array_v<A> && N <= Internal::fixed_size_v<A> && N <= Internal::sorting_network_max_size)
+constexpr void SortFixed(A& arr, Comparator compare = Comparator{}) noexcept
+{
+	SortFixed<N>(arr.begin(), compare);
+}
+
+/**
+* @details Sorts a whole fixed size container (C array, AoL::Array, ArrayNamed2/3/4) with a sorting network
+*
+* @param arr container of up to 32 elements
+* @param compare strict weak ordering (default: std::less)
+*/
+template<Internal::FixedSizeContainer A, typename Comparator = std::less<>>
+	requires (Internal::fixed_size_v<A> <= Internal::sorting_network_max_size)
+constexpr void SortFixed(A& arr, Comparator compare = Comparator{}) noexcept
+{
+	SortFixed<Internal::fixed_size_v<A>>(std::begin(arr), compare);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_SORTING_NETWORK_H
@@ -0,0 +1,250 @@
+/***************************************************************************************
+* Algorithm Static B+Tree Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_STATIC_BTREE_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_STATIC_BTREE_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/algorithms/simd.h"
+
+#include <algorithm>	// std::max
+#include <functional>	// std::less, std::identity, std::invoke
+#include <iterator>		// std::distance
+#include <type_traits>	// std::is_same_v
+
+
+namespace AoL
+{
+
+/**
+* @details Sorted keys laid out as an implicit static B-tree (S-tree) for cache friendly lower bound searches
+*
+* - Every node holds node_keys keys and is cache line aligned, so each level of the descent costs
+*   a single cache miss, against one per level of a plain binary search
+*
+* - Children are not stored, node k has its node_keys + 1 children at k * (node_keys + 1) + 1 + i
+*
+* - The rank inside a node is computed with SIMD compares for arithmetic keys with a plain <
+*   (see AOL_SIMD_*), and by counting comparisons otherwise
+*
+* - Results are mapped back to positions in the original sorted range, so a frozen map can
+*   keep its sorted storage and only build the tree over its keys (i.e. projection &Pair::first)
+*
+* - Worth it for large read-mostly tables. For small ranges, FindLowerBound on the range itself is faster
+*
+* @tparam T key type, must be default constructible
+* @tparam Comparator comparison predicate (default: std::less<void>)
+*/
+template<
+	typename T,
+	typename Comparator = std::less<void>
+>
+struct StaticBTree
+{
+public:
+	using key_type = T;
+	using size_type = SizeT;
+	using rank_container_type = AoL::Vector<size_type>;
+
+	static constexpr size_type node_keys = 16;
+
+	struct alignas(std::max<size_type>(64, alignof(T))) Node
+	{
+		T keys[node_keys];
+	};
+
+	using container_type = AoL::Vector<Node>;
+
+private:
+	static constexpr size_type node_children = node_keys + 1;
+
+	AOL_ATTRIB_NO_UNQ_ADDRESS Comparator compare;
+	size_type key_count;
+
+public:
+	container_type nodes;		// node k holds slots [k * node_keys, (k + 1) * node_keys)
+	rank_container_type ranks;	// slot -> position in the original sorted range, size() for padding
+
+	StaticBTree() noexcept :
+		compare{ },
+		key_count{ 0 },
+		nodes{ },
+		ranks{ }
+	{
+	}
+
+	template<typename It, typename Projection = std::identity>
+	explicit StaticBTree(It it_begin, It it_end, Projection projection = Projection{}, Comparator comparator = Comparator{}) :
+		compare{ comparator },
+		key_count{ 0 },
+		nodes{ },
+		ranks{ }
+	{
+		this->build(it_begin, it_end, projection);
+	}
+
+	/**
+	* @details Rebuilds the tree from a sorted range
+	*
+	* - The range must be sorted with respect to Comparator, otherwise, it is UB
+	*
+	* - The projection extracts the key from each element (i.e. &Pair::first for maps)
+	*
+	* - Unused slots of the last nodes are padded with the largest key
+	*
+	* @param it_begin start of the sorted range
+	* @param it_end end of the sorted range
+	* @param projection key extraction (default: std::identity)
+	*/
+	template<typename It, typename Projection = std::identity>
+	void build(It it_begin, It it_end, Projection projection = Projection{})
+	{
+		this->clear();
+
+		AoL::Vector<T> sorted_keys;
+		sorted_keys.reserve(static_cast<size_type>(std::distance(it_begin, it_end)));
+		for (; it_begin != it_end; ++it_begin)
+		{
+			sorted_keys.emplace_back(std::invoke(projection, *it_begin));
+		}
+
+		key_count = sorted_keys.size();
+		if (key_count == 0)
+		{
+			return;
+		}
+
+		const size_type node_count = (key_count + node_keys - 1) / node_keys;
+		nodes.resize(node_count);
+		ranks.resize(node_count * node_keys);
+
+		size_type rank = 0;
+		this->BuildNode(0, sorted_keys, rank);
+	}
+
+	/**
+	* @details Lower bound search on the tree
+	*
+	* @tparam K key type
+	* @param value value to be found
+	* @return position of the lower bound in the original sorted range (size() if none)
+	*/
+	template<typename K>
+	AOL_ATTRIB_NO_DISCARD size_type lower_bound(const K& value) const noexcept
+	{
+		const size_type node_count = nodes.size();
+		const Node* p_nodes = nodes.data();
+
+		// Slots only get smaller on the way down, so the last candidate is the answer
+		size_type best_slot = ranks.size();
+		for (size_type k = 0; k < node_count; )
+		{
+			const size_type i = this->NodeRank(p_nodes[k], value);
+			best_slot = i < node_keys ? k * node_keys + i : best_slot;
+			k = k * node_children + i + 1;
+		}
+
+		return best_slot == ranks.size() ? key_count : ranks[best_slot];
+	}
+
+	AOL_ATTRIB_NO_DISCARD size_type size() const noexcept
+	{
+		return key_count;
+	}
+
+	AOL_ATTRIB_NO_DISCARD bool empty() const noexcept
+	{
+		return key_count == 0;
+	}
+
+	void clear() noexcept
+	{
+		key_count = 0;
+		nodes.clear();
+		ranks.clear();
+	}
+
+private:
+	// In-order walk of the implicit tree visits the slots in sorted order
+	void BuildNode(size_type k, const AoL::Vector<T>& sorted_keys, size_type& rank)
+	{
+		if (k >= nodes.size())
+		{
+			return;
+		}
+
+		for (size_type i = 0; i < node_keys; ++i)
+		{
+			this->BuildNode(k * node_children + i + 1, sorted_keys, rank);
+
+			const size_type slot = k * node_keys + i;
+			if (rank < key_count)
+			{
+				nodes[k].keys[i] = sorted_keys[rank];
+				ranks[slot] = rank;
+				++rank;
+			}
+			else
+			{
+				nodes[k].keys[i] = sorted_keys.back();
+				ranks[slot] = key_count;
+			}
+		}
+
+		this->BuildNode(k * node_children + node_keys + 1, sorted_keys, rank);
+	}
+
+	// Number of keys in the node that are less than value
+	template<typename K>
+	size_type NodeRank(const Node& node, const K& value) const noexcept
+	{
+		if constexpr (std::is_same_v<K, T> && Internal::Simd::PlainLess<Comparator, T>)
+		{
+			if constexpr (Internal::Simd::Supported<T>)
+			{
+				if constexpr (node_keys % Internal::Simd::Ops<T>::lanes == 0)
+				{
+					return Internal::Simd::CountLessFixed<node_keys>(node.keys, value);
+				}
+			}
+		}
+
+		Comparator comp = compare;
+		size_type rank = 0;
+		for (size_type i = 0; i < node_keys; ++i)
+		{
+			rank += static_cast<size_type>(comp(node.keys[i], value));
+		}
+		return rank;
+	}
+};
+
+/**
+* @details Lower bound algorithm through a prebuilt StaticBTree
+*
+* - The tree must have been built from [it_begin, it_begin + tree.size())
+*
+* @tparam It iterator type (can be a pointer)
+* @tparam T tree key type
+* @tparam C tree comparator type
+* @tparam K key type
+* @param tree prebuilt tree of the sorted range
+* @param it_begin start of the sorted range the tree was built from
+* @param value value to be found
+* @return iterator to lower bound position for value
+*/
+template<typename It, typename T, typename C, typename K>
+It FindLowerBound(const StaticBTree<T, C>& tree, It it_begin, const K& value) noexcept
+{
+	return it_begin + tree.lower_bound(value);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_STATIC_BTREE_H
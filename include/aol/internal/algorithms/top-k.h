@@ -0,0 +1,195 @@
+/***************************************************************************************
+* Algorithm Top K Implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_TOP_K_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_TOP_K_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/internal/algorithms/merge.h"
+#include "aol/internal/algorithms/sort.h"
+#include "aol/internal/threads/thread-pool.h"
+
+#include <algorithm>	// std::copy, std::copy_n, std::nth_element, std::make_heap, std::pop_heap, std::push_heap, std::min, std::max
+#include <functional>	// std::greater
+#include <iterator>		// std::forward_iterator, std::random_access_iterator, std::iter_value_t, std::distance
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Up to n / top_k_heap_ratio elements, a bounded heap is used: most elements are rejected by one comparison
+inline constexpr SizeT top_k_heap_ratio = 64;
+
+// Below this range size, TopKParallel runs on one thread
+inline constexpr SizeT parallel_top_k_cutoff = SizeT{ 1 } << 16;
+
+// Smallest block scanned by one TopKParallel task
+inline constexpr SizeT parallel_top_k_min_block = SizeT{ 1 } << 14;
+
+/**
+* @details k first elements in compare order, sorted, in a buffer
+*
+* - Small k: a heap of the k best so far, its front is the worst of them and every element that does not beat it
+*   is rejected by a single comparison
+*
+* - Large k: quickselect (std::nth_element) on a copy of the range, then the k first are sorted
+*/
+template<std::forward_iterator It, typename Comparator>
+AoL::Vector<std::iter_value_t<It>> TopKBuffer(It it_begin, It it_end, SizeT k, Comparator& compare)
+{
+	using value_type = std::iter_value_t<It>;
+
+	const SizeT count = static_cast<SizeT>(std::distance(it_begin, it_end));
+	k = std::min(k, count);
+	if (k == 0)
+	{
+		return { };
+	}
+
+	AoL::Vector<value_type> buffer;
+	if (k * top_k_heap_ratio <= count)
+	{
+		buffer.reserve(k);
+		It it = it_begin;
+		for (SizeT i = 0; i < k; ++i, ++it)
+		{
+			buffer.push_back(*it);
+		}
+		std::make_heap(buffer.begin(), buffer.end(), compare);
+
+		for (; it != it_end; ++it)
+		{
+			if (compare(*it, buffer.front())) AOL_ATTRIB_BRANCH_UNLIKELY
+			{
+				std::pop_heap(buffer.begin(), buffer.end(), compare);
+				buffer.back() = *it;
+				std::push_heap(buffer.begin(), buffer.end(), compare);
+			}
+		}
+	}
+	else
+	{
+		buffer.assign(it_begin, it_end);
+		if (k < count)
+		{
+			std::nth_element(buffer.begin(), buffer.begin() + static_cast<PtrDiff>(k - 1), buffer.end(), compare);
+			buffer.resize(k);
+		}
+	}
+
+	Sort(buffer.begin(), buffer.end(), compare);
+	return buffer;
+}
+
+} // Internal namespace
+
+/**
+* @details Top K selection: the k first elements of a range in compare order, sorted, without sorting the range
+*
+* - With the default std::greater, the k largest elements, largest first
+*
+* - A bounded heap when k is small against the range (k <= n / 64), quickselect on a copy otherwise
+*
+* - The range is not modified, ties between equal elements are broken in no particular order
+*
+* @tparam It forward iterator type (can be a pointer)
+* @tparam Out output iterator type
+* @tparam Comparator comparison type (default: std::greater)
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param k number of elements to select, all of them when the range is shorter
+* @param out start of the output, receives min(k, n) elements
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::forward_iterator It, typename Out, typename Comparator = std::greater<>>
+Out TopK(It it_begin, It it_end, SizeT k, Out out, Comparator compare = Comparator{})
+{
+	const AoL::Vector<std::iter_value_t<It>> buffer = Internal::TopKBuffer(it_begin, it_end, k, compare);
+	return std::copy(buffer.begin(), buffer.end(), out);
+}
+
+/**
+* @details Top K selection on a ThreadPool
+*
+* - Every task selects the top k of its own block, the sorted block results are merged with KWayMerge
+*   and the k first are written
+*
+* - Same result as TopK up to the order of equal elements, small ranges are selected by the calling thread
+*
+* @tparam It random access iterator type (can be a pointer)
+* @tparam Out output iterator type
+* @tparam Comparator comparison type (default: std::greater)
+* @param pool thread pool the tasks run on, the calling thread helps
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param k number of elements to select, all of them when the range is shorter
+* @param out start of the output, receives min(k, n) elements
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::random_access_iterator It, typename Out, typename Comparator = std::greater<>>
+Out TopKParallel(ThreadPool& pool, It it_begin, It it_end, SizeT k, Out out, Comparator compare = Comparator{})
+{
+	using value_type = std::iter_value_t<It>;
+
+	const SizeT count = static_cast<SizeT>(it_end - it_begin);
+	const SizeT concurrency = pool.concurrency();
+	k = std::min(k, count);
+	// Every block must be much larger than k, or the merge does most of the work
+	if (count < Internal::parallel_top_k_cutoff || concurrency == 1 || k * Internal::top_k_heap_ratio > count / concurrency)
+	{
+		return TopK(it_begin, it_end, k, out, compare);
+	}
+
+	const SizeT block_count = std::max<SizeT>(1, std::min(concurrency * 4, count / std::max(Internal::parallel_top_k_min_block, k * Internal::top_k_heap_ratio)));
+	const SizeT block_size = (count + block_count - 1) / block_count;
+	AoL::Vector<AoL::Vector<value_type>> block_results(block_count);
+	{
+		TaskGroup group(pool);
+		for (SizeT block = 0; block < block_count; ++block)
+		{
+			group.run([&, block]()
+			{
+				const SizeT low = std::min(block * block_size, count);
+				const SizeT high = std::min(low + block_size, count);
+				block_results[block] = Internal::TopKBuffer(it_begin + static_cast<PtrDiff>(low), it_begin + static_cast<PtrDiff>(high), k, compare);
+			});
+		}
+		group.wait();
+	}
+
+	AoL::Vector<value_type> merged(block_count * k);
+	const auto it_merged_end = KWayMerge(block_results, merged.begin(), compare);
+	const SizeT selected = std::min(k, static_cast<SizeT>(it_merged_end - merged.begin()));
+	return std::copy_n(merged.begin(), selected, out);
+}
+
+/**
+* @details Top K selection on DefaultThreadPool()
+*
+* @param it_begin start of the range
+* @param it_end end of the range
+* @param k number of elements to select, all of them when the range is shorter
+* @param out start of the output, receives min(k, n) elements
+* @param compare comparison function
+* @return end of the output
+*/
+template<std::random_access_iterator It, typename Out, typename Comparator = std::greater<>>
+Out TopKParallel(It it_begin, It it_end, SizeT k, Out out, Comparator compare = Comparator{})
+{
+	return TopKParallel(DefaultThreadPool(), it_begin, it_end, k, out, compare);
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_TOP_K_H
@@ -0,0 +1,654 @@
+/***************************************************************************************
+* Algorithm Vectorized Sort Implementations
+****************************************************************************************
+* - Quicksort for I32, U32, I64, float and double ranges that partitions a whole vector per step
+* - AVX2 and AVX-512 kernels are compiled on every x86 build and picked at runtime by
+*   Simd::RuntimeIsa(), std::sort is the fallback on other CPUs and architectures
+* - Same structure as x86-simd-sort: the partition holds its first and last vectors in registers
+*   so every store goes to slots that were already read
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_ALGORITHMS_VECTORIZED_SORT_H
+#define AOL_HEADER_INTERNAL_ALGORITHMS_VECTORIZED_SORT_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/internal/algorithms/simd.h"
+#include "aol/internal/algorithms/sorting-network.h"
+
+#include <algorithm>	// std::sort, std::reverse, std::partition, std::all_of, std::copy, std::fill
+#include <array>		// std::array
+#include <bit>			// std::popcount, std::bit_width
+#include <cmath>		// std::nextafter
+#include <concepts>		// std::integral, std::signed_integral, std::same_as
+#include <functional>	// std::less, std::greater
+#include <iterator>		// std::contiguous_iterator, std::iter_value_t
+#include <limits>		// std::numeric_limits
+#include <memory>		// std::to_address
+#include <type_traits>	// std::remove_cvref_t, std::is_floating_point_v
+#include <utility>		// std::swap
+
+#if AOL_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// The kernels pass vectors between force inlined functions compiled without AVX, which only inline into AOL_TARGET_* functions
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+
+namespace AoL
+{
+
+namespace Internal
+{
+
+// Element types with a vectorized partition
+template<typename T>
+concept VectorSortKey = (std::integral<T> && !std::same_as<T, bool> && (sizeof(T) == 4 || (sizeof(T) == 8 && std::signed_integral<T>)))
+	|| std::same_as<T, float> || std::same_as<T, double>;
+
+template<typename Comparator, typename T>
+concept VectorSortGreater = std::same_as<Comparator, std::greater<void>> || std::same_as<Comparator, std::greater<T>>;
+
+// Only plain < and > orders are reproduced by the kernels
+template<typename Comparator, typename T>
+concept VectorSortComparator = Simd::PlainLess<Comparator, T> || VectorSortGreater<Comparator, T>;
+
+// Ranges Sort hands to SortVectorized
+template<typename It, typename Comparator>
+concept VectorSortable = std::contiguous_iterator<It> && VectorSortKey<std::iter_value_t<It>>
+	&& VectorSortComparator<std::remove_cvref_t<Comparator>, std::iter_value_t<It>>;
+
+// Up to this size, a partition is sorted by a padded sorting network
+inline constexpr SizeT vector_sort_small_size = 32;
+
+// Partition depth stack, the smaller side is sorted first so it never holds more than log2(n) ranges
+inline constexpr SizeT vector_sort_stack_size = 64;
+
+// Sorts up to 32 elements: the range is copied into a network sized buffer padded with the largest value
+template<typename T>
+AOL_ATTRIB_FORCE_INLINE void VectorSortSmall(T* p_begin, SizeT count) noexcept
+{
+	constexpr T padding = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+
+	T buffer[vector_sort_small_size];
+	std::copy(p_begin, p_begin + count, buffer);
+	if (count <= 8)
+	{
+		std::fill(buffer + count, buffer + 8, padding);
+		SortFixed<8>(buffer + 0);
+	}
+	else if (count <= 16)
+	{
+		std::fill(buffer + count, buffer + 16, padding);
+		SortFixed<16>(buffer + 0);
+	}
+	else
+	{
+		std::fill(buffer + count, buffer + 32, padding);
+		SortFixed<32>(buffer + 0);
+	}
+	std::copy(buffer, buffer + count, p_begin);
+}
+
+// Median of 9 evenly spaced elements
+template<typename T>
+AOL_ATTRIB_FORCE_INLINE T VectorSortPivot(const T* p_begin, SizeT count) noexcept
+{
+	const SizeT step = count / 9;
+	T samples[9];
+	for (SizeT i = 0; i < 9; ++i)
+	{
+		samples[i] = p_begin[step / 2 + i * step];
+	}
+	SortFixed<9>(samples + 0);
+	return samples[4];
+}
+
+// Smallest value greater than pivot, pivot is never the largest value when this is called
+template<typename T>
+AOL_ATTRIB_FORCE_INLINE T VectorSortNextValue(T pivot) noexcept
+{
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		return std::nextafter(pivot, std::numeric_limits<T>::infinity());
+	}
+	else
+	{
+		return static_cast<T>(pivot + 1);
+	}
+}
+
+// Partitions one vector: lanes < pivot are written from p_left, lanes >= pivot end at p_right_end
+template<typename Ops, typename T>
+AOL_ATTRIB_FORCE_INLINE SizeT VectorSortPartitionVec(T* p_left, T* p_right_end, const typename Ops::vec& v, const typename Ops::vec& pivot_vec,
+	typename Ops::vec& min_vec, typename Ops::vec& max_vec) noexcept
+{
+	min_vec = Ops::Min(min_vec, v);
+	max_vec = Ops::Max(max_vec, v);
+	return Ops::PartitionStore(p_left, p_right_end, v, pivot_vec);
+}
+
+template<typename Ops, typename T>
+AOL_ATTRIB_FORCE_INLINE void VectorSortReduce(const typename Ops::vec& min_vec, const typename Ops::vec& max_vec, T& smallest, T& biggest) noexcept
+{
+	T lanes[Ops::lanes];
+	Ops::Store(lanes, min_vec);
+	for (const T value : lanes)
+	{
+		smallest = value < smallest ? value : smallest;
+	}
+	Ops::Store(lanes, max_vec);
+	for (const T value : lanes)
+	{
+		biggest = biggest < value ? value : biggest;
+	}
+}
+
+/**
+* @details Partitions [p_begin, p_end) around pivot, one vector at a time
+*
+* - A scalar head leaves a whole number of vectors. The first and last vectors are held in registers,
+*   which frees one vector of slots on each side. Every step loads the next vector from the side with
+*   less free space and writes its lanes < pivot to the left and the others to the right
+*
+* - smallest and biggest are lowered/raised to the range's minimum and maximum
+*
+* @return first element >= pivot
+*/
+template<typename Ops, typename T>
+AOL_ATTRIB_FORCE_INLINE T* VectorSortPartition(T* p_begin, T* p_end, T pivot, T& smallest, T& biggest) noexcept
+{
+	constexpr SizeT lanes = Ops::lanes;
+	using vec = typename Ops::vec;
+
+	for (SizeT i = static_cast<SizeT>(p_end - p_begin) % lanes; i > 0; --i)
+	{
+		const T value = *p_begin;
+		smallest = value < smallest ? value : smallest;
+		biggest = biggest < value ? value : biggest;
+		if (value < pivot)
+		{
+			++p_begin;
+		}
+		else
+		{
+			*p_begin = *--p_end;
+			*p_end = value;
+		}
+	}
+	if (p_begin == p_end)
+	{
+		return p_begin;
+	}
+
+	const vec pivot_vec = Ops::Broadcast(pivot);
+	vec min_vec = Ops::Broadcast(smallest);
+	vec max_vec = Ops::Broadcast(biggest);
+
+	if (p_end - p_begin == static_cast<PtrDiff>(lanes))
+	{
+		const SizeT greater_count = VectorSortPartitionVec<Ops>(p_begin, p_end, Ops::Load(p_begin), pivot_vec, min_vec, max_vec);
+		VectorSortReduce<Ops>(min_vec, max_vec, smallest, biggest);
+		return p_begin + (lanes - greater_count);
+	}
+
+	const vec left_vec = Ops::Load(p_begin);
+	const vec right_vec = Ops::Load(p_end - lanes);
+	T* p_store_left = p_begin;
+	T* p_store_right = p_end;
+	T* p_read_left = p_begin + lanes;
+	T* p_read_right = p_end - lanes;
+
+	while (p_read_left != p_read_right)
+	{
+		vec v;
+		if (p_store_right - p_read_right < p_read_left - p_store_left)
+		{
+			p_read_right -= lanes;
+			v = Ops::Load(p_read_right);
+		}
+		else
+		{
+			v = Ops::Load(p_read_left);
+			p_read_left += lanes;
+		}
+
+		const SizeT greater_count = VectorSortPartitionVec<Ops>(p_store_left, p_store_right, v, pivot_vec, min_vec, max_vec);
+		p_store_left += lanes - greater_count;
+		p_store_right -= greater_count;
+	}
+
+	// Two vectors of free slots are left, then one, where both stores of the last vector go to the same slots
+	SizeT greater_count = VectorSortPartitionVec<Ops>(p_store_left, p_store_right, left_vec, pivot_vec, min_vec, max_vec);
+	p_store_left += lanes - greater_count;
+	p_store_right -= greater_count;
+	greater_count = VectorSortPartitionVec<Ops>(p_store_left, p_store_right, right_vec, pivot_vec, min_vec, max_vec);
+	p_store_left += lanes - greater_count;
+
+	VectorSortReduce<Ops>(min_vec, max_vec, smallest, biggest);
+	return p_store_left;
+}
+
+/**
+* @details Quicksort over VectorSortPartition, ascending
+*
+* - Partitions of up to 32 elements are sorted by sorting networks, partitions deeper than
+*   2 * log2(n) are handed to std::sort
+*
+* - Duplicates: when the pivot is the partition's maximum, the right side is all pivots. When it is
+*   the minimum, the range is partitioned again on the next value, leaving all pivots on the left
+*/
+template<typename Ops, typename T>
+AOL_ATTRIB_FORCE_INLINE void VectorQuicksort(T* p_begin, T* p_end) noexcept
+{
+	struct Range
+	{
+		T* p_begin;
+		T* p_end;
+		SizeT depth;
+	};
+
+	Range stack[vector_sort_stack_size];
+	SizeT stack_size = 0;
+	Range range{ p_begin, p_end, 2 * static_cast<SizeT>(std::bit_width(static_cast<SizeT>(p_end - p_begin))) };
+
+	for (;;)
+	{
+		const SizeT count = static_cast<SizeT>(range.p_end - range.p_begin);
+		bool sorted = true;
+		if (count <= vector_sort_small_size)
+		{
+			VectorSortSmall(range.p_begin, count);
+		}
+		else if (range.depth == 0 || stack_size == vector_sort_stack_size) AOL_ATTRIB_BRANCH_UNLIKELY
+		{
+			std::sort(range.p_begin, range.p_end);
+		}
+		else
+		{
+			const T pivot = VectorSortPivot(range.p_begin, count);
+			T smallest = pivot;
+			T biggest = pivot;
+			T* p_middle = VectorSortPartition<Ops>(range.p_begin, range.p_end, pivot, smallest, biggest);
+
+			if (pivot == smallest && pivot != biggest)
+			{
+				p_middle = VectorSortPartition<Ops>(range.p_begin, range.p_end, VectorSortNextValue(pivot), smallest, biggest);
+				range = Range{ p_middle, range.p_end, range.depth - 1 };
+				sorted = false;
+			}
+			else if (pivot != smallest)
+			{
+				Range left{ range.p_begin, p_middle, range.depth - 1 };
+				Range right{ p_middle, range.p_end, range.depth - 1 };
+				if (pivot == biggest)
+				{
+					range = left;
+				}
+				else
+				{
+					if (left.p_end - left.p_begin > right.p_end - right.p_begin)
+					{
+						std::swap(left, right);
+					}
+					stack[stack_size++] = right;
+					range = left;
+				}
+				sorted = false;
+			}
+		}
+
+		if (sorted)
+		{
+			if (stack_size == 0)
+			{
+				return;
+			}
+			range = stack[--stack_size];
+		}
+	}
+}
+
+#if AOL_SIMD_X86
+
+// Lane order that packs the lanes below the pivot first, 4 bits per 32 bit lane index, for every mask of lanes >= pivot
+template<SizeT Lanes>
+inline constexpr auto vector_sort_avx2_permutations = []()
+{
+	constexpr SizeT parts = 8 / Lanes;
+	std::array<U32, (SizeT{ 1 } << Lanes)> table{ };
+	for (SizeT mask = 0; mask < table.size(); ++mask)
+	{
+		U32 packed = 0;
+		SizeT slot = 0;
+		for (SizeT greater = 0; greater < 2; ++greater)
+		{
+			for (SizeT lane = 0; lane < Lanes; ++lane)
+			{
+				if (((mask >> lane) & 1) == greater)
+				{
+					for (SizeT part = 0; part < parts; ++part)
+					{
+						packed |= static_cast<U32>(lane * parts + part) << (4 * slot++);
+					}
+				}
+			}
+		}
+		table[mask] = packed;
+	}
+	return table;
+}();
+
+template<SizeT Lanes>
+AOL_TARGET_AVX2 inline __m256i VectorSortAvx2Permutation(U32 mask) noexcept
+{
+	const __m256i packed = _mm256_set1_epi32(static_cast<I32>(vector_sort_avx2_permutations<Lanes>[mask]));
+	return _mm256_srlv_epi32(packed, _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+}
+
+/**
+* @details AVX2 kernel operations, PartitionStore packs the lanes < pivot first with one permute and
+*          stores the whole vector on both sides
+*/
+template<typename T>
+struct VectorSortAvx2;
+
+template<typename T> requires (std::integral<T> && sizeof(T) == 4)
+struct VectorSortAvx2<T>
+{
+	using vec = __m256i;
+	static constexpr SizeT lanes = 8;
+
+	AOL_TARGET_AVX2 static vec Load(const T* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const vec*>(p)); }
+	AOL_TARGET_AVX2 static void Store(T* p, vec v) noexcept { _mm256_storeu_si256(reinterpret_cast<vec*>(p), v); }
+	AOL_TARGET_AVX2 static vec Broadcast(T value) noexcept { return _mm256_set1_epi32(static_cast<I32>(value)); }
+	AOL_TARGET_AVX2 static vec Min(vec a, vec b) noexcept { return std::signed_integral<T> ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b); }
+	AOL_TARGET_AVX2 static vec Max(vec a, vec b) noexcept { return std::signed_integral<T> ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b); }
+
+	AOL_TARGET_AVX2 static SizeT PartitionStore(T* p_left, T* p_right_end, vec v, vec pivot) noexcept
+	{
+		const U32 mask = static_cast<U32>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(Max(v, pivot), v))));
+		const vec packed = _mm256_permutevar8x32_epi32(v, VectorSortAvx2Permutation<lanes>(mask));
+		Store(p_left, packed);
+		Store(p_right_end - lanes, packed);
+		return static_cast<SizeT>(std::popcount(mask));
+	}
+};
+
+template<typename T> requires (std::signed_integral<T> && sizeof(T) == 8)
+struct VectorSortAvx2<T>
+{
+	using vec = __m256i;
+	static constexpr SizeT lanes = 4;
+
+	AOL_TARGET_AVX2 static vec Load(const T* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const vec*>(p)); }
+	AOL_TARGET_AVX2 static void Store(T* p, vec v) noexcept { _mm256_storeu_si256(reinterpret_cast<vec*>(p), v); }
+	AOL_TARGET_AVX2 static vec Broadcast(T value) noexcept { return _mm256_set1_epi64x(static_cast<I64>(value)); }
+	AOL_TARGET_AVX2 static vec Min(vec a, vec b) noexcept { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+	AOL_TARGET_AVX2 static vec Max(vec a, vec b) noexcept { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+
+	AOL_TARGET_AVX2 static SizeT PartitionStore(T* p_left, T* p_right_end, vec v, vec pivot) noexcept
+	{
+		const U32 mask = ~static_cast<U32>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(pivot, v)))) & 0xF;
+		const vec packed = _mm256_permutevar8x32_epi32(v, VectorSortAvx2Permutation<lanes>(mask));
+		Store(p_left, packed);
+		Store(p_right_end - lanes, packed);
+		return static_cast<SizeT>(std::popcount(mask));
+	}
+};
+
+template<>
+struct VectorSortAvx2<float>
+{
+	using vec = __m256;
+	static constexpr SizeT lanes = 8;
+
+	AOL_TARGET_AVX2 static vec Load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+	AOL_TARGET_AVX2 static void Store(float* p, vec v) noexcept { _mm256_storeu_ps(p, v); }
+	AOL_TARGET_AVX2 static vec Broadcast(float value) noexcept { return _mm256_set1_ps(value); }
+	AOL_TARGET_AVX2 static vec Min(vec a, vec b) noexcept { return _mm256_min_ps(a, b); }
+	AOL_TARGET_AVX2 static vec Max(vec a, vec b) noexcept { return _mm256_max_ps(a, b); }
+
+	AOL_TARGET_AVX2 static SizeT PartitionStore(float* p_left, float* p_right_end, vec v, vec pivot) noexcept
+	{
+		const U32 mask = static_cast<U32>(_mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_GE_OQ)));
+		const vec packed = _mm256_permutevar8x32_ps(v, VectorSortAvx2Permutation<lanes>(mask));
+		Store(p_left, packed);
+		Store(p_right_end - lanes, packed);
+		return static_cast<SizeT>(std::popcount(mask));
+	}
+};
+
+template<>
+struct VectorSortAvx2<double>
+{
+	using vec = __m256d;
+	static constexpr SizeT lanes = 4;
+
+	AOL_TARGET_AVX2 static vec Load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+	AOL_TARGET_AVX2 static void Store(double* p, vec v) noexcept { _mm256_storeu_pd(p, v); }
+	AOL_TARGET_AVX2 static vec Broadcast(double value) noexcept { return _mm256_set1_pd(value); }
+	AOL_TARGET_AVX2 static vec Min(vec a, vec b) noexcept { return _mm256_min_pd(a, b); }
+	AOL_TARGET_AVX2 static vec Max(vec a, vec b) noexcept { return _mm256_max_pd(a, b); }
+
+	AOL_TARGET_AVX2 static SizeT PartitionStore(double* p_left, double* p_right_end, vec v, vec pivot) noexcept
+	{
+		const U32 mask = static_cast<U32>(_mm256_movemask_pd(_mm256_cmp_pd(v, pivot, _CMP_GE_OQ)));
+		const vec packed = _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(v), VectorSortAvx2Permutation<lanes>(mask)));
+		Store(p_left, packed);
+		Store(p_right_end - lanes, packed);
+		return static_cast<SizeT>(std::popcount(mask));
+	}
+};
+
+/**
+* @details AVX-512 kernel operations, PartitionStore compresses the lanes < pivot to the left and
+*          writes the others with a masked store that ends at p_right_end
+*/
+template<typename T>
+struct VectorSortAvx512;
+
+template<typename T> requires (std::integral<T> && sizeof(T) == 4)
+struct VectorSortAvx512<T>
+{
+	using vec = __m512i;
+	static constexpr SizeT lanes = 16;
+
+	AOL_TARGET_AVX512 static vec Load(const T* p) noexcept { return _mm512_loadu_si512(p); }
+	AOL_TARGET_AVX512 static void Store(T* p, vec v) noexcept { _mm512_storeu_si512(p, v); }
+	AOL_TARGET_AVX512 static vec Broadcast(T value) noexcept { return _mm512_set1_epi32(static_cast<I32>(value)); }
+	AOL_TARGET_AVX512 static vec Min(vec a, vec b) noexcept { return std::signed_integral<T> ? _mm512_min_epi32(a, b) : _mm512_min_epu32(a, b); }
+	AOL_TARGET_AVX512 static vec Max(vec a, vec b) noexcept { return std::signed_integral<T> ? _mm512_max_epi32(a, b) : _mm512_max_epu32(a, b); }
+
+	AOL_TARGET_AVX512 static SizeT PartitionStore(T* p_left, T* p_right_end, vec v, vec pivot) noexcept
+	{
+		const __mmask16 mask = std::signed_integral<T> ? _mm512_cmp_epi32_mask(v, pivot, _MM_CMPINT_NLT) : _mm512_cmp_epu32_mask(v, pivot, _MM_CMPINT_NLT);
+		const SizeT greater_count = static_cast<SizeT>(std::popcount(static_cast<U32>(mask)));
+		Store(p_left, _mm512_maskz_compress_epi32(static_cast<__mmask16>(~mask), v));
+		_mm512_mask_storeu_epi32(p_right_end - greater_count, static_cast<__mmask16>((1u << greater_count) - 1), _mm512_maskz_compress_epi32(mask, v));
+		return greater_count;
+	}
+};
+
+template<typename T> requires (std::signed_integral<T> && sizeof(T) == 8)
+struct VectorSortAvx512<T>
+{
+	using vec = __m512i;
+	static constexpr SizeT lanes = 8;
+
+	AOL_TARGET_AVX512 static vec Load(const T* p) noexcept { return _mm512_loadu_si512(p); }
+	AOL_TARGET_AVX512 static void Store(T* p, vec v) noexcept { _mm512_storeu_si512(p, v); }
+	AOL_TARGET_AVX512 static vec Broadcast(T value) noexcept { return _mm512_set1_epi64(static_cast<I64>(value)); }
+	AOL_TARGET_AVX512 static vec Min(vec a, vec b) noexcept { return _mm512_min_epi64(a, b); }
+	AOL_TARGET_AVX512 static vec Max(vec a, vec b) noexcept { return _mm512_max_epi64(a, b); }
+
+	AOL_TARGET_AVX512 static SizeT PartitionStore(T* p_left, T* p_right_end, vec v, vec pivot) noexcept
+	{
+		const __mmask8 mask = _mm512_cmp_epi64_mask(v, pivot, _MM_CMPINT_NLT);
+		const SizeT greater_count = static_cast<SizeT>(std::popcount(static_cast<U32>(mask)));
+		Store(p_left, _mm512_maskz_compress_epi64(static_cast<__mmask8>(~mask), v));
+		_mm512_mask_storeu_epi64(p_right_end - greater_count, static_cast<__mmask8>((1u << greater_count) - 1), _mm512_maskz_compress_epi64(mask, v));
+		return greater_count;
+	}
+};
+
+template<>
+struct VectorSortAvx512<float>
+{
+	using vec = __m512;
+	static constexpr SizeT lanes = 16;
+
+	AOL_TARGET_AVX512 static vec Load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+	AOL_TARGET_AVX512 static void Store(float* p, vec v) noexcept { _mm512_storeu_ps(p, v); }
+	AOL_TARGET_AVX512 static vec Broadcast(float value) noexcept { return _mm512_set1_ps(value); }
+	AOL_TARGET_AVX512 static vec Min(vec a, vec b) noexcept { return _mm512_min_ps(a, b); }
+	AOL_TARGET_AVX512 static vec Max(vec a, vec b) noexcept { return _mm512_max_ps(a, b); }
+
+	AOL_TARGET_AVX512 static SizeT PartitionStore(float* p_left, float* p_right_end, vec v, vec pivot) noexcept
+	{
+		const __mmask16 mask = _mm512_cmp_ps_mask(v, pivot, _CMP_GE_OQ);
+		const SizeT greater_count = static_cast<SizeT>(std::popcount(static_cast<U32>(mask)));
+		Store(p_left, _mm512_maskz_compress_ps(static_cast<__mmask16>(~mask), v));
+		_mm512_mask_storeu_ps(p_right_end - greater_count, static_cast<__mmask16>((1u << greater_count) - 1), _mm512_maskz_compress_ps(mask, v));
+		return greater_count;
+	}
+};
+
+template<>
+struct VectorSortAvx512<double>
+{
+	using vec = __m512d;
+	static constexpr SizeT lanes = 8;
+
+	AOL_TARGET_AVX512 static vec Load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+	AOL_TARGET_AVX512 static void Store(double* p, vec v) noexcept { _mm512_storeu_pd(p, v); }
+	AOL_TARGET_AVX512 static vec Broadcast(double value) noexcept { return _mm512_set1_pd(value); }
+	AOL_TARGET_AVX512 static vec Min(vec a, vec b) noexcept { return _mm512_min_pd(a, b); }
+	AOL_TARGET_AVX512 static vec Max(vec a, vec b) noexcept { return _mm512_max_pd(a, b); }
+
+	AOL_TARGET_AVX512 static SizeT PartitionStore(double* p_left, double* p_right_end, vec v, vec pivot) noexcept
+	{
+		const __mmask8 mask = _mm512_cmp_pd_mask(v, pivot, _CMP_GE_OQ);
+		const SizeT greater_count = static_cast<SizeT>(std::popcount(static_cast<U32>(mask)));
+		Store(p_left, _mm512_maskz_compress_pd(static_cast<__mmask8>(~mask), v));
+		_mm512_mask_storeu_pd(p_right_end - greater_count, static_cast<__mmask8>((1u << greater_count) - 1), _mm512_maskz_compress_pd(mask, v));
+		return greater_count;
+	}
+};
+
+template<typename T>
+AOL_TARGET_AVX2 void VectorSortAvx2Kernel(T* p_begin, T* p_end) noexcept
+{
+	VectorQuicksort<VectorSortAvx2<T>>(p_begin, p_end);
+}
+
+template<typename T>
+AOL_TARGET_AVX512 void VectorSortAvx512Kernel(T* p_begin, T* p_end) noexcept
+{
+	VectorQuicksort<VectorSortAvx512<T>>(p_begin, p_end);
+}
+
+#endif
+
+// Ascending sort on the widest kernel the CPU runs
+template<typename T>
+void VectorSortDispatch(T* p_begin, T* p_end) noexcept
+{
+#if AOL_SIMD_X86
+	switch (Simd::RuntimeIsa())
+	{
+	case Simd::Isa::Avx512:
+		VectorSortAvx512Kernel(p_begin, p_end);
+		return;
+	case Simd::Isa::Avx2:
+		VectorSortAvx2Kernel(p_begin, p_end);
+		return;
+	default:
+		break;
+	}
+#endif
+	std::sort(p_begin, p_end);
+}
+
+} // Internal namespace
+
+/**
+* @details Vectorized quicksort for contiguous I32, U32, I64, float and double ranges
+*
+* - Every partition step compares a whole vector against the pivot and writes its two sides with
+*   one permute (AVX2) or two compresses (AVX-512), small partitions go to sorting networks
+*
+* - The kernel is picked at runtime from the CPU (AVX-512, AVX2), std::sort runs on CPUs without AVX2
+*   and on other architectures
+*
+* - std::less sorts ascending, std::greater descending (an ascending sort, then reversed)
+*
+* - NaNs are moved to the end of the range, after every other value in both orders
+*
+* - Not stable, same as Sort
+*
+* @tparam It contiguous iterator type (can be a pointer)
+* @tparam Comparator std::less or std::greater
+* @param it_begin start of the range
+* @param it_end end of the range
+*/
+template<std::contiguous_iterator It, typename Comparator = std::less<>>
+	requires Internal::VectorSortKey<std::iter_value_t<It>> && Internal::VectorSortComparator<Comparator, std::iter_value_t<It>>
+void SortVectorized(It it_begin, It it_end, Comparator = Comparator{}) noexcept
+{
+	using value_type = std::iter_value_t<It>;
+
+	value_type* p_begin = std::to_address(it_begin);
+	value_type* p_end = p_begin + (it_end - it_begin);
+
+	if constexpr (std::is_floating_point_v<value_type>)
+	{
+		const auto is_number = [](value_type value) { return value == value; };
+		if (!std::all_of(p_begin, p_end, is_number)) AOL_ATTRIB_BRANCH_UNLIKELY
+		{
+			p_end = std::partition(p_begin, p_end, is_number);
+		}
+	}
+
+	Internal::VectorSortDispatch(p_begin, p_end);
+
+	if constexpr (Internal::VectorSortGreater<Comparator, value_type>)
+	{
+		std::reverse(p_begin, p_end);
+	}
+}
+
+namespace Internal
+{
+
+// One thread sort of the parallel sorts: SortVectorized when the range and comparator allow it, std::sort otherwise
+template<std::random_access_iterator It, typename Comparator>
+void SortSerial(It it_begin, It it_end, Comparator& compare) noexcept
+{
+	if constexpr (VectorSortable<It, Comparator>)
+	{
+		SortVectorized(it_begin, it_end, compare);
+	}
+	else
+	{
+		std::sort(it_begin, it_end, compare);
+	}
+}
+
+} // Internal namespace
+
+} // AoL namespace
+
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+
+#endif // AOL_HEADER_INTERNAL_ALGORITHMS_VECTORIZED_SORT_H
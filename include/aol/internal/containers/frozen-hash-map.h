@@ -0,0 +1,370 @@
+/*************************************************
+* AoLibrary Frozen Hash Map implementations
+*************************************************/
+#ifndef AOL_HEADER_INTERNAL_CONTAINERS_FROZEN_HASH_MAP_H
+#define AOL_HEADER_INTERNAL_CONTAINERS_FROZEN_HASH_MAP_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/algorithms.h"
+#include "aol/internal/containers/key-ordered-map.h"
+
+#include <algorithm>	// std::max
+#include <utility>		// std::forward, std::move, std::as_const
+
+
+namespace AoL::Internal
+{
+
+// Average keys per bucket of a frozen hash map, each bucket stores one pilot (4 bytes)
+inline constexpr SizeT frozen_hash_map_bucket_keys = 4;
+
+// Murmur3 64 bit finalizer, spreads the key hashes and pilots over all bits
+constexpr U64 FrozenHashMix(U64 value) noexcept
+{
+	value ^= value >> 33;
+	value *= 0xFF51AFD7ED558CCDull;
+	value ^= value >> 33;
+	value *= 0xC4CEB9FE1A85EC53ull;
+	value ^= value >> 33;
+	return value;
+}
+
+// Maps a 32 bit hash to [0, range) with a multiply instead of a modulo
+constexpr U32 FrozenHashReduce(U32 hash, U32 range) noexcept
+{
+	return static_cast<U32>((U64{ hash } * range) >> 32);
+}
+
+/**
+* Container: FrozenHashMap
+*
+* - Read only hash map built once from a finished KeyOrderMapEx or a range of pairs
+*
+* - Minimal perfect hash (PTHash style): keys are hashed into buckets of about 4 keys, each bucket gets the first
+*   pilot that sends all its keys to free slots, so the n pairs fill exactly n slots without collisions
+*
+* - A lookup is one key hash, one pilot load and one slot compare: no probing, no binary search
+*
+* - Values can be changed in place, keys cannot, no insert or erase; build a new map instead
+*
+* - Iteration order is the slot order, not the key order
+*
+* - slots_obj, pilots_obj and seed are the whole state, serializing them skips the build on load
+*
+* @tparam K key type
+* @tparam V value type
+* @tparam P pair type
+* @tparam H key hash type
+* @tparam A allocator type
+*/
+template<typename K, typename V, typename P, typename H, typename A>
+struct FrozenHashMapEx
+{
+public:
+	using container_type = AoL::Vector<P, A>;
+
+	using value_type = P;
+	using key_type = K;
+	using mapped_type = V;
+	using hasher = H;
+
+	using size_type = SizeT;
+
+	using iterator = typename container_type::iterator;
+	using const_iterator = typename container_type::const_iterator;
+
+private:
+	hasher hash_obj;
+
+public:
+	container_type slots_obj;
+	AoL::Vector<U32> pilots_obj;
+	U64 seed;
+
+	FrozenHashMapEx() noexcept :
+		hash_obj{ },
+		slots_obj{ },
+		pilots_obj{ },
+		seed{ 0 }
+	{
+	}
+
+	FrozenHashMapEx(const FrozenHashMapEx& other) noexcept = default;
+	FrozenHashMapEx& operator = (const FrozenHashMapEx& other) noexcept = default;
+	FrozenHashMapEx(FrozenHashMapEx&& other) noexcept = default;
+	FrozenHashMapEx& operator = (FrozenHashMapEx&& other) noexcept = default;
+
+	template<typename C, typename AM>
+	explicit FrozenHashMapEx(const KeyOrderMapEx<K, V, P, C, AM>& map) noexcept :
+		FrozenHashMapEx{ }
+	{
+		this->Build(container_type(map.begin(), map.end()));
+	}
+
+	template<typename C>
+	explicit FrozenHashMapEx(KeyOrderMapEx<K, V, P, C, A>&& map) noexcept :
+		FrozenHashMapEx{ }
+	{
+		map.compact();
+		this->Build(std::move(map.container_obj));
+	}
+
+	// Keys of the range must be unique
+	template<typename It>
+	explicit FrozenHashMapEx(It it_start, It it_end) noexcept :
+		FrozenHashMapEx{ }
+	{
+		static_assert(std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>, "Invalid iterator type!");
+		this->Build(container_type(it_start, it_end));
+	}
+
+	template<typename InKey>
+	constexpr mapped_type& operator[](InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		value_type* p_ret = this->find(std::forward<InKey>(key));
+		assert(p_ret != nullptr && "Invalid key!");
+		return p_ret->second;
+	}
+
+	template<typename InKey, typename R = Traits::ConstRefOrCopyType<mapped_type>>
+	constexpr R operator[](InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		assert(p_ret != nullptr && "Invalid key!");
+		return p_ret->second;
+	}
+
+	template<typename InKey>
+	mapped_type* at_ptr(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		value_type* p_ret = this->find(std::forward<InKey>(key));
+		return p_ret != nullptr ? &p_ret->second : nullptr;
+	}
+
+	template<typename InKey>
+	const mapped_type* at_ptr(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		return p_ret != nullptr ? &p_ret->second : nullptr;
+	}
+
+	template<typename InKey>
+	constexpr value_type* find(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		return const_cast<value_type*>(std::as_const(*this).find(std::forward<InKey>(key)));
+	}
+
+	// The slot of a missing key holds another key, the compare rejects it
+	template<typename InKey>
+	constexpr const value_type* find(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		if (slots_obj.empty())
+		{
+			return nullptr;
+		}
+		const key_type& key_val = std::forward<InKey>(key);
+		const U64 hash = this->HashKey(key_val);
+		const U32 pilot = pilots_obj[this->Bucket(hash)];
+		const value_type* p_ret = slots_obj.data() + this->Position(hash, FrozenHashMix(pilot), slots_obj.size());
+		return p_ret->first == key_val ? p_ret : nullptr;
+	}
+
+	template<typename InKey>
+	constexpr bool contains(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		return this->find(std::forward<InKey>(key)) != nullptr;
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const P* data() const noexcept
+	{
+		return slots_obj.data();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr bool empty() const noexcept
+	{
+		return slots_obj.empty();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr size_type size() const noexcept
+	{
+		return slots_obj.size();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr iterator begin() noexcept
+	{
+		return slots_obj.begin();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator begin() const noexcept
+	{
+		return slots_obj.cbegin();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr iterator end() noexcept
+	{
+		return slots_obj.end();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator end() const noexcept
+	{
+		return slots_obj.cend();
+	}
+
+private:
+	using hash_index_type = KeyValuePairEx<U64, U32>;
+
+	constexpr U64 HashKey(const key_type& key) const noexcept
+	{
+		return FrozenHashMix(static_cast<U64>(hash_obj(key)) + seed * 0x9E3779B97F4A7C15ull);
+	}
+
+	// Monotonic in the hash, so the sorted hashes of a build are grouped by bucket
+	constexpr U32 Bucket(U64 hash) const noexcept
+	{
+		return FrozenHashReduce(static_cast<U32>(hash >> 32), static_cast<U32>(pilots_obj.size()));
+	}
+
+	// The multiply carries the low bits the pilot changed up into the reduced ones
+	static constexpr U32 Position(U64 hash, U64 pilot_hash, SizeT count) noexcept
+	{
+		return FrozenHashReduce(static_cast<U32>(((hash ^ pilot_hash) * 0x9E3779B97F4A7C15ull) >> 32), static_cast<U32>(count));
+	}
+
+	// Tries seeds until every key hash is distinct, then moves each pair to its slot
+	constexpr void Build(container_type&& items) noexcept
+	{
+		const SizeT count = items.size();
+		assert(count <= SizeT{ 0xFFFFFFFF } && "Too many keys!");
+		pilots_obj.assign((count + frozen_hash_map_bucket_keys - 1) / frozen_hash_map_bucket_keys, 0);
+		slots_obj.clear();
+		if (count == 0)
+		{
+			return;
+		}
+
+		AoL::Vector<hash_index_type> hashes(count);
+		AoL::Vector<U32> positions(count);
+		for (seed = 0; !this->PlaceKeys(items, hashes, positions); ++seed)
+		{
+		}
+
+		AoL::Vector<U32> item_at(count);
+		for (SizeT i = 0; i < count; ++i)
+		{
+			item_at[positions[i]] = static_cast<U32>(i);
+		}
+		slots_obj.reserve(count);
+		for (SizeT i = 0; i < count; ++i)
+		{
+			slots_obj.push_back(std::move(items[item_at[i]]));
+		}
+	}
+
+	/**
+	* @details Finds the pilot of every bucket for the current seed, largest buckets first
+	*
+	* - positions receives the slot of each item
+	*
+	* @return false when two keys have the same hash, the build retries with the next seed
+	*/
+	constexpr bool PlaceKeys(const container_type& items, AoL::Vector<hash_index_type>& hashes, AoL::Vector<U32>& positions) noexcept
+	{
+		const SizeT count = items.size();
+		for (SizeT i = 0; i < count; ++i)
+		{
+			hashes[i] = hash_index_type{ this->HashKey(items[i].first), static_cast<U32>(i) };
+		}
+		AoL::RadixSortByKey(hashes.begin(), hashes.end());
+		for (SizeT i = 1; i < count; ++i)
+		{
+			if (hashes[i].first == hashes[i - 1].first)
+			{
+				assert(!(items[hashes[i].second].first == items[hashes[i - 1].second].first) && "Key already exists!");
+				return false;
+			}
+		}
+
+		// Bucket b holds hashes [bucket_begin[b], bucket_begin[b + 1])
+		const SizeT bucket_count = pilots_obj.size();
+		AoL::Vector<U32> bucket_begin(bucket_count + 1, 0);
+		SizeT max_bucket_size = 0;
+		for (const hash_index_type& item : hashes)
+		{
+			const U32 bucket = this->Bucket(item.first);
+			max_bucket_size = std::max<SizeT>(max_bucket_size, ++bucket_begin[bucket + 1]);
+		}
+		for (SizeT b = 0; b < bucket_count; ++b)
+		{
+			bucket_begin[b + 1] += bucket_begin[b];
+		}
+
+		// Counting sort of the buckets by size, largest first: they are the hardest to place in a filling table
+		AoL::Vector<U32> size_begin(max_bucket_size + 2, 0);
+		for (SizeT b = 0; b < bucket_count; ++b)
+		{
+			++size_begin[max_bucket_size - (bucket_begin[b + 1] - bucket_begin[b]) + 1];
+		}
+		for (SizeT s = 0; s <= max_bucket_size; ++s)
+		{
+			size_begin[s + 1] += size_begin[s];
+		}
+		AoL::Vector<U32> order(bucket_count);
+		for (SizeT b = 0; b < bucket_count; ++b)
+		{
+			order[size_begin[max_bucket_size - (bucket_begin[b + 1] - bucket_begin[b])]++] = static_cast<U32>(b);
+		}
+
+		AoL::Vector<U64> taken((count + 63) / 64, 0);
+		for (const U32 bucket : order)
+		{
+			const U32 first = bucket_begin[bucket];
+			const U32 last = bucket_begin[bucket + 1];
+			if (first == last)
+			{
+				break;
+			}
+			U32 pilot = 0;
+			while (!this->TryPilot(hashes, first, last, FrozenHashMix(pilot), count, taken, positions))
+			{
+				if (++pilot == 0)
+				{
+					return false;
+				}
+			}
+			pilots_obj[bucket] = pilot;
+		}
+		return true;
+	}
+
+	// Takes the slots of a bucket's keys for a pilot, or none of them if one is taken or two collide
+	constexpr bool TryPilot(const AoL::Vector<hash_index_type>& hashes, U32 first, U32 last, U64 pilot_hash, SizeT count, AoL::Vector<U64>& taken, AoL::Vector<U32>& positions) const noexcept
+	{
+		for (U32 i = first; i < last; ++i)
+		{
+			const U32 position = Position(hashes[i].first, pilot_hash, count);
+			const U64 bit = U64{ 1 } << (position % 64);
+			if ((taken[position / 64] & bit) != 0)
+			{
+				for (U32 j = first; j < i; ++j)
+				{
+					const U32 undo = positions[hashes[j].second];
+					taken[undo / 64] &= ~(U64{ 1 } << (undo % 64));
+				}
+				return false;
+			}
+			taken[position / 64] |= bit;
+			positions[hashes[i].second] = position;
+		}
+		return true;
+	}
+};
+
+} // AoL::Internal namespace
+
+
+#endif // AOL_HEADER_INTERNAL_CONTAINERS_FROZEN_HASH_MAP_H
@@ -0,0 +1,191 @@
+/*************************************************
+* AoLibrary Ordered Map, compile time implementations
+*************************************************/
+#ifndef AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_CONSTEXPR_H
+#define AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_CONSTEXPR_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/array.h"
+#include "aol/algorithms.h"
+#include "aol/internal/containers/key-ordered-map.h"
+
+#include <array>		// std::to_array
+#include <utility>		// std::forward
+
+
+namespace AoL::Internal
+{
+
+// Not constexpr on purpose: a compile time build that reaches it does not compile, the diagnostic points here
+inline void ConstexprKeyOrderMapDuplicateKey() noexcept
+{
+}
+
+/**
+* Container: OrderedMap, fixed capacity and built at compile time
+*
+* - The N pairs are sorted by a consteval constructor, a constexpr map is a sorted table in read only memory
+*   and costs nothing at startup
+*
+* - Lookups are constexpr: constant keys are resolved by the compiler, runtime keys use the branchless binary search
+*   like KeyOrderMapEx
+*
+* - Read only: no insert, erase or value changes, a duplicate key fails to compile
+*
+* @tparam K key type
+* @tparam V value type
+* @tparam N number of pairs
+* @tparam P pair type
+* @tparam C pair/key less comparator type
+*/
+template<typename K, typename V, SizeT N, typename P, typename C>
+struct ConstexprKeyOrderMapEx
+{
+	static_assert(N != 0, "Empty compile time map!");
+
+public:
+	using container_type = AoL::Array<P, N>;
+
+	using value_type = P;
+	using key_type = K;
+	using mapped_type = V;
+
+	using size_type = SizeT;
+
+	using iterator = typename container_type::const_iterator;
+	using const_iterator = typename container_type::const_iterator;
+
+private:
+	using less_than_comp_type = C;
+
+public:
+	container_type container_obj;
+
+	consteval explicit ConstexprKeyOrderMapEx(const value_type (&items)[N]) noexcept :
+		container_obj{ std::to_array(items) }
+	{
+		this->SortStorage();
+	}
+
+	consteval explicit ConstexprKeyOrderMapEx(const container_type& items) noexcept :
+		container_obj{ items }
+	{
+		this->SortStorage();
+	}
+
+	constexpr ConstexprKeyOrderMapEx(const ConstexprKeyOrderMapEx& other) noexcept = default;
+	constexpr ConstexprKeyOrderMapEx& operator = (const ConstexprKeyOrderMapEx& other) noexcept = default;
+
+	template<typename InKey, typename R = Traits::ConstRefOrCopyType<mapped_type>>
+	constexpr R operator[](InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		assert(p_ret != nullptr && "Invalid key!");
+		return p_ret->second;
+	}
+
+	template<typename InKey>
+	constexpr const mapped_type* at_ptr(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		return p_ret != nullptr ? &p_ret->second : nullptr;
+	}
+
+	template<typename InKey>
+	constexpr const value_type* find(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const auto& key_val = std::forward<InKey>(key);
+		const value_type* p_ret = this->LowerBoundPtr(key_val);
+		if (p_ret < container_obj.data() + N && p_ret->first == key_val)
+		{
+			return p_ret;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	template<typename InKey>
+	constexpr bool contains(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		return this->find(std::forward<InKey>(key)) != nullptr;
+	}
+
+	/**
+	* @details First element whose key is not less than key
+	*
+	* @param key key to be searched
+	* @return iterator to the element, end() if none
+	*/
+	template<typename InKey>
+	constexpr const_iterator lower_bound(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		return container_obj.cbegin() + (this->LowerBoundPtr(key) - container_obj.data());
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const P* data() const noexcept
+	{
+		return container_obj.data();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr bool empty() const noexcept
+	{
+		return N == 0;
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr size_type size() const noexcept
+	{
+		return N;
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator begin() const noexcept
+	{
+		return container_obj.cbegin();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator cbegin() const noexcept
+	{
+		return container_obj.cbegin();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator end() const noexcept
+	{
+		return container_obj.cend();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator cend() const noexcept
+	{
+		return container_obj.cend();
+	}
+
+private:
+	// Sort falls back to std::sort (constexpr) in constant evaluation, up to 32 pairs it is SortFixed's network
+	consteval void SortStorage() noexcept
+	{
+		AoL::Sort(container_obj.begin(), container_obj.end());
+		for (SizeT i = 1; i < N; ++i)
+		{
+			if (container_obj[i - 1].first == container_obj[i].first)
+			{
+				ConstexprKeyOrderMapDuplicateKey();
+			}
+		}
+	}
+
+	template<typename InKey>
+	constexpr const value_type* LowerBoundPtr(const InKey& key) const noexcept
+	{
+		const value_type* p_begin = container_obj.data();
+		return AoL::FindLowerBoundBranchless(p_begin, p_begin + N, key, less_than_comp_type{ });
+	}
+};
+
+} // AoL::Internal namespace
+
+
+#endif // AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_CONSTEXPR_H
@@ -0,0 +1,363 @@
+/*************************************************
+* AoLibrary Ordered Map, log structured implementations
+*************************************************/
+#ifndef AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_LOG_H
+#define AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_LOG_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/algorithms.h"
+#include "aol/internal/containers/key-ordered-map.h"
+
+#include <algorithm>	// std::max
+#include <bit>			// std::bit_width
+#include <iterator>		// std::forward_iterator_tag, std::make_move_iterator
+#include <memory>		// std::addressof
+#include <utility>		// std::forward, std::move
+
+
+namespace AoL::Internal
+{
+
+// Smallest tail a log structured map lets grow before merging it, the limit is about sqrt(size) past it
+inline constexpr SizeT key_order_map_log_min_tail = 64;
+
+/**
+* Const iterator of KeyOrderMapLogEx, walks the main array and the tail together in key order
+*
+* - Each step compares the heads of both, so a const map is read sorted without merging the tail
+*
+* - Forward only, the distance between two iterators is the sum of their distances in the main array and the tail,
+*   so end() - begin() is size()
+*
+* @tparam P pair type
+* @tparam C pair/key less comparator type
+*/
+template<typename P, typename C>
+struct KeyOrderMapLogConstIterator
+{
+	using main_iterator = KeyOrderMapConstIterator<P>;
+
+	using iterator_concept = std::forward_iterator_tag;
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = P;
+	using difference_type = PtrDiff;
+	using pointer = const P*;
+	using reference = const P&;
+
+	main_iterator it_main{ };
+	main_iterator it_main_end{ };
+	const P* p_tail = nullptr;
+	const P* p_tail_end = nullptr;
+
+	constexpr KeyOrderMapLogConstIterator() noexcept = default;
+
+	constexpr KeyOrderMapLogConstIterator(main_iterator it_main_in, main_iterator it_main_end_in, const P* p_tail_in, const P* p_tail_end_in) noexcept :
+		it_main{ it_main_in },
+		it_main_end{ it_main_end_in },
+		p_tail{ p_tail_in },
+		p_tail_end{ p_tail_end_in }
+	{
+	}
+
+	constexpr reference operator * () const noexcept
+	{
+		return this->IsMainNext() ? *it_main : *p_tail;
+	}
+
+	constexpr pointer operator -> () const noexcept
+	{
+		return std::addressof(**this);
+	}
+
+	constexpr KeyOrderMapLogConstIterator& operator ++ () noexcept
+	{
+		if (this->IsMainNext())
+		{
+			++it_main;
+		}
+		else
+		{
+			++p_tail;
+		}
+		return *this;
+	}
+
+	constexpr KeyOrderMapLogConstIterator operator ++ (int) noexcept
+	{
+		KeyOrderMapLogConstIterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	friend constexpr bool operator == (const KeyOrderMapLogConstIterator& lhs, const KeyOrderMapLogConstIterator& rhs) noexcept
+	{
+		return lhs.it_main == rhs.it_main && lhs.p_tail == rhs.p_tail;
+	}
+
+	friend constexpr difference_type operator - (const KeyOrderMapLogConstIterator& lhs, const KeyOrderMapLogConstIterator& rhs) noexcept
+	{
+		return (lhs.it_main - rhs.it_main) + (lhs.p_tail - rhs.p_tail);
+	}
+
+private:
+	// The keys of the main array and the tail never match, the smaller head goes first
+	constexpr bool IsMainNext() const noexcept
+	{
+		return p_tail == p_tail_end || (it_main != it_main_end && C{ }(*it_main, p_tail->first));
+	}
+};
+
+/**
+* Container: OrderedMap, log structured
+*
+* - Write optimized KeyOrderMapEx: new keys go into a small sorted tail instead of the main sorted array,
+*   an insert moves O(tail) elements instead of O(size)
+*
+* - The tail is merged into the main array in one pass (insert_bulk) when it passes its limit or on compact(),
+*   with a limit of about sqrt(size), an insert costs O(sqrt(size)) moves amortized
+*
+* - find() searches the main array then the tail, two binary searches
+*
+* - Bounds and ranges need one sorted array: the non const begin() / end() / sorted() compact first,
+*   the const sorted() requires a compacted map. The const begin() / end() read the main array and the tail
+*   together (see KeyOrderMapLogConstIterator) and never compact
+*
+* - Element pointers stay valid until the next insert, compact() or merge
+*
+* @tparam K key type
+* @tparam V value type
+* @tparam P pair type
+* @tparam C pair/key less comparator type
+* @tparam A allocator type
+*/
+template<typename K, typename V, typename P, typename C, typename A>
+struct KeyOrderMapLogEx
+{
+public:
+	using main_type = KeyOrderMapEx<K, V, P, C, A>;
+	using container_type = typename main_type::container_type;
+
+	using value_type = P;
+	using key_type = K;
+	using mapped_type = V;
+
+	using size_type = SizeT;
+
+	using iterator = typename main_type::iterator;
+	using const_iterator = KeyOrderMapLogConstIterator<P, C>;
+
+private:
+	using less_than_comp_type = C;
+
+	less_than_comp_type less_than_comp;
+
+public:
+	main_type main_obj;
+	container_type tail_obj;
+	SizeT tail_limit;
+
+	// tail_limit 0 lets the limit follow the size
+	explicit KeyOrderMapLogEx(SizeT tail_limit_ = 0) noexcept :
+		less_than_comp{ },
+		main_obj{ },
+		tail_obj{ },
+		tail_limit{ tail_limit_ }
+	{
+	}
+
+	KeyOrderMapLogEx(const KeyOrderMapLogEx& other) noexcept = default;
+	KeyOrderMapLogEx& operator = (const KeyOrderMapLogEx& other) noexcept = default;
+	KeyOrderMapLogEx(KeyOrderMapLogEx&& other) noexcept = default;
+	KeyOrderMapLogEx& operator = (KeyOrderMapLogEx&& other) noexcept = default;
+
+	// Bulk loads go straight into the main array
+	constexpr void build_start() noexcept
+	{
+		main_obj.build_start();
+	}
+
+	template<typename InKey, typename InValue>
+	constexpr void build_add(InKey&& key, InValue&& value) noexcept requires std::is_convertible_v<InKey, key_type>&& std::is_convertible_v<InValue, mapped_type>
+	{
+		main_obj.build_add(std::forward<InKey>(key), std::forward<InValue>(value));
+	}
+
+	constexpr void build_end() noexcept
+	{
+		main_obj.build_end();
+	}
+
+	template<typename InKey, typename InValue>
+	constexpr void insert(InKey&& key, InValue&& value) noexcept requires std::is_convertible_v<InKey, key_type>&& std::is_convertible_v<InValue, mapped_type>
+	{
+		assert(main_obj.find(key) == nullptr && "Item already exists!");
+		const value_type* p_begin = tail_obj.data();
+		const value_type* p_ret = AoL::FindLowerBound(p_begin, p_begin + tail_obj.size(), key, less_than_comp);
+		assert((p_ret == p_begin + tail_obj.size() || p_ret->first != key) && "Item already exists!");
+		tail_obj.insert(tail_obj.begin() + (p_ret - p_begin), value_type{ std::forward<InKey>(key), std::forward<InValue>(value) });
+		if (tail_obj.size() > this->TailLimit())
+		{
+			this->compact();
+		}
+	}
+
+	// Batches skip the tail, the pending tail is merged with them
+	template<typename It>
+	constexpr void insert_bulk(It it_first, It it_last) noexcept
+	{
+		tail_obj.insert(tail_obj.end(), it_first, it_last);
+		main_obj.insert_bulk(std::make_move_iterator(tail_obj.begin()), std::make_move_iterator(tail_obj.end()));
+		tail_obj.clear();
+	}
+
+	// Merges the tail into the main array
+	constexpr void compact() noexcept
+	{
+		if (!tail_obj.empty())
+		{
+			main_obj.insert_bulk(std::make_move_iterator(tail_obj.begin()), std::make_move_iterator(tail_obj.end()));
+			tail_obj.clear();
+		}
+	}
+
+	template<typename InKey>
+	constexpr mapped_type& operator[](InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		value_type* p_ret = this->find(std::forward<InKey>(key));
+		assert(p_ret != nullptr && "Invalid key!");
+		return p_ret->second;
+	}
+
+	template<typename InKey, typename R = Traits::ConstRefOrCopyType<mapped_type>>
+	constexpr R operator[](InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		assert(p_ret != nullptr && "Invalid key!");
+		return p_ret->second;
+	}
+
+	template<typename InKey>
+	mapped_type& at_ref(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		value_type* p_ret = this->find(key);
+		if (p_ret != nullptr)
+		{
+			return p_ret->second;
+		}
+		this->insert(key, mapped_type{ });
+		return this->find(key)->second;
+	}
+
+	template<typename InKey>
+	mapped_type* at_ptr(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		value_type* p_ret = this->find(std::forward<InKey>(key));
+		return p_ret != nullptr ? &p_ret->second : nullptr;
+	}
+
+	template<typename InKey>
+	const mapped_type* at_ptr(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		return p_ret != nullptr ? &p_ret->second : nullptr;
+	}
+
+	template<typename InKey>
+	constexpr value_type* find(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		return const_cast<value_type*>(std::as_const(*this).find(std::forward<InKey>(key)));
+	}
+
+	template<typename InKey>
+	constexpr const value_type* find(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const auto& key_val = std::forward<InKey>(key);
+		const value_type* p_ret = main_obj.find(key_val);
+		if (p_ret != nullptr || tail_obj.empty())
+		{
+			return p_ret;
+		}
+		const value_type* p_end = tail_obj.data() + tail_obj.size();
+		p_ret = AoL::FindLowerBound(tail_obj.data(), p_end, key_val, less_than_comp);
+		return p_ret < p_end && p_ret->first == key_val ? p_ret : nullptr;
+	}
+
+	template<typename InKey>
+	constexpr bool contains(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		return this->find(std::forward<InKey>(key)) != nullptr;
+	}
+
+	// The whole map as one sorted KeyOrderMapEx, for bounds, ranges and find_from
+	AOL_ATTRIB_NO_DISCARD constexpr main_type& sorted() noexcept
+	{
+		this->compact();
+		return main_obj;
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const main_type& sorted() const noexcept
+	{
+		assert(tail_obj.empty() && "Tail not merged yet! Call compact() first!");
+		return main_obj;
+	}
+
+	constexpr void clear() noexcept
+	{
+		main_obj.clear();
+		tail_obj.clear();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr bool empty() const noexcept
+	{
+		return main_obj.empty() && tail_obj.empty();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr size_type size() const noexcept
+	{
+		return main_obj.size() + tail_obj.size();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr iterator begin() noexcept
+	{
+		return this->sorted().begin();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator begin() const noexcept
+	{
+		const value_type* p_tail = tail_obj.data();
+		return const_iterator(main_obj.begin(), main_obj.end(), p_tail, p_tail + tail_obj.size());
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr iterator end() noexcept
+	{
+		return this->sorted().end();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator end() const noexcept
+	{
+		const value_type* p_tail_end = tail_obj.data() + tail_obj.size();
+		return const_iterator(main_obj.end(), main_obj.end(), p_tail_end, p_tail_end);
+	}
+
+private:
+	// About sqrt(size): the merges, O(size) every limit inserts, cost as much as the tail inserts, O(limit) each
+	constexpr SizeT TailLimit() const noexcept
+	{
+		if (tail_limit != 0)
+		{
+			return tail_limit;
+		}
+		const SizeT root = SizeT{ 1 } << (std::bit_width(main_obj.size()) / 2);
+		return std::max(key_order_map_log_min_tail, root);
+	}
+};
+
+} // AoL::Internal namespace
+
+
+#endif // AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_LOG_H
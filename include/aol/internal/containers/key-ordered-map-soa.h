@@ -0,0 +1,838 @@
+/*************************************************
+* AoLibrary Ordered Map, structure of arrays implementations
+*************************************************/
+#ifndef AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_SOA_H
+#define AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_SOA_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+#include "aol/subrange.h"
+#include "aol/algorithms.h"
+#include "aol/internal/containers/key-ordered-map.h"
+
+#include <algorithm>	// std::is_sorted, std::upper_bound, std::adjacent_find, std::move, std::max
+#include <compare>		// std::strong_ordering
+#include <cstddef>		// std::nullptr_t
+#include <functional>	// std::less
+#include <iterator>		// std::random_access_iterator_tag, std::reverse_iterator, std::forward_iterator, std::make_move_iterator
+#include <type_traits>	// std::is_const_v, std::remove_const_t, std::is_arithmetic_v
+#include <utility>		// std::forward, std::move
+
+
+namespace AoL::Internal
+{
+
+/**
+* Reference to an element of a structure of arrays map: its key and its value, which live in different arrays
+*
+* - Reads like KeyValuePairEx (first, second), assigning to second writes the map's value
+*
+* @tparam K key type
+* @tparam V value type, const for const iterators
+*/
+template<typename K, typename V>
+struct KeyValueRefEx
+{
+	using first_type = K;
+	using second_type = V;
+
+	const first_type&	first;
+	second_type&		second;
+
+	constexpr operator KeyValuePairEx<K, std::remove_const_t<V>>() const
+	{
+		return { first, second };
+	}
+};
+
+/**
+* Random access iterator over a structure of arrays map, one pointer in each array
+*
+* - Dereferences to a KeyValueRefEx by value, which is also its value_type
+*
+* - A default or nullptr iterator compares equal to nullptr, find() returns one when the key is missing
+*
+* @tparam K key type
+* @tparam V value type, const for const iterators
+*/
+template<typename K, typename V>
+struct KeyOrderMapSoAIterator
+{
+	using iterator_concept = std::random_access_iterator_tag;
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = KeyValueRefEx<K, V>;
+	using reference = KeyValueRefEx<K, V>;
+	using difference_type = PtrDiff;
+
+	struct pointer
+	{
+		reference ref;
+
+		constexpr const reference* operator -> () const noexcept
+		{
+			return &ref;
+		}
+	};
+
+	const K* p_key;
+	V* p_value;
+
+	constexpr KeyOrderMapSoAIterator() noexcept :
+		p_key{ nullptr },
+		p_value{ nullptr }
+	{
+	}
+
+	constexpr KeyOrderMapSoAIterator(std::nullptr_t) noexcept :
+		KeyOrderMapSoAIterator{ }
+	{
+	}
+
+	constexpr KeyOrderMapSoAIterator(const K* p_key_, V* p_value_) noexcept :
+		p_key{ p_key_ },
+		p_value{ p_value_ }
+	{
+	}
+
+	// iterator to const_iterator
+	template<typename W> requires (std::is_const_v<V> && std::is_same_v<W, std::remove_const_t<V>>)
+	constexpr KeyOrderMapSoAIterator(const KeyOrderMapSoAIterator<K, W>& other) noexcept :
+		p_key{ other.p_key },
+		p_value{ other.p_value }
+	{
+	}
+
+	constexpr reference operator * () const noexcept
+	{
+		return { *p_key, *p_value };
+	}
+
+	constexpr pointer operator -> () const noexcept
+	{
+		return { **this };
+	}
+
+	constexpr reference operator [] (difference_type offset) const noexcept
+	{
+		return { p_key[offset], p_value[offset] };
+	}
+
+	constexpr KeyOrderMapSoAIterator& operator ++ () noexcept
+	{
+		++p_key;
+		++p_value;
+		return *this;
+	}
+
+	constexpr KeyOrderMapSoAIterator operator ++ (int) noexcept
+	{
+		KeyOrderMapSoAIterator it = *this;
+		++*this;
+		return it;
+	}
+
+	constexpr KeyOrderMapSoAIterator& operator -- () noexcept
+	{
+		--p_key;
+		--p_value;
+		return *this;
+	}
+
+	constexpr KeyOrderMapSoAIterator operator -- (int) noexcept
+	{
+		KeyOrderMapSoAIterator it = *this;
+		--*this;
+		return it;
+	}
+
+	constexpr KeyOrderMapSoAIterator& operator += (difference_type offset) noexcept
+	{
+		p_key += offset;
+		p_value += offset;
+		return *this;
+	}
+
+	constexpr KeyOrderMapSoAIterator& operator -= (difference_type offset) noexcept
+	{
+		p_key -= offset;
+		p_value -= offset;
+		return *this;
+	}
+
+	friend constexpr KeyOrderMapSoAIterator operator + (KeyOrderMapSoAIterator it, difference_type offset) noexcept
+	{
+		return it += offset;
+	}
+
+	friend constexpr KeyOrderMapSoAIterator operator + (difference_type offset, KeyOrderMapSoAIterator it) noexcept
+	{
+		return it += offset;
+	}
+
+	friend constexpr KeyOrderMapSoAIterator operator - (KeyOrderMapSoAIterator it, difference_type offset) noexcept
+	{
+		return it -= offset;
+	}
+
+	friend constexpr difference_type operator - (const KeyOrderMapSoAIterator& lhs, const KeyOrderMapSoAIterator& rhs) noexcept
+	{
+		return lhs.p_key - rhs.p_key;
+	}
+
+	friend constexpr bool operator == (const KeyOrderMapSoAIterator& lhs, const KeyOrderMapSoAIterator& rhs) noexcept
+	{
+		return lhs.p_key == rhs.p_key;
+	}
+
+	friend constexpr std::strong_ordering operator <=> (const KeyOrderMapSoAIterator& lhs, const KeyOrderMapSoAIterator& rhs) noexcept
+	{
+		return lhs.p_key <=> rhs.p_key;
+	}
+
+	friend constexpr bool operator == (const KeyOrderMapSoAIterator& it, std::nullptr_t) noexcept
+	{
+		return it.p_key == nullptr;
+	}
+};
+
+/**
+* Container: OrderedMap, structure of arrays
+*
+* - Same interface as KeyOrderMapEx, but keys and values are kept in two vectors
+*
+* - Searches only touch the key array: with large values, a binary search probe brings in one key
+*   instead of a whole pair, and more keys share a cache line
+*
+* - Elements are accessed through KeyValueRefEx proxies, find() returns an iterator (nullptr if missing)
+*   instead of a pointer, and keys_data() / values_data() replace data()
+*
+* - build_end() sorts a key/index array and moves each value once, instead of moving pairs around while sorting
+*
+* @tparam K key type
+* @tparam V value type
+* @tparam AK key allocator type
+* @tparam AV value allocator type
+*/
+template<typename K, typename V, typename AK, typename AV>
+struct KeyOrderMapSoAEx
+{
+public:
+	using key_container_type = AoL::Vector<K, AK>;
+	using mapped_container_type = AoL::Vector<V, AV>;
+
+	using value_type = KeyValuePairEx<K, V>;
+	using key_type = K;
+	using mapped_type = V;
+
+	using size_type = SizeT;
+
+	using reference = KeyValueRefEx<K, V>;
+	using const_reference = KeyValueRefEx<K, const V>;
+	using iterator = KeyOrderMapSoAIterator<K, V>;
+	using const_iterator = KeyOrderMapSoAIterator<K, const V>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	key_container_type keys_obj;
+	mapped_container_type values_obj;
+#if AOL_DEBUG_ON
+	bool build_flag;
+#endif
+
+	KeyOrderMapSoAEx() noexcept :
+		keys_obj{ },
+		values_obj{ }
+#if AOL_DEBUG_ON
+		, build_flag{ false }
+#endif
+	{
+	}
+
+	KeyOrderMapSoAEx(const KeyOrderMapSoAEx& other) noexcept = default;
+	KeyOrderMapSoAEx& operator = (const KeyOrderMapSoAEx& other) noexcept = default;
+	KeyOrderMapSoAEx(KeyOrderMapSoAEx&& other) noexcept = default;
+	KeyOrderMapSoAEx& operator = (KeyOrderMapSoAEx&& other) noexcept = default;
+
+	explicit KeyOrderMapSoAEx(SizeT initial_capacity) noexcept :
+		keys_obj{ },
+		values_obj{ }
+#if AOL_DEBUG_ON
+		, build_flag{ false }
+#endif
+	{
+		keys_obj.reserve(initial_capacity);
+		values_obj.reserve(initial_capacity);
+	}
+
+	explicit KeyOrderMapSoAEx(const AK& key_allocator, const AV& value_allocator) noexcept :
+		keys_obj{ key_allocator },
+		values_obj{ value_allocator }
+#if AOL_DEBUG_ON
+		, build_flag{ false }
+#endif
+	{
+	}
+
+	// Keys and their values at the same indices, in any order
+	explicit KeyOrderMapSoAEx(key_container_type other_keys, mapped_container_type other_values) noexcept :
+		keys_obj{ std::move(other_keys) },
+		values_obj{ std::move(other_values) }
+#if AOL_DEBUG_ON
+		, build_flag{ false }
+#endif
+	{
+		assert(keys_obj.size() == values_obj.size() && "Keys and values sizes differ!");
+		this->SortStorage();
+	}
+
+	// Range of pairs (first, second)
+	template<typename It>
+	explicit KeyOrderMapSoAEx(It it_start, It it_end) noexcept :
+		keys_obj{ },
+		values_obj{ }
+#if AOL_DEBUG_ON
+		, build_flag{ false }
+#endif
+	{
+		static_assert(std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>, "Invalid iterator type!");
+		for (; it_start != it_end; ++it_start)
+		{
+			keys_obj.push_back(it_start->first);
+			values_obj.push_back(it_start->second);
+		}
+		this->SortStorage();
+	}
+
+	constexpr void build_start() noexcept
+	{
+		assert(!build_flag && "Already building! Call build_end() first!");
+#if AOL_DEBUG_ON
+		build_flag = true;
+#endif
+	}
+
+	template<typename InKey, typename InValue>
+	constexpr void build_add(InKey&& key, InValue&& value) noexcept requires std::is_convertible_v<InKey, key_type>&& std::is_convertible_v<InValue, mapped_type>
+	{
+		assert(build_flag && "Building haven't started yet! Call build_start() first!");
+#if AOL_DEBUG_ON
+		auto it = AoL::FindBrute(keys_obj.begin(), keys_obj.end(), key_type{ key });
+		assert(it == keys_obj.end() && "Key already exists!");
+#endif
+		keys_obj.emplace_back(std::forward<InKey>(key));
+		values_obj.emplace_back(std::forward<InValue>(value));
+	}
+
+	constexpr void build_end() noexcept
+	{
+		assert(build_flag && "Building haven't started yet! Call build_start() first!");
+#if AOL_DEBUG_ON
+		build_flag = false;
+#endif
+		this->SortStorage();
+	}
+
+	template<typename InKey, typename InValue>
+	constexpr void insert(InKey&& key, InValue&& value) noexcept requires std::is_convertible_v<InKey, key_type>&& std::is_convertible_v<InValue, mapped_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT index = this->LowerBoundIndex(key);
+		if (index >= keys_obj.size())
+		{
+			keys_obj.emplace_back(std::forward<InKey>(key));
+			values_obj.emplace_back(std::forward<InValue>(value));
+		}
+		else
+		{
+			assert(keys_obj[index] != key && "Item already exists!");
+			keys_obj.emplace(keys_obj.begin() + static_cast<PtrDiff>(index), std::forward<InKey>(key));
+			values_obj.emplace(values_obj.begin() + static_cast<PtrDiff>(index), std::forward<InValue>(value));
+		}
+	}
+
+	/**
+	* @details Inserts a batch of pairs, sorted and merged in one pass instead of one insert() each
+	*
+	* - The batch is appended, sorted like build_end() sorts, then merged backward into the elements already there
+	*
+	* - Like insert(), the batch keys must not be in the map already nor repeat
+	*
+	* @tparam It input iterator type over pairs (first, second)
+	* @param it_first start of the batch
+	* @param it_last end of the batch
+	*/
+	template<typename It>
+	constexpr void insert_bulk(It it_first, It it_last) noexcept
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT old_size = keys_obj.size();
+		if constexpr (std::forward_iterator<It>)
+		{
+			const SizeT new_size = old_size + static_cast<SizeT>(std::distance(it_first, it_last));
+			if (new_size > keys_obj.capacity())
+			{
+				keys_obj.reserve(std::max(new_size, keys_obj.capacity() * 2));
+				values_obj.reserve(std::max(new_size, values_obj.capacity() * 2));
+			}
+		}
+		for (; it_first != it_last; ++it_first)
+		{
+			keys_obj.push_back(it_first->first);
+			values_obj.push_back(it_first->second);
+		}
+		this->SortStorage(old_size);
+		this->MergeStorage(old_size);
+		assert(std::adjacent_find(keys_obj.begin(), keys_obj.end()) == keys_obj.end() && "Item already exists!");
+	}
+
+	template<typename InKey>
+	constexpr mapped_type& operator[](InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+#if AOL_DEBUG_ON
+		iterator it = this->find(std::forward<InKey>(key));
+		assert(it != nullptr && "Invalid key!");
+		return it->second;
+#else
+		return values_obj[this->LowerBoundIndex(key)];
+#endif // !NDEBUG
+	}
+
+	template<typename InKey, typename R = Traits::ConstRefOrCopyType<mapped_type>>
+	constexpr R operator[](InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+#if AOL_DEBUG_ON
+		const_iterator it = this->find(std::forward<InKey>(key));
+		assert(it != nullptr && "Invalid key!");
+		return it->second;
+#else
+		return values_obj[this->LowerBoundIndex(key)];
+#endif // !NDEBUG
+	}
+
+	template<typename InKey>
+	mapped_type& at_ref(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT index = this->LowerBoundIndex(key);
+		if (index < keys_obj.size() && keys_obj[index] == key)
+		{
+			return values_obj[index];
+		}
+		else
+		{
+			keys_obj.emplace(keys_obj.begin() + static_cast<PtrDiff>(index), std::forward<InKey>(key));
+			return *values_obj.emplace(values_obj.begin() + static_cast<PtrDiff>(index));
+		}
+	}
+
+	template<typename InKey>
+	mapped_type* at_ptr(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const SizeT index = this->FindIndex(key);
+		return index != keys_obj.size() ? values_obj.data() + index : nullptr;
+	}
+
+	template<typename InKey>
+	const mapped_type* at_ptr(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const SizeT index = this->FindIndex(key);
+		return index != keys_obj.size() ? values_obj.data() + index : nullptr;
+	}
+
+	template<typename InKey>
+	constexpr iterator find(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT index = this->FindIndex(key);
+		return index != keys_obj.size() ? this->begin() + static_cast<PtrDiff>(index) : iterator{ };
+	}
+
+	template<typename InKey>
+	constexpr const_iterator find(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT index = this->FindIndex(key);
+		return index != keys_obj.size() ? this->begin() + static_cast<PtrDiff>(index) : const_iterator{ };
+	}
+
+	/**
+	* @details Finds a key by galloping from a previous position instead of searching the whole map
+	*
+	* - Costs O(log distance) from the hint, so probing a sorted batch of keys with the previous hit as the
+	*   hint (i.e. walking two maps in tandem) is close to a linear merge
+	*
+	* - The hint can be before or after the key, nullptr starts from the beginning
+	*
+	* @param it_hint element of this map to start from (i.e. the result of the previous find)
+	* @param key key to be found
+	* @return iterator to the element with the key, nullptr if none
+	*/
+	template<typename InKey>
+	constexpr iterator find_from(const_iterator it_hint, InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const SizeT index = this->FindFromIndex(it_hint, key);
+		return index != keys_obj.size() ? this->begin() + static_cast<PtrDiff>(index) : iterator{ };
+	}
+
+	template<typename InKey>
+	constexpr const_iterator find_from(const_iterator it_hint, InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		const SizeT index = this->FindFromIndex(it_hint, key);
+		return index != keys_obj.size() ? this->begin() + static_cast<PtrDiff>(index) : const_iterator{ };
+	}
+
+	/**
+	* @details First element whose key is not less than key
+	*
+	* @param key key to be searched
+	* @return iterator to the element, end() if none
+	*/
+	template<typename InKey>
+	constexpr iterator lower_bound(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		return this->begin() + static_cast<PtrDiff>(this->LowerBoundIndex(key));
+	}
+
+	template<typename InKey>
+	constexpr const_iterator lower_bound(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		return this->begin() + static_cast<PtrDiff>(this->LowerBoundIndex(key));
+	}
+
+	/**
+	* @details First element whose key is greater than key
+	*
+	* - Keys are unique, so it is at most one element after lower_bound(key)
+	*
+	* @param key key to be searched
+	* @return iterator to the element, end() if none
+	*/
+	template<typename InKey>
+	constexpr iterator upper_bound(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		return this->begin() + static_cast<PtrDiff>(this->UpperBoundIndex(key, this->LowerBoundIndex(key)));
+	}
+
+	template<typename InKey>
+	constexpr const_iterator upper_bound(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		return this->begin() + static_cast<PtrDiff>(this->UpperBoundIndex(key, this->LowerBoundIndex(key)));
+	}
+
+	/**
+	* @details Elements whose key is equal to key
+	*
+	* - One binary search, the upper end is derived from the lower one
+	*
+	* @param key key to be searched
+	* @return subrange of the matching element, empty (positioned at its lower bound) if none
+	*/
+	template<typename InKey>
+	constexpr AoL::Subrange<iterator> equal_range(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT lower = this->LowerBoundIndex(key);
+		const SizeT upper = this->UpperBoundIndex(key, lower);
+		return AoL::Subrange<iterator>(this->begin() + static_cast<PtrDiff>(lower), this->begin() + static_cast<PtrDiff>(upper));
+	}
+
+	template<typename InKey>
+	constexpr AoL::Subrange<const_iterator> equal_range(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT lower = this->LowerBoundIndex(key);
+		const SizeT upper = this->UpperBoundIndex(key, lower);
+		return AoL::Subrange<const_iterator>(this->begin() + static_cast<PtrDiff>(lower), this->begin() + static_cast<PtrDiff>(upper));
+	}
+
+	/**
+	* @details Elements whose key is in [key_low, key_high)
+	*
+	* - The search for key_high gallops from the result for key_low, so narrow ranges cost
+	*   one binary search plus O(log range size) instead of two full binary searches
+	*
+	* @param key_low inclusive lower key
+	* @param key_high exclusive upper key, must not be less than key_low
+	* @return subrange of the elements, empty if none
+	*/
+	template<typename InKeyLow, typename InKeyHigh>
+	constexpr AoL::Subrange<iterator> range(InKeyLow&& key_low, InKeyHigh&& key_high) noexcept
+		requires std::is_convertible_v<InKeyLow, key_type> && std::is_convertible_v<InKeyHigh, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		assert(!(key_high < key_low) && "Invalid range! key_high is less than key_low!");
+		const SizeT lower = this->LowerBoundIndex(key_low);
+		const SizeT upper = this->LowerBoundIndexFrom(lower, key_high);
+		return AoL::Subrange<iterator>(this->begin() + static_cast<PtrDiff>(lower), this->begin() + static_cast<PtrDiff>(upper));
+	}
+
+	template<typename InKeyLow, typename InKeyHigh>
+	constexpr AoL::Subrange<const_iterator> range(InKeyLow&& key_low, InKeyHigh&& key_high) const noexcept
+		requires std::is_convertible_v<InKeyLow, key_type> && std::is_convertible_v<InKeyHigh, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		assert(!(key_high < key_low) && "Invalid range! key_high is less than key_low!");
+		const SizeT lower = this->LowerBoundIndex(key_low);
+		const SizeT upper = this->LowerBoundIndexFrom(lower, key_high);
+		return AoL::Subrange<const_iterator>(this->begin() + static_cast<PtrDiff>(lower), this->begin() + static_cast<PtrDiff>(upper));
+	}
+
+	template<typename InKey>
+	constexpr bool contains(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		return this->find(std::forward<InKey>(key)) != nullptr;
+	}
+
+	constexpr void clear() noexcept
+	{
+		keys_obj.clear();
+		values_obj.clear();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const K* keys_data() const noexcept
+	{
+		return keys_obj.data();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr V* values_data() noexcept
+	{
+		return values_obj.data();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const V* values_data() const noexcept
+	{
+		return values_obj.data();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr bool empty() const noexcept
+	{
+		return keys_obj.empty();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr size_type size() const noexcept
+	{
+		return keys_obj.size();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr iterator begin() noexcept
+	{
+		return { keys_obj.data(), values_obj.data() };
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator begin() const noexcept
+	{
+		return { keys_obj.data(), values_obj.data() };
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator cbegin() const noexcept
+	{
+		return this->begin();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr iterator end() noexcept
+	{
+		return this->begin() + static_cast<PtrDiff>(keys_obj.size());
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator end() const noexcept
+	{
+		return this->begin() + static_cast<PtrDiff>(keys_obj.size());
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_iterator cend() const noexcept
+	{
+		return this->end();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator{ this->end() };
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator{ this->end() };
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator crbegin() const noexcept
+	{
+		return this->rbegin();
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr reverse_iterator rend() noexcept
+	{
+		return reverse_iterator{ this->begin() };
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator{ this->begin() };
+	}
+
+	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator crend() const noexcept
+	{
+		return this->rend();
+	}
+
+private:
+	// Sorts a key/index array (SortAdaptive, radix sorted blocks for integral and floating point keys as in KeyOrderMapEx),
+	// then gathers the values into their sorted order, every value is moved once
+	// - sorts the elements from index first to the end
+	constexpr void SortStorage(SizeT first = 0) noexcept
+	{
+		const SizeT count = keys_obj.size() - first;
+		if (std::is_sorted(keys_obj.begin() + static_cast<PtrDiff>(first), keys_obj.end()))
+		{
+			return;
+		}
+
+		std::less<> compare;
+		mapped_container_type sorted_values(values_obj.get_allocator());
+		sorted_values.reserve(count);
+		if constexpr (RadixKey<key_type>)
+		{
+			AoL::Vector<KeyValuePairEx<key_type, SizeT>> order(count);
+			for (SizeT i = 0; i < count; ++i)
+			{
+				order[i] = { keys_obj[first + i], first + i };
+			}
+			SortAdaptive(order.begin(), order.end(), compare, [](auto it_first, auto it_last)
+			{
+				AoL::RadixSortByKey(it_first, it_last);
+			});
+			for (SizeT i = 0; i < count; ++i)
+			{
+				keys_obj[first + i] = order[i].first;
+				sorted_values.push_back(std::move(values_obj[order[i].second]));
+			}
+		}
+		else
+		{
+			AoL::Vector<SizeT> order(count);
+			for (SizeT i = 0; i < count; ++i)
+			{
+				order[i] = first + i;
+			}
+			AoL::SortAdaptive(order.begin(), order.end(), [this](SizeT lhs, SizeT rhs) { return keys_obj[lhs] < keys_obj[rhs]; });
+
+			key_container_type sorted_keys(keys_obj.get_allocator());
+			sorted_keys.reserve(count);
+			for (SizeT i = 0; i < count; ++i)
+			{
+				sorted_keys.push_back(std::move(keys_obj[order[i]]));
+				sorted_values.push_back(std::move(values_obj[order[i]]));
+			}
+			std::move(sorted_keys.begin(), sorted_keys.end(), keys_obj.begin() + static_cast<PtrDiff>(first));
+		}
+		std::move(sorted_values.begin(), sorted_values.end(), values_obj.begin() + static_cast<PtrDiff>(first));
+	}
+
+	// Merges the sorted elements from index mid to the end into the sorted ones before it
+	// - elements before the first key greater than the smallest of the tail are not moved, the tail is buffered and merged backward
+	constexpr void MergeStorage(SizeT mid) noexcept
+	{
+		const SizeT count = keys_obj.size();
+		if (mid == 0 || mid == count)
+		{
+			return;
+		}
+		const SizeT begin = static_cast<SizeT>(std::upper_bound(keys_obj.begin(), keys_obj.begin() + static_cast<PtrDiff>(mid), keys_obj[mid]) - keys_obj.begin());
+		if (begin == mid)
+		{
+			return;
+		}
+
+		key_container_type tail_keys(std::make_move_iterator(keys_obj.begin() + static_cast<PtrDiff>(mid)), std::make_move_iterator(keys_obj.end()), keys_obj.get_allocator());
+		mapped_container_type tail_values(std::make_move_iterator(values_obj.begin() + static_cast<PtrDiff>(mid)), std::make_move_iterator(values_obj.end()), values_obj.get_allocator());
+		SizeT left = mid;
+		SizeT right = count - mid;
+		SizeT out = count;
+		while (right != 0 && left != begin)
+		{
+			--out;
+			if (tail_keys[right - 1] < keys_obj[left - 1])
+			{
+				--left;
+				keys_obj[out] = std::move(keys_obj[left]);
+				values_obj[out] = std::move(values_obj[left]);
+			}
+			else
+			{
+				--right;
+				keys_obj[out] = std::move(tail_keys[right]);
+				values_obj[out] = std::move(tail_values[right]);
+			}
+		}
+		std::move(tail_keys.begin(), tail_keys.begin() + static_cast<PtrDiff>(right), keys_obj.begin() + static_cast<PtrDiff>(left));
+		std::move(tail_values.begin(), tail_values.begin() + static_cast<PtrDiff>(right), values_obj.begin() + static_cast<PtrDiff>(left));
+	}
+
+	// Arithmetic keys are searched as key_type so FindLowerBound can take its SIMD path on the key array
+	template<typename InKey>
+	constexpr decltype(auto) SearchKey(const InKey& key) const noexcept
+	{
+		if constexpr (std::is_arithmetic_v<key_type>)
+		{
+			return static_cast<key_type>(key);
+		}
+		else
+		{
+			return (key);
+		}
+	}
+
+	template<typename InKey>
+	constexpr SizeT LowerBoundIndex(const InKey& key) const noexcept
+	{
+		const key_type* p_begin = keys_obj.data();
+		return static_cast<SizeT>(AoL::FindLowerBound(p_begin, p_begin + keys_obj.size(), this->SearchKey(key)) - p_begin);
+	}
+
+	template<typename InKey>
+	constexpr SizeT LowerBoundIndexFrom(SizeT from, const InKey& key) const noexcept
+	{
+		const key_type* p_begin = keys_obj.data();
+		return static_cast<SizeT>(AoL::FindLowerBoundGalloping(p_begin + from, p_begin + keys_obj.size(), this->SearchKey(key)) - p_begin);
+	}
+
+	// Keys are unique, so the upper bound is the lower bound, or the one after it on a match
+	template<typename InKey>
+	constexpr SizeT UpperBoundIndex(const InKey& key, SizeT lower) const noexcept
+	{
+		return lower + static_cast<SizeT>(lower != keys_obj.size() && keys_obj[lower] == key);
+	}
+
+	// Index of the key, size() if none
+	template<typename InKey>
+	constexpr SizeT FindIndex(const InKey& key) const noexcept
+	{
+		const SizeT index = this->LowerBoundIndex(key);
+		return index < keys_obj.size() && keys_obj[index] == key ? index : keys_obj.size();
+	}
+
+	template<typename InKey>
+	constexpr SizeT FindFromIndex(const_iterator it_hint, const InKey& key) const noexcept
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const key_type* p_begin = keys_obj.data();
+		const key_type* p_end = p_begin + keys_obj.size();
+		assert((it_hint == nullptr || (it_hint.p_key >= p_begin && it_hint.p_key <= p_end)) && "Hint is not from this map!");
+		const key_type* p_ret = AoL::FindLowerBoundGalloping(p_begin, it_hint != nullptr ? it_hint.p_key : p_begin, p_end, this->SearchKey(key));
+		return p_ret < p_end && *p_ret == key ? static_cast<SizeT>(p_ret - p_begin) : keys_obj.size();
+	}
+};
+
+} // AoL::Internal namespace
+
+
+#endif // AOL_HEADER_INTERNAL_CONTAINERS_KEY_ORDERED_MAP_SOA_H
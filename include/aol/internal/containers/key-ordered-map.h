@@ -10,8 +10,14 @@
 #include "aol/traits.h"
 #include "aol/types.h"
 #include "aol/vector.h"
+#include "aol/subrange.h"
 #include "aol/algorithms.h"
 
+#include <bit>			// std::popcount
+#include <compare>		// std::strong_ordering
+#include <iterator>		// std::bidirectional_iterator_tag, std::reverse_iterator
+#include <ranges>		// std::views::transform
+
 
 namespace AoL::Internal
 {
@@ -56,6 +62,147 @@ struct PairLessComparator
 	}
 };
 
+/**
+* Const iterator of KeyOrderMapEx, steps over the elements erase() marked but compact() has not removed yet
+*
+* - Without marks (p_tombstones is nullptr) it is a pointer walk, one extra test per step
+*
+* - Bidirectional, the distance between two iterators subtracts the marks between them (popcount of the bitmap),
+*   so end() - begin() is size()
+*
+* @tparam P pair type
+*/
+template<typename P>
+struct KeyOrderMapConstIterator
+{
+	using iterator_concept = std::bidirectional_iterator_tag;
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = P;
+	using difference_type = PtrDiff;
+	using pointer = const P*;
+	using reference = const P&;
+
+	const P* p_item = nullptr;
+	const P* p_begin = nullptr;
+	const P* p_end = nullptr;
+	const U64* p_tombstones = nullptr;
+
+	constexpr KeyOrderMapConstIterator() noexcept = default;
+
+	// p_item is moved forward to the first element not marked
+	constexpr KeyOrderMapConstIterator(const P* p_item_in, const P* p_begin_in, const P* p_end_in, const U64* p_tombstones_in) noexcept :
+		p_item{ p_item_in },
+		p_begin{ p_begin_in },
+		p_end{ p_end_in },
+		p_tombstones{ p_tombstones_in }
+	{
+		this->SkipForward();
+	}
+
+	constexpr reference operator * () const noexcept
+	{
+		return *p_item;
+	}
+
+	constexpr pointer operator -> () const noexcept
+	{
+		return p_item;
+	}
+
+	constexpr KeyOrderMapConstIterator& operator ++ () noexcept
+	{
+		++p_item;
+		this->SkipForward();
+		return *this;
+	}
+
+	constexpr KeyOrderMapConstIterator operator ++ (int) noexcept
+	{
+		KeyOrderMapConstIterator ret = *this;
+		++*this;
+		return ret;
+	}
+
+	constexpr KeyOrderMapConstIterator& operator -- () noexcept
+	{
+		--p_item;
+		if (p_tombstones != nullptr)
+		{
+			while (this->IsMarked(p_item))
+			{
+				--p_item;
+			}
+		}
+		return *this;
+	}
+
+	constexpr KeyOrderMapConstIterator operator -- (int) noexcept
+	{
+		KeyOrderMapConstIterator ret = *this;
+		--*this;
+		return ret;
+	}
+
+	friend constexpr bool operator == (const KeyOrderMapConstIterator& lhs, const KeyOrderMapConstIterator& rhs) noexcept
+	{
+		return lhs.p_item == rhs.p_item;
+	}
+
+	friend constexpr std::strong_ordering operator <=> (const KeyOrderMapConstIterator& lhs, const KeyOrderMapConstIterator& rhs) noexcept
+	{
+		return lhs.p_item <=> rhs.p_item;
+	}
+
+	friend constexpr difference_type operator - (const KeyOrderMapConstIterator& lhs, const KeyOrderMapConstIterator& rhs) noexcept
+	{
+		if (lhs.p_tombstones == nullptr)
+		{
+			return lhs.p_item - rhs.p_item;
+		}
+		return lhs.p_item < rhs.p_item ? -lhs.CountLive(lhs.p_item, rhs.p_item) : lhs.CountLive(rhs.p_item, lhs.p_item);
+	}
+
+private:
+	constexpr bool IsMarked(const P* p) const noexcept
+	{
+		const SizeT index = static_cast<SizeT>(p - p_begin);
+		return (p_tombstones[index / 64] >> (index % 64)) & 1;
+	}
+
+	constexpr void SkipForward() noexcept
+	{
+		if (p_tombstones != nullptr)
+		{
+			while (p_item != p_end && this->IsMarked(p_item))
+			{
+				++p_item;
+			}
+		}
+	}
+
+	// Elements in [p_first, p_last) not marked
+	constexpr difference_type CountLive(const P* p_first, const P* p_last) const noexcept
+	{
+		const SizeT first = static_cast<SizeT>(p_first - p_begin);
+		const SizeT last = static_cast<SizeT>(p_last - p_begin);
+		SizeT marked = 0;
+		for (SizeT word = first / 64; word * 64 < last; ++word)
+		{
+			U64 bits = p_tombstones[word];
+			if (word == first / 64)
+			{
+				bits &= ~U64{ 0 } << (first % 64);
+			}
+			if ((word + 1) * 64 > last)
+			{
+				bits &= (U64{ 1 } << (last % 64)) - 1;
+			}
+			marked += static_cast<SizeT>(std::popcount(bits));
+		}
+		return static_cast<difference_type>(last - first - marked);
+	}
+};
+
 /**
 * Container: OrderedMap
 *
@@ -86,9 +233,9 @@ public:
 	using size_type = SizeT;
 
 	using iterator = typename container_type::iterator;
-	using const_iterator = typename container_type::const_iterator;
+	using const_iterator = KeyOrderMapConstIterator<P>;
 	using reverse_iterator = typename container_type::reverse_iterator;
-	using const_reverse_iterator = typename container_type::const_reverse_iterator;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
 private:
 	using less_than_comp_type = C;
@@ -97,13 +244,18 @@ private:
 
 public:
 	container_type container_obj;
+	// Erased elements still in container_obj, one bit each, removed in bulk by compact()
+	AoL::Vector<U64> tombstones_obj;
+	SizeT tombstone_count;
 #if AOL_DEBUG_ON
 	bool build_flag;
 #endif
 
 	KeyOrderMapEx() noexcept :
+		less_than_comp{ },
 		container_obj{ },
-		less_than_comp{ }
+		tombstones_obj{ },
+		tombstone_count{ 0 }
 #if AOL_DEBUG_ON
 		, build_flag{ false }
 #endif
@@ -117,6 +269,8 @@ public:
 
 	explicit KeyOrderMapEx(SizeT initial_capacity) noexcept :
 		container_obj{ }
+		, tombstones_obj{ }
+		, tombstone_count{ 0 }
 #if AOL_DEBUG_ON
 		, build_flag{ false }
 #endif
@@ -126,6 +280,8 @@ public:
 
 	explicit KeyOrderMapEx(const A& allocator) noexcept :
 		container_obj{ allocator }
+		, tombstones_obj{ }
+		, tombstone_count{ 0 }
 #if AOL_DEBUG_ON
 		, build_flag{ false }
 #endif
@@ -134,31 +290,37 @@ public:
 
 	explicit KeyOrderMapEx(const container_type& other_data) noexcept :
 		container_obj{ other_data }
+		, tombstones_obj{ }
+		, tombstone_count{ 0 }
 #if AOL_DEBUG_ON
 		, build_flag{ false }
 #endif
 	{
-		Sort(container_obj.begin(), container_obj.end());
+		this->SortStorage();
 	}
 
 	explicit KeyOrderMapEx(container_type&& other_data) noexcept :
 		container_obj{ other_data }
+		, tombstones_obj{ }
+		, tombstone_count{ 0 }
 #if AOL_DEBUG_ON
 		, build_flag{ false }
 #endif
 	{
-		Sort(container_obj.begin(), container_obj.end());
+		this->SortStorage();
 	}
 
 	template<typename It>
 	explicit KeyOrderMapEx(It it_start, It it_end) noexcept :
 		container_obj{ it_start, it_end }
+		, tombstones_obj{ }
+		, tombstone_count{ 0 }
 #if AOL_DEBUG_ON
 		, build_flag{ false }
 #endif
 	{
 		static_assert(std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>, "Invalid iterator type!");
-		Sort(container_obj.begin(), container_obj.end());
+		this->SortStorage();
 	}
 
 	constexpr void build_start() noexcept
@@ -167,6 +329,7 @@ public:
 #if AOL_DEBUG_ON
 		build_flag = true;
 #endif
+		this->compact();
 	}
 
 	template<typename InKey, typename InValue>
@@ -187,7 +350,7 @@ public:
 #if AOL_DEBUG_ON
 		build_flag = false;
 #endif
-		Sort(container_obj.begin(), container_obj.end());
+		this->SortStorage();
 	}
 
 	template<typename InKey, typename InValue>
@@ -195,6 +358,11 @@ public:
 	{
 		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
 		const InKey& key_val = key;
+		if (this->ReviveErased(key_val, std::forward<InValue>(value)))
+		{
+			return;
+		}
+		this->compact();
 		const value_type* p_ret = AoL::FindLowerBound(container_obj.data(), container_obj.data() + container_obj.size(), key_val, less_than_comp);
 		if (p_ret >= container_obj.data() + container_obj.size())
 		{
@@ -207,30 +375,116 @@ public:
 		}
 	}
 
+	/**
+	* @details Inserts a batch of elements, sorted and merged in one pass instead of one insert() each
+	*
+	* - The batch is copied out and sorted like build_end() sorts, the storage grows once (a single reallocation),
+	*   then the batch is merged backward from the end of the storage: O(m log m + n) instead of O(m * n) moves
+	*
+	* - Elements before the smallest batch key are not moved, works on a live map, not only between build_start() and build_end()
+	*
+	* - Like std::map, keys already in the map keep their element and a key repeated in the batch is inserted once
+	*   (which of its elements is unspecified), the other elements are dropped
+	*
+	* @tparam It input iterator type over value_type (or pairs convertible to it)
+	* @param it_first start of the batch
+	* @param it_last end of the batch
+	*/
+	template<typename It>
+	constexpr void insert_bulk(It it_first, It it_last) noexcept
+	{
+		constexpr SizeT SPARSE_GAP = 128;
+
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		container_type batch(it_first, it_last, container_obj.get_allocator());
+		SortElements(batch.begin(), batch.end());
+		batch.erase(std::unique(batch.begin(), batch.end(), [](const value_type& lhs, const value_type& rhs) { return lhs.first == rhs.first; }), batch.end());
+
+		if (batch.empty())
+		{
+			return;
+		}
+
+		// The storage grows once, reserved up front so the lower bounds found below stay valid
+		this->compact();
+		SizeT left = container_obj.size();
+		container_obj.reserve(left + batch.size());
+
+		// Far apart keys: their lower bounds are searched in lockstep, so the cache misses overlap.
+		// Close keys are found by the merge itself, scanning back over the block it moves anyway
+		AoL::Vector<const value_type*> lower_bounds;
+		if (left / batch.size() >= SPARSE_GAP)
+		{
+			const auto batch_keys = std::views::transform(batch, [](const value_type& element) -> const key_type& { return element.first; });
+			lower_bounds.resize(batch.size());
+			AoL::FindLowerBoundBatch(container_obj.data(), container_obj.data() + left, batch_keys.begin(), batch_keys.end(), lower_bounds.begin(), less_than_comp);
+		}
+
+		if constexpr (std::is_default_constructible_v<value_type>)
+		{
+			container_obj.resize(left + batch.size());
+		}
+		else
+		{
+			container_obj.insert(container_obj.end(), batch.begin(), batch.end());
+		}
+
+		// Backward merge: the elements after each batch key move up as one block, it stops once the batch is placed,
+		// the elements left are already in place. A key already in the map keeps its element and leaves a slot unused
+		value_type* p_data = container_obj.data();
+		SizeT right = batch.size();
+		SizeT out = left + batch.size();
+		while (right != 0)
+		{
+			--right;
+			const key_type& key = batch[right].first;
+			SizeT split = left;
+			if (lower_bounds.empty())
+			{
+				while (split != 0 && !less_than_comp(p_data[split - 1], key))
+				{
+					--split;
+				}
+			}
+			else
+			{
+				split = static_cast<SizeT>(lower_bounds[right] - p_data);
+			}
+
+			const bool known = split != left && p_data[split].first == key;
+			std::move_backward(p_data + split, p_data + left, p_data + out);
+			out -= left - split;
+			left = split;
+			if (!known)
+			{
+				p_data[--out] = std::move(batch[right]);
+			}
+		}
+
+		// The unused slots sit between the untouched front and the merged part
+		if (out != left)
+		{
+			std::move(p_data + out, p_data + container_obj.size(), p_data + left);
+			container_obj.erase(container_obj.end() - static_cast<PtrDiff>(out - left), container_obj.end());
+		}
+	}
+
 	template<typename InKey>
 	constexpr mapped_type& operator[](InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
 	{
 		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
-#if AOL_DEBUG_ON
 		value_type* p_ret = this->find(std::forward<InKey>(key));
 		assert(p_ret != nullptr && "Invalid key!");
 		return p_ret->second;
-#else
-		return AoL::FindLowerBound(container_obj.data(), container_obj.data() + container_obj.size(), std::forward<InKey>(key), less_than_comp)->second;
-#endif // !NDEBUG
 	}
 
 	template<typename InKey, typename R = Traits::ConstRefOrCopyType<mapped_type>>
 	constexpr R operator[](InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
 	{
 		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
-#if AOL_DEBUG_ON
 		const value_type* p_ret = this->find(std::forward<InKey>(key));
 		assert(p_ret != nullptr && "Invalid key!");
 		return p_ret->second;
-#else
-		return AoL::FindLowerBound(container_obj.data(), container_obj.data() + container_obj.size(), std::forward<InKey>(key), less_than_comp)->second;
-#endif // !NDEBUG
 	}
 
 	template<typename InKey>
@@ -238,6 +492,11 @@ public:
 	{
 		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
 		const auto& key_val = std::forward<InKey>(key);
+		if (this->ReviveErased(key_val, mapped_type{ }))
+		{
+			return this->find(key_val)->second;
+		}
+		this->compact();
 		value_type* p_ret = AoL::FindLowerBound(container_obj.data(), container_obj.data() + container_obj.size(), key_val, less_than_comp);
 		if (p_ret < container_obj.data() + container_obj.size() && p_ret->first == key_val)
 		{
@@ -250,21 +509,14 @@ public:
 		}
 	}
 
+	// A const map cannot add the key, it must be there like for operator[]
 	template<typename InKey, typename R = Traits::ConstRefOrCopyType<mapped_type>>
 	R at_ref(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
 	{
 		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
-		const auto& key_val = std::forward<InKey>(key);
-		const value_type* p_ret = AoL::FindLowerBound(container_obj.data(), container_obj.data() + container_obj.size(), key_val, less_than_comp);
-		if (p_ret < container_obj.data() + container_obj.size() && p_ret->first == key_val)
-		{
-			return p_ret->second;
-		}
-		else
-		{
-			auto it = container_obj.insert(container_obj.begin() + (p_ret - container_obj.data()), value_type{ std::forward<InKey>(key), mapped_type{} });
-			return it->second;
-		}
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		assert(p_ret != nullptr && "Invalid key!");
+		return p_ret->second;
 	}
 
 	template<typename InKey>
@@ -287,7 +539,7 @@ public:
 		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
 		const auto& key_val = std::forward<InKey>(key);
 		value_type* p_ret = AoL::FindLowerBound(container_obj.data(), container_obj.data() + container_obj.size(), key_val, less_than_comp);
-		if (p_ret < container_obj.data() + container_obj.size() && p_ret->first == key_val)
+		if (p_ret < container_obj.data() + container_obj.size() && p_ret->first == key_val && !this->IsErased(p_ret))
 		{
 			return p_ret;
 		}
@@ -303,7 +555,7 @@ public:
 		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
 		const auto& key_val = std::forward<InKey>(key);
 		const value_type* p_ret = AoL::FindLowerBound(container_obj.data(), container_obj.data() + container_obj.size(), key_val, less_than_comp);
-		if (p_ret < container_obj.data() + container_obj.size() && p_ret->first == key_val)
+		if (p_ret < container_obj.data() + container_obj.size() && p_ret->first == key_val && !this->IsErased(p_ret))
 		{
 			return p_ret;
 		}
@@ -313,95 +565,430 @@ public:
 		}
 	}
 
+	/**
+	* @details Finds a key by galloping from a previous position instead of searching the whole map
+	*
+	* - Costs O(log distance) from the hint, so probing a sorted batch of keys with the previous hit as the
+	*   hint (i.e. walking two maps in tandem) is close to a linear merge
+	*
+	* - The hint can be before or after the key, nullptr starts from the beginning
+	*
+	* @param p_hint element of this map to start from (i.e. the result of the previous find)
+	* @param key key to be found
+	* @return pointer to the element with the key, nullptr if none
+	*/
+	template<typename InKey>
+	constexpr value_type* find_from(const value_type* p_hint, InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		value_type* p_begin = container_obj.data();
+		value_type* p_end = p_begin + container_obj.size();
+		assert((p_hint == nullptr || (p_hint >= p_begin && p_hint <= p_end)) && "Hint is not from this map!");
+		const auto& key_val = std::forward<InKey>(key);
+		value_type* p_ret = AoL::FindLowerBoundGalloping(p_begin, p_hint != nullptr ? p_begin + (p_hint - p_begin) : p_begin, p_end, key_val, less_than_comp);
+		if (p_ret < p_end && p_ret->first == key_val && !this->IsErased(p_ret))
+		{
+			return p_ret;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	template<typename InKey>
+	constexpr const value_type* find_from(const value_type* p_hint, InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const value_type* p_begin = container_obj.data();
+		const value_type* p_end = p_begin + container_obj.size();
+		assert((p_hint == nullptr || (p_hint >= p_begin && p_hint <= p_end)) && "Hint is not from this map!");
+		const auto& key_val = std::forward<InKey>(key);
+		const value_type* p_ret = AoL::FindLowerBoundGalloping(p_begin, p_hint != nullptr ? p_hint : p_begin, p_end, key_val, less_than_comp);
+		if (p_ret < p_end && p_ret->first == key_val && !this->IsErased(p_ret))
+		{
+			return p_ret;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	/**
+	* @details First element whose key is not less than key
+	*
+	* @param key key to be searched
+	* @return iterator to the element, end() if none
+	*/
+	template<typename InKey>
+	constexpr iterator lower_bound(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		this->compact();
+		const value_type* p_begin = container_obj.data();
+		return container_obj.begin() + (this->LowerBoundPtr(key) - p_begin);
+	}
+
+	template<typename InKey>
+	constexpr const_iterator lower_bound(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		return this->MakeConstIterator(this->LowerBoundPtr(key));
+	}
+
+	/**
+	* @details First element whose key is greater than key
+	*
+	* - Keys are unique, so it is at most one element after lower_bound(key)
+	*
+	* @param key key to be searched
+	* @return iterator to the element, end() if none
+	*/
+	template<typename InKey>
+	constexpr iterator upper_bound(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		this->compact();
+		const value_type* p_begin = container_obj.data();
+		return container_obj.begin() + (this->UpperBoundPtr(key, this->LowerBoundPtr(key)) - p_begin);
+	}
+
+	template<typename InKey>
+	constexpr const_iterator upper_bound(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		return this->MakeConstIterator(this->UpperBoundPtr(key, this->LowerBoundPtr(key)));
+	}
+
+	/**
+	* @details Elements whose key is equal to key
+	*
+	* - One binary search, the upper end is derived from the lower one
+	*
+	* @param key key to be searched
+	* @return subrange of the matching element, empty (positioned at its lower bound) if none
+	*/
+	template<typename InKey>
+	constexpr AoL::Subrange<iterator> equal_range(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		this->compact();
+		const value_type* p_begin = container_obj.data();
+		const value_type* p_lower = this->LowerBoundPtr(key);
+		const value_type* p_upper = this->UpperBoundPtr(key, p_lower);
+		return AoL::Subrange<iterator>(container_obj.begin() + (p_lower - p_begin), container_obj.begin() + (p_upper - p_begin));
+	}
+
+	template<typename InKey>
+	constexpr AoL::Subrange<const_iterator> equal_range(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const value_type* p_lower = this->LowerBoundPtr(key);
+		const value_type* p_upper = this->UpperBoundPtr(key, p_lower);
+		return AoL::Subrange<const_iterator>(this->MakeConstIterator(p_lower), this->MakeConstIterator(p_upper));
+	}
+
+	/**
+	* @details Elements whose key is in [key_low, key_high)
+	*
+	* - The search for key_high gallops from the result for key_low, so narrow ranges cost
+	*   one binary search plus O(log range size) instead of two full binary searches
+	*
+	* @param key_low inclusive lower key
+	* @param key_high exclusive upper key, must not be less than key_low
+	* @return subrange of the elements, empty if none
+	*/
+	template<typename InKeyLow, typename InKeyHigh>
+	constexpr AoL::Subrange<iterator> range(InKeyLow&& key_low, InKeyHigh&& key_high) noexcept
+		requires std::is_convertible_v<InKeyLow, key_type> && std::is_convertible_v<InKeyHigh, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		assert(!(key_high < key_low) && "Invalid range! key_high is less than key_low!");
+		this->compact();
+		const value_type* p_begin = container_obj.data();
+		const value_type* p_lower = this->LowerBoundPtr(key_low);
+		const value_type* p_upper = AoL::FindLowerBoundGalloping(p_lower, p_begin + container_obj.size(), key_high, less_than_comp);
+		return AoL::Subrange<iterator>(container_obj.begin() + (p_lower - p_begin), container_obj.begin() + (p_upper - p_begin));
+	}
+
+	template<typename InKeyLow, typename InKeyHigh>
+	constexpr AoL::Subrange<const_iterator> range(InKeyLow&& key_low, InKeyHigh&& key_high) const noexcept
+		requires std::is_convertible_v<InKeyLow, key_type> && std::is_convertible_v<InKeyHigh, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		assert(!(key_high < key_low) && "Invalid range! key_high is less than key_low!");
+		const value_type* p_lower = this->LowerBoundPtr(key_low);
+		const value_type* p_upper = AoL::FindLowerBoundGalloping(p_lower, container_obj.data() + container_obj.size(), key_high, less_than_comp);
+		return AoL::Subrange<const_iterator>(this->MakeConstIterator(p_lower), this->MakeConstIterator(p_upper));
+	}
+
 	template<typename InKey>
 	constexpr bool contains(InKey&& key) const noexcept requires std::is_convertible_v<InKey, key_type>
 	{
 		return this->find(std::forward<InKey>(key)) != nullptr;
 	}
 
+	/**
+	* @details Erases the element with key, if any
+	*
+	* - The element is only marked in a tombstone bitmap: O(log n), usually no element is moved
+	*
+	* - find(), contains(), at_ptr(), size() and the const iterators skip marked elements; they are removed together
+	*   in one pass by compact(), which runs in this call once a quarter of the storage is marked, and in the non const
+	*   accessors that walk or change the storage (iteration, bounds, ranges, data(), inserts)
+	*
+	* - Pointers and iterators stay valid until that compaction, const access never compacts
+	*
+	* - Inserting an erased key again reuses its slot, without a compaction
+	*
+	* @param key key to be erased
+	* @return number of elements erased (0 or 1)
+	*/
+	template<typename InKey>
+	constexpr size_type erase(InKey&& key) noexcept requires std::is_convertible_v<InKey, key_type>
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const value_type* p_ret = this->find(std::forward<InKey>(key));
+		if (p_ret == nullptr)
+		{
+			return 0;
+		}
+		if (tombstones_obj.empty())
+		{
+			tombstones_obj.resize((container_obj.size() + 63) / 64, U64{ 0 });
+		}
+		const SizeT index = static_cast<SizeT>(p_ret - container_obj.data());
+		tombstones_obj[index / 64] |= U64{ 1 } << (index % 64);
+		++tombstone_count;
+		if (tombstone_count * 4 > container_obj.size())
+		{
+			this->compact();
+		}
+		return 1;
+	}
+
+	/**
+	* @details Erases every element pred returns true for
+	*
+	* - One std::remove_if style pass over the storage, which also drops the elements erase() marked
+	*
+	* @tparam Pred predicate type, called with const value_type&
+	* @param pred predicate
+	* @return number of elements erased by pred
+	*/
+	template<typename Pred>
+	constexpr size_type erase_if(Pred pred) noexcept
+	{
+		assert(!build_flag && "Building haven't finished yet! Call build_end() first!");
+		const SizeT live_size = this->size();
+		this->RemoveStorage(pred);
+		return live_size - container_obj.size();
+	}
+
+	// Removes the elements marked by erase() from the storage, in one pass
+	constexpr void compact() noexcept
+	{
+		if (tombstone_count != 0)
+		{
+			const auto keep = [](const value_type&) { return false; };
+			this->RemoveStorage(keep);
+		}
+	}
+
 	AOL_ATTRIB_NO_DISCARD constexpr void clear() noexcept
 	{
+		tombstones_obj.clear();
+		tombstone_count = 0;
 		return container_obj.clear();
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr P* data() noexcept
 	{
+		this->compact();
 		return container_obj.data();
 	}
 
+	// The storage holds the erased elements until compact(), a const map must be compacted to be read as one array
 	AOL_ATTRIB_NO_DISCARD constexpr const P* data() const noexcept
 	{
+		assert(tombstone_count == 0 && "Erased elements not compacted yet! Call compact() first!");
 		return container_obj.data();
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr bool empty() const noexcept
 	{
-		return container_obj.empty();
+		return this->size() == 0;
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr size_type size() const noexcept
 	{
-		return container_obj.size();
+		return container_obj.size() - tombstone_count;
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr iterator begin() noexcept
 	{
+		this->compact();
 		return container_obj.begin();
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_iterator begin() const noexcept
 	{
-		return container_obj.cbegin();
+		return this->MakeConstIterator(container_obj.data());
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_iterator cbegin() const noexcept
 	{
-		return container_obj.cbegin();
+		return this->MakeConstIterator(container_obj.data());
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr iterator end() noexcept
 	{
+		this->compact();
 		return container_obj.end();
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_iterator end() const noexcept
 	{
-		return container_obj.cend();
+		return this->MakeConstIterator(container_obj.data() + container_obj.size());
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_iterator cend() const noexcept
 	{
-		return container_obj.cend();
+		return this->MakeConstIterator(container_obj.data() + container_obj.size());
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr reverse_iterator rbegin() noexcept
 	{
+		this->compact();
 		return container_obj.rbegin();
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator rbegin() const noexcept
 	{
-		return container_obj.crbegin();
+		return const_reverse_iterator(this->end());
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator crbegin() const noexcept
 	{
-		return container_obj.crbegin();
+		return const_reverse_iterator(this->end());
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr reverse_iterator rend() noexcept
 	{
+		this->compact();
 		return container_obj.rend();
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator rend() const noexcept
 	{
-		return container_obj.crend();
+		return const_reverse_iterator(this->begin());
 	}
 
 	AOL_ATTRIB_NO_DISCARD constexpr const_reverse_iterator crend() const noexcept
 	{
-		return container_obj.crend();
+		return const_reverse_iterator(this->begin());
+	}
+
+private:
+	// Sorted runs already in the storage (a sorted map with a few items appended) are merged by SortAdaptive,
+	// blocks without order are radix sorted for integral and floating point keys, which beats comparison sorts on the large loads build_end() sees
+	// - sorts the elements from index first to the end
+	constexpr void SortStorage(SizeT first = 0) noexcept
+	{
+		SortElements(container_obj.begin() + static_cast<PtrDiff>(first), container_obj.end());
+	}
+
+	static constexpr void SortElements(iterator it_first, iterator it_last) noexcept
+	{
+		std::less<> compare;
+		if constexpr (Internal::RadixKey<key_type> && std::is_default_constructible_v<value_type>)
+		{
+			Internal::SortAdaptive(it_first, it_last, compare, [](iterator it_block_first, iterator it_block_last)
+			{
+				AoL::RadixSortByKey(it_block_first, it_block_last);
+			});
+		}
+		else
+		{
+			AoL::SortAdaptive(it_first, it_last, compare);
+		}
+	}
+
+	constexpr const_iterator MakeConstIterator(const value_type* p_item) const noexcept
+	{
+		const value_type* p_begin = container_obj.data();
+		return const_iterator(p_item, p_begin, p_begin + container_obj.size(), tombstone_count != 0 ? tombstones_obj.data() : nullptr);
+	}
+
+	constexpr bool IsErased(const value_type* p_item) const noexcept
+	{
+		if (tombstone_count == 0)
+		{
+			return false;
+		}
+		const SizeT index = static_cast<SizeT>(p_item - container_obj.data());
+		return (tombstones_obj[index / 64] >> (index % 64)) & 1;
+	}
+
+	// Reuses the slot of an erased element with the same key, returns false when there is none
+	template<typename InKey, typename InValue>
+	constexpr bool ReviveErased(const InKey& key, InValue&& value) noexcept
+	{
+		if (tombstone_count == 0)
+		{
+			return false;
+		}
+		value_type* p_begin = container_obj.data();
+		value_type* p_ret = AoL::FindLowerBound(p_begin, p_begin + container_obj.size(), key, less_than_comp);
+		if (p_ret == p_begin + container_obj.size() || p_ret->first != key || !this->IsErased(p_ret))
+		{
+			return false;
+		}
+		const SizeT index = static_cast<SizeT>(p_ret - p_begin);
+		tombstones_obj[index / 64] &= ~(U64{ 1 } << (index % 64));
+		--tombstone_count;
+		p_ret->second = std::forward<InValue>(value);
+		return true;
+	}
+
+	// Drops the marked elements and the ones pred returns true for, keeping the order, then clears the marks
+	template<typename Pred>
+	constexpr void RemoveStorage(Pred& pred) noexcept
+	{
+		const SizeT count = container_obj.size();
+		value_type* p_begin = container_obj.data();
+		SizeT write = 0;
+		for (SizeT read = 0; read < count; ++read)
+		{
+			if (this->IsErased(p_begin + read) || pred(std::as_const(p_begin[read])))
+			{
+				continue;
+			}
+			if (write != read)
+			{
+				p_begin[write] = std::move(p_begin[read]);
+			}
+			++write;
+		}
+		container_obj.erase(container_obj.begin() + static_cast<PtrDiff>(write), container_obj.end());
+		tombstones_obj.clear();
+		tombstone_count = 0;
+	}
+
+	template<typename InKey>
+	constexpr const value_type* LowerBoundPtr(const InKey& key) const noexcept
+	{
+		const value_type* p_begin = container_obj.data();
+		return AoL::FindLowerBound(p_begin, p_begin + container_obj.size(), key, less_than_comp);
+	}
+
+	// Keys are unique, so the upper bound is the lower bound, or the one after it on a match
+	template<typename InKey>
+	constexpr const value_type* UpperBoundPtr(const InKey& key, const value_type* p_lower) const noexcept
+	{
+		const value_type* p_end = container_obj.data() + container_obj.size();
+		return p_lower + static_cast<PtrDiff>(p_lower != p_end && p_lower->first == key);
 	}
 };
 
@@ -11,6 +11,7 @@
 #include "aol/types.h"
 
 #include <iterator>
+#include <type_traits>
 
 
 namespace AoL::Internal
@@ -58,6 +59,24 @@ struct SubrangeEx : SubrangeExBase<It>
 	using SubrangeExBase<It>::SubrangeExBase;
 };
 
+// Iterators that know their distance without random access (i.e. FlatKeyOrderMap's const_iterator)
+template<typename It> requires std::sized_sentinel_for<It, It>
+struct SubrangeEx<It> : SubrangeExBase<It>
+{
+	using SubrangeExBase<It>::SubrangeExBase;
+	using size_type = SizeT;
+
+	AOL_ATTRIB_NO_DISCARD size_type constexpr size() const noexcept
+	{
+		return static_cast<size_type>(this->finish - this->start);
+	}
+
+	AOL_ATTRIB_NO_DISCARD auto constexpr empty() const noexcept
+	{
+		return this->start == this->finish;
+	}
+};
+
 template<std::random_access_iterator It>
 struct SubrangeEx<It> : SubrangeExBase<It>
 {
@@ -65,6 +84,10 @@ struct SubrangeEx<It> : SubrangeExBase<It>
 	using value_type = typename SubrangeExBase<It>::value_type;
 	using size_type = SizeT;
 
+	// Proxy iterators (i.e. FlatKeyOrderMapSoA's) return their element by value
+	using reference = std::iter_reference_t<It>;
+	using const_reference = std::conditional_t<std::is_reference_v<reference>, const value_type&, reference>;
+
 	AOL_ATTRIB_NO_DISCARD size_type constexpr size() const noexcept
 	{
 		return static_cast<size_type>(this->finish - this->start);
@@ -75,13 +98,13 @@ struct SubrangeEx<It> : SubrangeExBase<It>
 		return this->start == this->finish;
 	}
 
-	AOL_ATTRIB_NO_DISCARD constexpr value_type& operator [] (size_type idx) noexcept
+	AOL_ATTRIB_NO_DISCARD constexpr reference operator [] (size_type idx) noexcept
 	{
 		assert(idx < this->size() && "Invalid index!");
 		return *(this->start + idx);
 	}
 
-	AOL_ATTRIB_NO_DISCARD constexpr const value_type& operator [] (size_type idx) const noexcept
+	AOL_ATTRIB_NO_DISCARD constexpr const_reference operator [] (size_type idx) const noexcept
 	{
 		assert(idx < this->size() && "Invalid index!");
 		return *(this->start + idx);
@@ -15,5 +15,11 @@
 #define AOL_ATTRIB_BRANCH_LIKELY [[likely]]
 #define AOL_ATTRIB_NO_UNQ_ADDRESS [[no_unique_address]]
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#define AOL_ATTRIB_FORCE_INLINE __forceinline
+#else
+#define AOL_ATTRIB_FORCE_INLINE [[gnu::always_inline]] inline
+#endif
+
 
 #endif // AOL_HEADER_INTERNAL_MACROS_ATTRIBUTES_H
\ No newline at end of file
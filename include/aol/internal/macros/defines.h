@@ -40,6 +40,55 @@
 #endif
 
 
+/**
+* SIMD instruction sets available at compile time
+* - GCC/Clang define __SSE2__/__SSE4_2__/__AVX2__ from -m flags or -march
+* - MSVC only defines __AVX2__ with /arch:AVX2, SSE2 is always available on x64
+* - Strictly for use in this library only
+*/
+#if defined(__AVX2__)
+#define AOL_SIMD_AVX2 1
+#else
+#define AOL_SIMD_AVX2 0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AOL_SIMD_SSE2 1
+#else
+#define AOL_SIMD_SSE2 0
+#endif
+
+// MSVC has no SSE4 switch, /arch:AVX and above imply it
+#if defined(__SSE4_2__) || defined(__AVX__)
+#define AOL_SIMD_SSE42 1
+#else
+#define AOL_SIMD_SSE42 0
+#endif
+
+
+/**
+* SIMD instruction sets picked at runtime
+* - AOL_SIMD_X86 is 1 on x86/x64, where AVX2 and AVX-512 code can be compiled regardless of the build flags
+* - GCC/Clang only compile wider intrinsics in functions marked with AOL_TARGET_AVX2/AOL_TARGET_AVX512,
+*   MSVC compiles them anywhere so the macros are empty
+* - Such functions must only run after Simd::RuntimeIsa() reported the instruction set
+* - Strictly for use in this library only
+*/
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define AOL_SIMD_X86 1
+#else
+#define AOL_SIMD_X86 0
+#endif
+
+#if AOL_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define AOL_TARGET_AVX2 __attribute__((target("avx2")))
+#define AOL_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define AOL_TARGET_AVX2
+#define AOL_TARGET_AVX512
+#endif
+
+
 /**
 * Debug macro for better readability in the codebase
 * Strictly for use in this library only
@@ -15,7 +15,7 @@
 * Cannot proceed with no prefetch function
 */
 #if defined(__GNUC__) || defined(__clang__)
-#define BS_PREFETCH(addr) __builtin_prefetch(addr)
+#define AOL_MACRO_FUNC_PREFETCH(addr) __builtin_prefetch(addr)
 #elif defined(_MSC_VER)
 #include <xmmintrin.h>
 #define AOL_MACRO_FUNC_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
@@ -55,11 +55,10 @@ AOL_SERIALIZATION_HELPER_NAMED_ARRAY(4)
 #endif // AOL_HEADER_ARRAY_H
 
 
-#if defined(AOL_HEADER_KEY_ORDERED_MAP_H)
-#include "cereal/types/vector.hpp"
+#if defined(AOL_HEADER_KEY_ORDERED_MAP_H) || defined(AOL_HEADER_UNORDERED_MAP_H)
 
 /****************************************
-* KeyValuePairEx
+* KeyValuePairEx, shared by KeyOrderMapEx and FrozenHashMapEx
 ****************************************/
 
 template<
@@ -87,6 +86,11 @@ void load(Archive& archive, AoL::Internal::KeyValuePairEx<K, V>& kvp)
 		kvp.second
 	);
 }
+#endif // AOL_HEADER_KEY_ORDERED_MAP_H || AOL_HEADER_UNORDERED_MAP_H
+
+
+#if defined(AOL_HEADER_KEY_ORDERED_MAP_H)
+#include "cereal/types/vector.hpp"
 
 /****************************************
 * KeyOrderMapEx
@@ -102,7 +106,23 @@ template<
 >
 void save(Archive& archive, const AoL::Internal::KeyOrderMapEx<K, V, P, C, A>& c)
 {
-	archive(c.container_obj);
+	if (c.tombstone_count == 0)
+	{
+		archive(c.container_obj);
+		return;
+	}
+
+	// Elements marked by erase() are skipped, the saved map is compacted
+	typename AoL::Internal::KeyOrderMapEx<K, V, P, C, A>::container_type live(c.container_obj.get_allocator());
+	live.reserve(c.size());
+	for (AoL::SizeT i = 0; i < c.container_obj.size(); ++i)
+	{
+		if (((c.tombstones_obj[i / 64] >> (i % 64)) & 1) == 0)
+		{
+			live.push_back(c.container_obj[i]);
+		}
+	}
+	archive(live);
 }
 
 template<
@@ -116,6 +136,8 @@ template<
 void load(Archive& archive, AoL::Internal::KeyOrderMapEx<K, V, P, C, A>& c)
 {
 	archive(c.container_obj);
+	c.tombstones_obj.clear();
+	c.tombstone_count = 0;
 }
 #endif // AOL_HEADER_KEY_ORDERED_MAP_H
 
@@ -135,9 +157,58 @@ void load(Archive& archive, AoL::Internal::KeyOrderMapEx<K, V, P, C, A>& c)
 #endif // AOL_HEADER_INSERT_ORDERED_SET_H
 
 
-#if defined(AOL_HEADER_HASH_MAP_H)
+#if defined(AOL_HEADER_UNORDERED_MAP_H)
 #include "cereal/types/unordered_map.hpp"
-#endif // AOL_HEADER_HASH_MAP_H
+#include "cereal/types/vector.hpp"
+
+/****************************************
+* FrozenHashMapEx
+****************************************/
+
+template<
+	typename Archive,
+	typename K,
+	typename V,
+	typename P,
+	typename H,
+	typename A
+>
+void save(Archive& archive, const AoL::Internal::FrozenHashMapEx<K, V, P, H, A>& c)
+{
+	archive(
+		c.slots_obj,
+		c.pilots_obj,
+		c.seed
+	);
+}
+
+template<
+	typename Archive,
+	typename K,
+	typename V,
+	typename P,
+	typename H,
+	typename A
+>
+void load(Archive& archive, AoL::Internal::FrozenHashMapEx<K, V, P, H, A>& c)
+{
+	archive(
+		c.slots_obj,
+		c.pilots_obj,
+		c.seed
+	);
+
+	// find() indexes pilots_obj by a bucket of the slot count without checks, a mismatched archive is rejected
+	const AoL::SizeT bucket_count = (c.slots_obj.size() + AoL::Internal::frozen_hash_map_bucket_keys - 1) / AoL::Internal::frozen_hash_map_bucket_keys;
+	if (c.pilots_obj.size() != bucket_count)
+	{
+		c.slots_obj.clear();
+		c.pilots_obj.clear();
+		c.seed = 0;
+		throw Exception("Invalid FrozenHashMap archive! Pilot count does not match the slot count!");
+	}
+}
+#endif // AOL_HEADER_UNORDERED_MAP_H
 
 
 #if defined(AOL_HEADER_HASH_SET_H)
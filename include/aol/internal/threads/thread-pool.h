@@ -0,0 +1,340 @@
+/***************************************************************************************
+* AoLibrary Thread Pool implementations
+***************************************************************************************/
+#ifndef AOL_HEADER_INTERNAL_THREADS_THREAD_POOL_H
+#define AOL_HEADER_INTERNAL_THREADS_THREAD_POOL_H
+
+
+#include "aol/configs.h"
+#include "aol/macros.h"
+#include "aol/traits.h"
+#include "aol/types.h"
+#include "aol/vector.h"
+
+#include <atomic>				// std::atomic
+#include <condition_variable>	// std::condition_variable
+#include <deque>				// std::deque
+#include <functional>			// std::function
+#include <memory>				// std::unique_ptr
+#include <mutex>				// std::mutex, std::lock_guard, std::unique_lock
+#include <optional>				// std::optional
+#include <thread>				// std::thread, std::this_thread::yield
+#include <utility>				// std::forward, std::move
+
+
+namespace AoL
+{
+
+/**
+* @details Work stealing thread pool for fork-join parallelism (i.e. parallel sorts)
+*
+* - Every worker owns a task deque: it pushes and pops its own tasks at the back (LIFO, cache warm),
+*   idle workers steal from the front of the others (FIFO, the largest pending tasks)
+*
+* - Tasks pushed from outside the pool go to one more deque, owned by whoever waits on them
+*
+* - Threads waiting on a TaskGroup run pending tasks instead of blocking, so tasks can fork and wait
+*   on their own groups, and the waiting thread counts as a worker: concurrency() is worker_count() + 1
+*
+* - Idle workers sleep on a condition variable, so an unused pool costs nothing
+*
+* - Tasks must not throw
+*/
+class ThreadPool
+{
+public:
+	using size_type = SizeT;
+	using task_type = std::function<void()>;
+
+private:
+	struct alignas(64) TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<task_type> tasks;
+	};
+
+	// Worker index of the current thread in the pool it belongs to, the external deque for other threads
+	inline static thread_local const ThreadPool* current_pool = nullptr;
+	inline static thread_local size_type current_index = 0;
+
+	AoL::Vector<std::unique_ptr<TaskQueue>> queues;	// one per worker, the last one for external threads
+	AoL::Vector<std::thread> workers;
+	std::atomic<size_type> queued_count;
+	std::atomic<size_type> sleeping_count;
+	std::mutex sleep_mutex;
+	std::condition_variable sleep_condition;
+	bool stopping;
+
+public:
+	/**
+	* @details Starts the workers
+	*
+	* @param worker_count number of worker threads, 0 runs every task on the waiting threads
+	*/
+	explicit ThreadPool(size_type worker_count = DefaultWorkerCount()) :
+		queues{ },
+		workers{ },
+		queued_count{ 0 },
+		sleeping_count{ 0 },
+		sleep_mutex{ },
+		sleep_condition{ },
+		stopping{ false }
+	{
+		queues.reserve(worker_count + 1);
+		for (size_type i = 0; i <= worker_count; ++i)
+		{
+			queues.push_back(std::make_unique<TaskQueue>());
+		}
+
+		workers.reserve(worker_count);
+		for (size_type i = 0; i < worker_count; ++i)
+		{
+			workers.emplace_back([this, i]() { this->WorkerLoop(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator = (const ThreadPool&) = delete;
+
+	// Runs the remaining tasks, then joins the workers
+	~ThreadPool()
+	{
+		{
+			std::lock_guard lock(sleep_mutex);
+			stopping = true;
+		}
+		sleep_condition.notify_all();
+
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	// One worker per hardware thread, minus the thread that waits on the tasks
+	AOL_ATTRIB_NO_DISCARD static size_type DefaultWorkerCount() noexcept
+	{
+		const size_type hardware_count = std::thread::hardware_concurrency();
+		return hardware_count > 1 ? hardware_count - 1 : 0;
+	}
+
+	AOL_ATTRIB_NO_DISCARD size_type worker_count() const noexcept
+	{
+		return workers.size();
+	}
+
+	// Threads running tasks while one waits on them
+	AOL_ATTRIB_NO_DISCARD size_type concurrency() const noexcept
+	{
+		return workers.size() + 1;
+	}
+
+	/**
+	* @details Queues a task, on the current worker's deque if called from one of the pool's tasks
+	*
+	* - Prefer TaskGroup::run, which tracks completion
+	*
+	* @param task task to be run
+	*/
+	void submit(task_type task)
+	{
+		TaskQueue& queue = *queues[this->CurrentIndex()];
+		{
+			std::lock_guard lock(queue.mutex);
+			queue.tasks.push_back(std::move(task));
+		}
+		queued_count.fetch_add(1);
+
+		if (sleeping_count.load() != 0)
+		{
+			// Taking the lock orders the wake up after the sleeper's check of queued_count
+			{
+				std::lock_guard lock(sleep_mutex);
+			}
+			sleep_condition.notify_one();
+		}
+	}
+
+	/**
+	* @details Runs one pending task on the calling thread, its own deque first, then stolen ones
+	*
+	* @return false if there was no task to run
+	*/
+	bool try_run_one()
+	{
+		std::optional<task_type> task = this->TakeTask(this->CurrentIndex());
+		if (!task)
+		{
+			return false;
+		}
+
+		const ThreadPool* previous_pool = current_pool;
+		const size_type previous_index = current_index;
+		if (previous_pool != this)
+		{
+			// Tasks forked from here go to the external deque, the one this thread drains while waiting
+			current_pool = this;
+			current_index = workers.size();
+		}
+
+		(*task)();
+
+		current_pool = previous_pool;
+		current_index = previous_index;
+		return true;
+	}
+
+private:
+	size_type CurrentIndex() const noexcept
+	{
+		return current_pool == this ? current_index : workers.size();
+	}
+
+	std::optional<task_type> TakeTask(size_type index)
+	{
+		// Own tasks from the back
+		{
+			TaskQueue& queue = *queues[index];
+			std::lock_guard lock(queue.mutex);
+			if (!queue.tasks.empty())
+			{
+				task_type task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				queued_count.fetch_sub(1);
+				return task;
+			}
+		}
+
+		// Steal from the front of the others, starting with the next one so thieves spread out
+		const size_type queue_count = queues.size();
+		for (size_type offset = 1; offset < queue_count; ++offset)
+		{
+			TaskQueue& queue = *queues[(index + offset) % queue_count];
+			std::lock_guard lock(queue.mutex);
+			if (!queue.tasks.empty())
+			{
+				task_type task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				queued_count.fetch_sub(1);
+				return task;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	void WorkerLoop(size_type index)
+	{
+		current_pool = this;
+		current_index = index;
+
+		constexpr size_type spin_count = 64;
+		while (true)
+		{
+			bool has_run = false;
+			for (size_type spin = 0; spin < spin_count && !has_run; ++spin)
+			{
+				has_run = this->try_run_one();
+				if (!has_run)
+				{
+					std::this_thread::yield();
+				}
+			}
+			if (has_run)
+			{
+				continue;
+			}
+
+			std::unique_lock lock(sleep_mutex);
+			sleeping_count.fetch_add(1);
+			sleep_condition.wait(lock, [this]() { return stopping || queued_count.load() != 0; });
+			sleeping_count.fetch_sub(1);
+			if (stopping && queued_count.load() == 0)
+			{
+				return;
+			}
+		}
+	}
+};
+
+/**
+* @details Group of tasks forked on a ThreadPool and joined with wait()
+*
+* - wait() runs pending tasks of the pool until every task of the group is done, so it can be called
+*   from inside another task
+*
+* - The destructor waits, a group never outlives its tasks
+*/
+class TaskGroup
+{
+public:
+	explicit TaskGroup(ThreadPool& thread_pool) noexcept :
+		pool{ thread_pool },
+		pending_count{ 0 }
+	{
+	}
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator = (const TaskGroup&) = delete;
+
+	~TaskGroup()
+	{
+		this->wait();
+	}
+
+	/**
+	* @details Forks a task
+	*
+	* @tparam F callable type, invoked with no argument
+	* @param f task to be run, must not throw
+	*/
+	template<typename F>
+	void run(F&& f)
+	{
+		pending_count.fetch_add(1, std::memory_order_relaxed);
+		pool.submit([this, task = std::forward<F>(f)]() mutable
+		{
+			task();
+			pending_count.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	// Runs pending tasks until every task of the group is done
+	void wait()
+	{
+		while (pending_count.load(std::memory_order_acquire) != 0)
+		{
+			if (!pool.try_run_one())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	AOL_ATTRIB_NO_DISCARD ThreadPool& thread_pool() const noexcept
+	{
+		return pool;
+	}
+
+private:
+	ThreadPool& pool;
+	std::atomic<SizeT> pending_count;
+};
+
+/**
+* @details Pool shared by the library's parallel algorithms
+*
+* - Started on first use with ThreadPool::DefaultWorkerCount() workers
+*
+* @return the default thread pool
+*/
+inline ThreadPool& DefaultThreadPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+} // AoL namespace
+
+
+#endif // AOL_HEADER_INTERNAL_THREADS_THREAD_POOL_H
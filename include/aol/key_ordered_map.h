@@ -21,6 +21,9 @@
 #include "absl/container/btree_map.h"
 #endif
 #include "internal/containers/key-ordered-map.h"
+#include "internal/containers/key-ordered-map-soa.h"
+#include "internal/containers/key-ordered-map-log.h"
+#include "internal/containers/key-ordered-map-constexpr.h"
 
 #include <utility>
 
@@ -172,6 +175,133 @@ template<
 >
 using FlatKeyOrderMapPool = Internal::KeyOrderMapEx<K, V, P, Internal::PairLessComparator<P>, A>;
 
+/**
+* @details FlatKeyOrderMap with keys and values in separate vectors (structure of arrays)
+*
+* - Same interface, searches only read the key array, so large values do not dilute the cache lines a search touches
+*
+* - Elements are KeyValueRefEx proxies (first, second), find() returns an iterator that is nullptr when the key is missing
+*
+* - Prefer it over FlatKeyOrderMap when values are much larger than keys and lookups dominate
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam AK Key allocator type (default: Internal::DefaultAllocator<K>)
+* @tparam AV Value allocator type (default: Internal::DefaultAllocator<V>)
+*/
+template<
+	typename K,
+	typename V,
+	typename AK = DefaultAllocator<K>,
+	typename AV = DefaultAllocator<V>
+>
+using FlatKeyOrderMapSoA = Internal::KeyOrderMapSoAEx<K, V, AK, AV>;
+
+/**
+* @details FlatKeyOrderMapSoA but specialized for pool allocators
+*
+* - Default pool allocator is backed by mimalloc
+*
+* - Internally operates on `mi_heap_t`
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam AK Key allocator type (default: Internal::DefaultPoolAllocator<K>)
+* @tparam AV Value allocator type (default: Internal::DefaultPoolAllocator<V>)
+*/
+template<
+	typename K,
+	typename V,
+	typename AK = DefaultPoolAllocator<K>,
+	typename AV = DefaultPoolAllocator<V>
+>
+using FlatKeyOrderMapSoAPool = Internal::KeyOrderMapSoAEx<K, V, AK, AV>;
+
+/**
+* @details Write optimized FlatKeyOrderMap: inserts go into a small sorted tail merged into the main array later
+*
+* - An insert moves O(sqrt(size)) elements amortized instead of O(size), find() checks the main array then the tail
+*
+* - The tail is merged when it passes its limit (about sqrt(size), or the one given to the constructor) or on compact()
+*
+* - Iterate, or use bounds and ranges, through sorted() or the non const begin() / end(), which compact first
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam P Key-value pair type (default: FlatKeyOrderMapPair<K,V>)
+* @tparam A Allocator type (default: Internal::DefaultAllocator<P>)
+*/
+template<
+	typename K,
+	typename V,
+	typename P = FlatKeyOrderMapPair<K, V>,
+	typename A = DefaultAllocator<P>
+>
+using FlatKeyOrderMapLog = Internal::KeyOrderMapLogEx<K, V, P, Internal::PairLessComparator<P>, A>;
+
+/**
+* @details FlatKeyOrderMapLog but specialized for pool allocators
+*
+* - Default pool allocator is backed by mimalloc
+*
+* - Internally operates on `mi_heap_t`
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam P Key-value pair type (default: FlatKeyOrderMapPair<K,V>)
+* @tparam A Allocator type (default: Internal::DefaultPoolAllocator<P>)
+*/
+template<
+	typename K,
+	typename V,
+	typename P = FlatKeyOrderMapPair<K, V>,
+	typename A = DefaultPoolAllocator<P>
+>
+using FlatKeyOrderMapLogPool = Internal::KeyOrderMapLogEx<K, V, P, Internal::PairLessComparator<P>, A>;
+
+/**
+* @details FlatKeyOrderMap with N pairs, sorted at compile time into an AoL::Array
+*
+* - Declared constexpr (i.e. static constexpr tables), the sorted table is in read only memory and nothing runs at startup
+*
+* - Lookups with constant keys are resolved at compile time, others are a binary search over the table
+*
+* - Read only, a duplicate key fails to compile, build one with MakeConstexprKeyOrderMap
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam N Number of pairs
+* @tparam P Key-value pair type (default: FlatKeyOrderMapPair<K,V>)
+*/
+template<
+	typename K,
+	typename V,
+	SizeT N,
+	typename P = FlatKeyOrderMapPair<K, V>
+>
+using ConstexprKeyOrderMap = Internal::ConstexprKeyOrderMapEx<K, V, N, P, Internal::PairLessComparator<P>>;
+
+/**
+* @details Builds a ConstexprKeyOrderMap from a list of pairs in any order, the size is deduced
+*
+* - constexpr auto map = AoL::MakeConstexprKeyOrderMap<Key, Value>({ { key, value }, ... });
+*
+* @tparam K Key type
+* @tparam V Mapped value type
+* @tparam N Number of pairs (deduced)
+* @param items pairs of the map
+* @return the sorted map
+*/
+template<
+	typename K,
+	typename V,
+	SizeT N
+>
+consteval ConstexprKeyOrderMap<K, V, N> MakeConstexprKeyOrderMap(const FlatKeyOrderMapPair<K, V> (&items)[N]) noexcept
+{
+	return ConstexprKeyOrderMap<K, V, N>{ items };
+}
+
 } // AoL namespace
 
 
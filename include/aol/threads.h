@@ -0,0 +1,19 @@
+/***************************************************************************************
+* AoLibrary threads
+****************************************************************************************
+* - Thread pool and task groups used by the library's parallel algorithms
+* - No dependency on a std parallel backend (i.e. TBB)
+***************************************************************************************/
+#ifndef AOL_HEADER_THREADS_H
+#define AOL_HEADER_THREADS_H
+
+
+#include "configs.h"
+#include "macros.h"
+#include "traits.h"
+#include "types.h"
+
+#include "internal/threads/thread-pool.h"
+
+
+#endif // AOL_HEADER_THREADS_H